@@ -0,0 +1,333 @@
+#include "myqueue.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+// Baseline: the "obvious" thread-safe queue, a std::deque guarded by a std::mutex
+template <typename T>
+class locked_queue
+{
+public:
+	bool try_push(T const & val)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_queue.push_back(val);
+		return true;
+	}
+
+	bool try_pop(T & val)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_queue.empty())
+			return false;
+
+		val = _queue.front();
+		_queue.pop_front();
+		return true;
+	}
+
+private:
+	std::mutex _mutex;
+	std::deque<T> _queue;
+};
+
+// Pushes/pops 'val', yields the CPU while the queue is full/empty
+template <typename Queue>
+void push(Queue & q, int val)
+{
+	while (!q.try_push(val))
+		std::this_thread::yield();
+}
+
+template <typename Queue>
+int pop(Queue & q)
+{
+	int val;
+	while (!q.try_pop(val))
+		std::this_thread::yield();
+	return val;
+}
+
+// Hands 'iter' ints from 'producers' threads to 'consumers' threads
+// @return duration in ms
+template <typename Queue>
+long long throughput(Queue & q, int producers, int consumers, int iter)
+{
+	std::atomic<int> consumed(0);
+	std::vector<std::thread> threads;
+	std::chrono::high_resolution_clock c;
+
+	auto t1 = c.now();
+	for (int p = 0; p < producers; p++)
+		threads.emplace_back([&, p]() {
+			for (int i = p; i < iter; i += producers)
+				push(q, i);
+		});
+	for (int i = 0; i < consumers; i++)
+		threads.emplace_back([&]() {
+			int val;
+			while (consumed.load(std::memory_order_relaxed) < iter)
+				if (q.try_pop(val))
+					consumed++;
+				else
+					std::this_thread::yield();
+		});
+	for (auto & t : threads)
+		t.join();
+	auto t2 = c.now();
+
+	return std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+}
+
+// Same as above, but moves BATCH elements per queue operation (spsc/mpmc only)
+template <typename Queue>
+long long throughput_batched(Queue & q, int iter)
+{
+	int const BATCH = 64;
+	std::chrono::high_resolution_clock c;
+
+	auto t1 = c.now();
+	std::thread producer([&]() {
+		int buf[BATCH];
+		for (int i = 0; i < iter; i += BATCH)
+		{
+			int const n = std::min(BATCH, iter - i);
+			for (int j = 0; j < n; j++)
+				buf[j] = i + j;
+
+			for (int sent = 0; sent < n; )
+			{
+				std::size_t const k = q.try_push(buf + sent, n - sent);
+				if (k == 0)
+					std::this_thread::yield();
+				sent += static_cast<int>(k);
+			}
+		}
+	});
+	std::thread consumer([&]() {
+		int buf[BATCH];
+		for (int received = 0; received < iter; )
+		{
+			std::size_t const k = q.try_pop(buf, BATCH);
+			if (k == 0)
+				std::this_thread::yield();
+			received += static_cast<int>(k);
+		}
+	});
+	producer.join();
+	consumer.join();
+	auto t2 = c.now();
+
+	return std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+}
+
+// Ping-pongs a single int 'iter' times between two threads
+// @return average round trip latency in ns
+template <typename Queue>
+long long latency(Queue & ping, Queue & pong, int iter)
+{
+	std::chrono::high_resolution_clock c;
+
+	auto t1 = c.now();
+	std::thread echo([&]() {
+		for (int i = 0; i < iter; i++)
+			push(pong, pop(ping));
+	});
+	for (int i = 0; i < iter; i++)
+	{
+		push(ping, i);
+		pop(pong);
+	}
+	echo.join();
+	auto t2 = c.now();
+
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / iter;
+}
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test spsc_queue(capacity)
+		spsc_queue<int> q(5);
+
+		assert(q.capacity() == 8);
+		assert(q.size() == 0);
+	}
+
+	{// Test spsc try_push()/try_pop()
+		spsc_queue<int> q(4);
+		int val;
+
+		assert(!q.try_pop(val));
+
+		for (int i = 0; i < 4; i++)
+			assert(q.try_push(i));
+		assert(!q.try_push(4)); // full
+		assert(q.size() == 4);
+
+		for (int i = 0; i < 4; i++)
+		{
+			assert(q.try_pop(val));
+			assert(val == i);
+		}
+		assert(!q.try_pop(val)); // empty
+	}
+
+	{// Test spsc wrap-around
+		spsc_queue<int> q(4);
+		int val;
+
+		for (int i = 0; i < 100; i++)
+		{
+			assert(q.try_push(i));
+			assert(q.try_push(-i));
+			assert(q.try_pop(val) && val == i);
+			assert(q.try_pop(val) && val == -i);
+		}
+	}
+
+	{// Test spsc batch push/pop
+		spsc_queue<int> q(8);
+		int in[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		int out[10];
+
+		assert(q.try_push(in, 3) == 3);
+		assert(q.try_pop(out, 2) == 2);
+		assert(out[0] == 0 && out[1] == 1);
+
+		// batch crossing the end of the ring, truncated to the free space
+		assert(q.try_push(in + 3, 10 - 3) == 7);
+		assert(q.size() == 8);
+		assert(q.try_push(in, 1) == 0);
+
+		assert(q.try_pop(out, 10) == 8);
+		for (int i = 0; i < 8; i++)
+			assert(out[i] == i + 2);
+	}
+
+	{// Test mpmc try_push()/try_pop()
+		mpmc_queue<int> q(4);
+		int val;
+
+		assert(q.capacity() == 4);
+		assert(!q.try_pop(val));
+
+		for (int lap = 0; lap < 3; lap++)
+		{
+			for (int i = 0; i < 4; i++)
+				assert(q.try_push(i));
+			assert(!q.try_push(4));
+
+			for (int i = 0; i < 4; i++)
+				assert(q.try_pop(val) && val == i);
+			assert(!q.try_pop(val));
+		}
+	}
+
+	{// Test mpmc batch push/pop
+		mpmc_queue<int> q(8);
+		int in[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		int out[10];
+
+		assert(q.try_push(in, 5) == 5);
+		assert(q.try_pop(out, 3) == 3);
+		assert(out[2] == 2);
+		assert(q.try_push(in + 5, 5) == 5);
+		assert(q.try_push(in, 10) == 1); // only one free slot left
+		assert(q.size() == 8);
+
+		assert(q.try_pop(out, 10) == 8);
+		for (int i = 0; i < 7; i++)
+			assert(out[i] == i + 3);
+		assert(out[7] == 0);
+	}
+
+	{// Test concurrent use: every element arrives exactly once
+		int const N = 100'000;
+		mpmc_queue<int> q(64);
+		std::atomic<long long> sum(0);
+		std::atomic<int> consumed(0);
+		std::vector<std::thread> threads;
+
+		for (int p = 0; p < 3; p++)
+			threads.emplace_back([&, p]() {
+				for (int i = p; i < N; i += 3)
+					push(q, i);
+			});
+		for (int i = 0; i < 3; i++)
+			threads.emplace_back([&]() {
+				int val;
+				while (consumed.load() < N)
+					if (q.try_pop(val))
+					{
+						sum += val;
+						consumed++;
+					}
+					else
+						std::this_thread::yield();
+			});
+		for (auto & t : threads)
+			t.join();
+
+		assert(sum == (long long)N * (N - 1) / 2);
+
+		spsc_queue<int> s(64);
+		std::thread producer([&]() {
+			for (int i = 0; i < N; i++)
+				push(s, i);
+		});
+		for (int i = 0; i < N; i++)
+			assert(pop(s) == i); // FIFO order
+		producer.join();
+	}
+
+	// Benchmark (run in RELEASE mode!!!, compile with -pthread)
+	int const ITER = 10'000'000; // might need to adjust slightly for your machine
+	int const CAPACITY = 1024;
+
+	{// Throughput, 1 producer -> 1 consumer
+		locked_queue<int> l;
+		spsc_queue<int> s(CAPACITY);
+		mpmc_queue<int> m(CAPACITY);
+		spsc_queue<int> sb(CAPACITY);
+		mpmc_queue<int> mb(CAPACITY);
+
+		std::cout << "t1:1 (mutex + std::deque): " << throughput(l, 1, 1, ITER) << "ms" << std::endl;
+		std::cout << "t1:1 (spsc_queue): " << throughput(s, 1, 1, ITER) << "ms" << std::endl;
+		std::cout << "t1:1 (mpmc_queue): " << throughput(m, 1, 1, ITER) << "ms" << std::endl;
+		std::cout << "t1:1 (spsc_queue, batched): " << throughput_batched(sb, ITER) << "ms" << std::endl;
+		std::cout << "t1:1 (mpmc_queue, batched): " << throughput_batched(mb, ITER) << "ms" << std::endl;
+	}
+	std::cout << std::endl;
+	{// Throughput, 4 producers -> 4 consumers
+		locked_queue<int> l;
+		mpmc_queue<int> m(CAPACITY);
+
+		std::cout << "t4:4 (mutex + std::deque): " << throughput(l, 4, 4, ITER) << "ms" << std::endl;
+		std::cout << "t4:4 (mpmc_queue): " << throughput(m, 4, 4, ITER) << "ms" << std::endl;
+	}
+	std::cout << std::endl;
+	{// Round trip latency
+		int const ROUNDS = ITER / 100;
+		locked_queue<int> l1, l2;
+		spsc_queue<int> s1(CAPACITY), s2(CAPACITY);
+		mpmc_queue<int> m1(CAPACITY), m2(CAPACITY);
+
+		std::cout << "tRoundTrip (mutex + std::deque): " << latency(l1, l2, ROUNDS) << "ns" << std::endl;
+		std::cout << "tRoundTrip (spsc_queue): " << latency(s1, s2, ROUNDS) << "ns" << std::endl;
+		std::cout << "tRoundTrip (mpmc_queue): " << latency(m1, m2, ROUNDS) << "ns" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,364 @@
+#pragma once
+
+#include "myarray.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace my {
+/**
+ * Size of a cache line in bytes. Indices written by different threads are
+ * aligned to this boundary so they never share a cache line (false sharing).
+ */
+constexpr std::size_t cache_line_size = 64;
+
+namespace detail {
+/**
+ * @return The smallest power of two >= n (at least 1)
+ * @exception no-throw
+ */
+inline std::size_t next_pow2(std::size_t n)
+{
+	std::size_t result = 1;
+	while (result < n)
+		result *= 2;
+
+	return result;
+}
+} // namespace detail
+
+
+
+/**
+ * Bounded, lock-free single-producer/single-consumer FIFO queue.
+ *
+ * The elements live in a ring buffer (my::array) whose size is a power of two so
+ * we can wrap indices with a mask instead of a division. _head and _tail are
+ * ever-increasing counters (they never wrap in practice since std::size_t is 64bit),
+ * which lets us tell 'full' (tail - head == capacity) from 'empty' (tail == head)
+ * without wasting a slot.
+ *
+ * Exactly one thread may push and exactly one (other) thread may pop at a time.
+ * @invariant 0 <= size() <= capacity()
+ */
+template <typename T>
+class spsc_queue
+{
+public:
+	/**
+	 * Constructor, creates an empty queue.
+	 * @param capacity Minimum number of elements the queue can hold,
+	 * rounded up to the next power of two.
+	 * @exception might throw if not enough memory is available or if
+	 * T's constructor throws. Provides strong exception safety.
+	 * @post capacity() >= capacity
+	 */
+	explicit spsc_queue(std::size_t capacity) :
+		_buffer(detail::next_pow2(capacity)),
+		_mask(_buffer.size() - 1)
+	{}
+
+	// A queue is a communication channel between threads, copying it makes no sense.
+	spsc_queue(spsc_queue const &) = delete;
+	spsc_queue & operator=(spsc_queue const &) = delete;
+
+	/**
+	 * @return Maximum number of elements the queue can hold
+	 * @exception no-throw
+	 */
+	std::size_t capacity() const { return _buffer.size(); }
+
+	/**
+	 * @return Number of elements currently in the queue. Only a snapshot if
+	 * called while the other thread is active.
+	 * @exception no-throw
+	 */
+	std::size_t size() const
+	{
+		return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Appends 'val' to the end of the queue unless it is full.
+	 * Must only be called from the producer thread.
+	 * @return true if 'val' was enqueued, false if the queue was full
+	 * @exception might throw if T's copy assignment operator throws.
+	 * Provides strong exception safety.
+	 */
+	bool try_push(T const & val)
+	{
+		return try_push(& val, 1) == 1;
+	}
+
+	/**
+	 * Appends up to n elements [first, first + n) to the end of the queue.
+	 * Publishes all of them with a single atomic store.
+	 * Must only be called from the producer thread.
+	 * @return Number of elements actually enqueued (a prefix of [first, first + n))
+	 * @exception might throw if T's copy assignment operator throws. Provides basic
+	 * exception safety: no element is published, some slots might have been overwritten.
+	 */
+	std::size_t try_push(T const * first, std::size_t n)
+	{
+		std::size_t const tail = _tail.load(std::memory_order_relaxed);
+
+		// Only touch the consumer's cache line if our cached view says we're full.
+		if (capacity() - (tail - _head_cache) < n)
+			_head_cache = _head.load(std::memory_order_acquire);
+
+		n = std::min(n, capacity() - (tail - _head_cache));
+		if (n == 0)
+			return 0;
+
+		std::size_t const pos = tail & _mask;
+		std::size_t const n1 = std::min(n, capacity() - pos); // up to the end of the ring
+		std::copy(first, first + n1, _buffer.data() + pos);
+		std::copy(first + n1, first + n, _buffer.data());
+
+		_tail.store(tail + n, std::memory_order_release);
+		return n;
+	}
+
+	/**
+	 * Removes the first element of the queue and stores it in 'val' unless
+	 * the queue is empty. Must only be called from the consumer thread.
+	 * @return true if an element was dequeued, false if the queue was empty
+	 * @exception might throw if T's move assignment operator throws.
+	 */
+	bool try_pop(T & val)
+	{
+		return try_pop(& val, 1) == 1;
+	}
+
+	/**
+	 * Removes up to n elements from the front of the queue and stores them in [out, out + n).
+	 * Releases all of them with a single atomic store.
+	 * Must only be called from the consumer thread.
+	 * @return Number of elements actually dequeued
+	 * @exception might throw if T's move assignment operator throws.
+	 */
+	std::size_t try_pop(T * out, std::size_t n)
+	{
+		std::size_t const head = _head.load(std::memory_order_relaxed);
+
+		if (_tail_cache - head < n)
+			_tail_cache = _tail.load(std::memory_order_acquire);
+
+		n = std::min(n, _tail_cache - head);
+		if (n == 0)
+			return 0;
+
+		std::size_t const pos = head & _mask;
+		std::size_t const n1 = std::min(n, capacity() - pos);
+		std::move(_buffer.data() + pos, _buffer.data() + pos + n1, out);
+		std::move(_buffer.data(), _buffer.data() + (n - n1), out + n1);
+
+		_head.store(head + n, std::memory_order_release);
+		return n;
+	}
+
+private:
+	array<T> _buffer;
+	std::size_t _mask;
+
+	// Consumer-owned cache line: the read index plus the consumer's private copy of _tail.
+	alignas(cache_line_size) std::atomic<std::size_t> _head{0};
+	std::size_t _tail_cache = 0;
+
+	// Producer-owned cache line: the write index plus the producer's private copy of _head.
+	alignas(cache_line_size) std::atomic<std::size_t> _tail{0};
+	std::size_t _head_cache = 0;
+};
+
+
+
+/**
+ * Bounded, lock-free multi-producer/multi-consumer FIFO queue.
+ *
+ * Based on Dmitry Vyukov's bounded MPMC queue: every slot carries a sequence number
+ * which tells producers and consumers whose turn it is. A producer owning ticket 'pos'
+ * may write slot (pos & mask) once its sequence equals pos and hands it to the consumers
+ * by setting it to pos + 1. The consumer owning ticket 'pos' frees the slot again for
+ * the next lap by setting it to pos + capacity(). Threads only contend on _tail (producers)
+ * or _head (consumers), never on the same slot.
+ *
+ * Any number of threads may push and pop concurrently.
+ */
+template <typename T>
+class mpmc_queue
+{
+public:
+	/**
+	 * Constructor, creates an empty queue.
+	 * @param capacity Minimum number of elements the queue can hold,
+	 * rounded up to the next power of two.
+	 * @exception might throw if not enough memory is available or if
+	 * T's constructor throws. Provides strong exception safety.
+	 * @post capacity() >= capacity
+	 */
+	explicit mpmc_queue(std::size_t capacity) :
+		_cells(detail::next_pow2(capacity)),
+		_mask(_cells.size() - 1)
+	{
+		for (std::size_t i = 0; i < _cells.size(); i++)
+			_cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	mpmc_queue(mpmc_queue const &) = delete;
+	mpmc_queue & operator=(mpmc_queue const &) = delete;
+
+	/**
+	 * @return Maximum number of elements the queue can hold
+	 * @exception no-throw
+	 */
+	std::size_t capacity() const { return _cells.size(); }
+
+	/**
+	 * @return Approximate number of elements in the queue (a snapshot, may be
+	 * outdated as soon as it is returned)
+	 * @exception no-throw
+	 */
+	std::size_t size() const
+	{
+		std::size_t const head = _head.load(std::memory_order_acquire);
+		std::size_t const tail = _tail.load(std::memory_order_acquire);
+		return tail > head ? tail - head : 0;
+	}
+
+	/**
+	 * Appends 'val' to the end of the queue unless it is full.
+	 * @return true if 'val' was enqueued, false if the queue was full
+	 * @exception might throw if T's copy assignment operator throws. In that case
+	 * the slot is lost for good (the queue deadlocks), T's assignment should be no-throw.
+	 */
+	bool try_push(T const & val)
+	{
+		return try_push(& val, 1) == 1;
+	}
+
+	/**
+	 * Appends up to n consecutive elements [first, first + n) to the end of the queue.
+	 * Claims all free slots with a single compare-and-swap on _tail, so the elements
+	 * stay contiguous in FIFO order even with competing producers.
+	 * @return Number of elements actually enqueued (a prefix of [first, first + n))
+	 * @exception see try_push(T const &)
+	 */
+	std::size_t try_push(T const * first, std::size_t n)
+	{
+		if (n == 0)
+			return 0;
+
+		std::size_t pos = _tail.load(std::memory_order_relaxed);
+		std::size_t k;
+		for (;;)
+		{
+			// Count how many slots starting at 'pos' are free for this lap. Since nobody
+			// but the owner of ticket pos + k may modify such a slot, they remain free
+			// until our CAS succeeds.
+			k = 0;
+			while (k < n && _cells[(pos + k) & _mask].sequence.load(std::memory_order_acquire) == pos + k)
+				k++;
+
+			if (k > 0)
+			{
+				if (_tail.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+					break;
+			}
+			else
+			{
+				std::intptr_t const diff = static_cast<std::intptr_t>(
+					_cells[pos & _mask].sequence.load(std::memory_order_acquire) - pos);
+
+				if (diff < 0) // slot still occupied from the previous lap => full
+					return 0;
+
+				pos = _tail.load(std::memory_order_relaxed); // another producer was faster
+			}
+		}
+
+		for (std::size_t i = 0; i < k; i++)
+		{
+			cell & c = _cells[(pos + i) & _mask];
+			c.value = first[i];
+			c.sequence.store(pos + i + 1, std::memory_order_release);
+		}
+
+		return k;
+	}
+
+	/**
+	 * Removes the first element of the queue and stores it in 'val' unless
+	 * the queue is empty.
+	 * @return true if an element was dequeued, false if the queue was empty
+	 * @exception might throw if T's move assignment operator throws, see try_push(T const &)
+	 */
+	bool try_pop(T & val)
+	{
+		return try_pop(& val, 1) == 1;
+	}
+
+	/**
+	 * Removes up to n consecutive elements from the front of the queue and stores them
+	 * in [out, out + n). Claims them with a single compare-and-swap on _head.
+	 * @return Number of elements actually dequeued
+	 * @exception see try_pop(T &)
+	 */
+	std::size_t try_pop(T * out, std::size_t n)
+	{
+		if (n == 0)
+			return 0;
+
+		std::size_t pos = _head.load(std::memory_order_relaxed);
+		std::size_t k;
+		for (;;)
+		{
+			k = 0;
+			while (k < n && _cells[(pos + k) & _mask].sequence.load(std::memory_order_acquire) == pos + k + 1)
+				k++;
+
+			if (k > 0)
+			{
+				if (_head.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+					break;
+			}
+			else
+			{
+				std::intptr_t const diff = static_cast<std::intptr_t>(
+					_cells[pos & _mask].sequence.load(std::memory_order_acquire) - (pos + 1));
+
+				if (diff < 0) // slot not yet written in this lap => empty
+					return 0;
+
+				pos = _head.load(std::memory_order_relaxed);
+			}
+		}
+
+		for (std::size_t i = 0; i < k; i++)
+		{
+			cell & c = _cells[(pos + i) & _mask];
+			out[i] = std::move(c.value);
+			c.sequence.store(pos + i + capacity(), std::memory_order_release);
+		}
+
+		return k;
+	}
+
+private:
+	struct cell
+	{
+		std::atomic<std::size_t> sequence;
+		T value;
+	};
+
+	array<cell> _cells;
+	std::size_t _mask;
+
+	alignas(cache_line_size) std::atomic<std::size_t> _head{0};
+	alignas(cache_line_size) std::atomic<std::size_t> _tail{0};
+};
+} // namespace my
@@ -0,0 +1,132 @@
+#include "myconcurrent_vector.h"
+#include "myvector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+// A typical log record
+struct record
+{
+	int thread = -1;
+	int seq = -1;
+};
+
+// Appends 'iter' records from 'nthreads' threads into 'v' using 'append(v, record)'
+// @return duration in ms
+template <typename Vector, typename Append>
+long long append_parallel(Vector & v, int nthreads, int iter, Append append)
+{
+	std::vector<std::thread> threads;
+	std::chrono::high_resolution_clock c;
+
+	auto t1 = c.now();
+	for (int t = 0; t < nthreads; t++)
+		threads.emplace_back([&, t]() {
+			record r;
+			r.thread = t;
+			for (r.seq = 0; r.seq < iter / nthreads; r.seq++)
+				append(v, r);
+		});
+	for (auto & t : threads)
+		t.join();
+	auto t2 = c.now();
+
+	return std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+}
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test concurrent_vector()
+		concurrent_vector<int> x;
+
+		assert(x.size() == 0);
+		assert(x.capacity() == 0);
+	}
+
+	{// Test push_back()/[]
+		concurrent_vector<int> x;
+
+		for (std::size_t i = 0; i < 10'000; i++)
+		{
+			assert(x.push_back(int(i)) == i);
+			assert(x[i] == int(i));
+			assert(x.size() == i + 1);
+			assert(x.capacity() >= x.size());
+		}
+
+		for (int i = 0; i < 10'000; i++)
+			assert(x[i] == i);
+
+		concurrent_vector<int> const & y = x;
+		assert(y[9'999] == 9'999);
+	}
+
+	{// Test stable references
+		concurrent_vector<int> x;
+		x.push_back(17);
+
+		int * first = & x[0];
+		for (int i = 0; i < 100'000; i++)
+			x.push_back(i);
+
+		assert(& x[0] == first);
+		assert(* first == 17);
+	}
+
+	{// Test concurrent push_back(): every record arrives exactly once
+		int const N = 100'000;
+		int const T = 8;
+		concurrent_vector<record> x;
+
+		append_parallel(x, T, N, [](concurrent_vector<record> & v, record const & r) { v.push_back(r); });
+		assert(x.size() == N);
+
+		std::vector<int> next(T, 0);
+		for (int i = 0; i < N; i++)
+		{
+			// records of the same thread appear in the order they were appended
+			assert(x[i].seq == next[x[i].thread]);
+			next[x[i].thread]++;
+		}
+		for (int t = 0; t < T; t++)
+			assert(next[t] == N / T);
+	}
+
+	// Benchmark (run in RELEASE mode!!!, compile with -pthread)
+	int const ITER = 10'000'000; // might need to adjust slightly for your machine
+
+	for (int nthreads = 1; nthreads <= 64; nthreads *= 2)
+	{
+		{
+			vector<record> v;
+			std::mutex m;
+			std::cout << "tAppend " << nthreads << " threads (mutex + vector): "
+				<< append_parallel(v, nthreads, ITER, [&m](vector<record> & v, record const & r) {
+					std::lock_guard<std::mutex> lock(m);
+					v.push_back(r);
+				}) << "ms" << std::endl;
+		}
+		{
+			concurrent_vector<record> v;
+			std::cout << "tAppend " << nthreads << " threads (concurrent_vector): "
+				<< append_parallel(v, nthreads, ITER, [](concurrent_vector<record> & v, record const & r) {
+					v.push_back(r);
+				}) << "ms" << std::endl;
+		}
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,274 @@
+#include "myhash_map.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test flat_hash_map()
+		flat_hash_map<int, int> m;
+
+		assert(m.size() == 0);
+		assert(m.empty());
+		assert(m.capacity() == 0);
+		assert(m.find(5) == m.end());
+		assert(m.begin() == m.end());
+	}
+
+	{// Test insert()/find()
+		flat_hash_map<int, int> m;
+
+		for (std::size_t i = 0; i < 1000; i++)
+		{
+			int const k = int(i);
+			auto r = m.insert(k, k * k);
+			assert(r.second);
+			assert(r.first->first == k);
+			assert(r.first->second == k * k);
+			assert(m.size() == i + 1);
+		}
+
+		assert(!m.insert(7, 0).second); // already there
+		assert(m.find(7)->second == 49);
+
+		for (int i = 0; i < 1000; i++)
+			assert(m.find(i)->second == i * i);
+		for (int i = 1000; i < 2000; i++)
+			assert(m.find(i) == m.end());
+	}
+
+	{// Test operator[]
+		flat_hash_map<int, int> m;
+
+		m[3] = 5;
+		m[3]++;
+		assert(m[3] == 6);
+		assert(m[4] == 0);
+		assert(m.size() == 2);
+	}
+
+	{// Test erase()
+		flat_hash_map<int, int> m;
+
+		for (int i = 0; i < 1000; i++)
+			m.insert(i, i);
+		for (int i = 0; i < 1000; i += 2)
+			assert(m.erase(i) == 1);
+		assert(m.erase(0) == 0);
+		assert(m.size() == 500);
+
+		for (int i = 0; i < 1000; i++)
+			assert(m.contains(i) == (i % 2 == 1));
+
+		auto it = m.find(1);
+		m.erase(it);
+		assert(!m.contains(1));
+	}
+
+	{// Test erase() while iterating: each element is visited once, even when erasing from the last slot wraps around
+		std::mt19937 rng(1);
+		for (int round = 0; round < 100; round++)
+		{
+			int const n = 7 << (round % 6); // full tables: long probe sequences that wrap around
+			flat_hash_map<int, int> m;
+			while (m.size() < std::size_t(n))
+				m[int(rng() % 100'000)] = 0;
+
+			int visits = 0, odd = 0;
+			for (auto it = m.begin(); it != m.end(); )
+			{
+				visits++;
+				it->second++;
+				odd += it->first % 2;
+				if (it->first % 2)
+					it = m.erase(it);
+				else
+					++it;
+			}
+			assert(visits == n);
+			assert(m.size() == std::size_t(n - odd));
+			for (auto const & kv : m)
+				assert(kv.second == 1);
+		}
+	}
+
+	{// Test iteration
+		flat_hash_map<int, int> m;
+		for (int i = 0; i < 100; i++)
+			m[i] = 1;
+
+		for (auto kv : m) // kv refers to the element, like a std::pair<int const, int> &
+			kv.second++;
+		m.begin()->second++;
+
+		int sum = 0;
+		for (auto const & kv : m)
+			sum += kv.second;
+		assert(sum == 201);
+		// Compiler error:
+		// m.begin()->first = 5;
+
+		std::pair<int, int> const copy = * m.find(7);
+		assert(copy.first == 7 && copy.second == m[7]);
+
+		flat_hash_map<int, int> const & c = m;
+		int n = 0;
+		for (auto it = c.begin(); it != c.end(); ++it)
+			n++;
+		assert(n == 100);
+	}
+
+	{// Test reserve()
+		flat_hash_map<int, int> m;
+		m.reserve(1000);
+
+		std::size_t const cap = m.capacity();
+		assert(cap >= 1000);
+
+		for (int i = 0; i < 1000; i++)
+			m[i] = i;
+		assert(m.capacity() == cap); // no rehash
+	}
+
+	{// Test heterogeneous lookup (no temporary std::string)
+		flat_hash_map<std::string, int> m;
+		m.insert("hello", 1);
+		m.insert(std::string("world"), 2);
+
+		assert(m.find("hello")->second == 1);
+		assert(m.find(std::string_view("world"))->second == 2);
+		assert(m.contains("world"));
+		assert(!m.contains("foo"));
+		assert(m.erase("hello") == 1);
+		assert(m.size() == 1);
+	}
+
+	{// Test copy
+		flat_hash_map<int, int> a;
+		a[1] = 1;
+
+		flat_hash_map<int, int> b(a);
+		b[1] = 2;
+		assert(a[1] == 1);
+	}
+
+	{// Test flat_hash_set
+		flat_hash_set<std::string> s;
+
+		assert(s.insert("a").second);
+		assert(!s.insert("a").second);
+		assert(s.insert("b").second);
+		assert(s.contains("a"));
+		assert(s.size() == 2);
+		assert(s.erase("a") == 1);
+		assert(!s.contains("a"));
+		// Compiler error:
+		// * s.begin() = "c";
+	}
+
+	{// Test against std::unordered_map with random operations
+		flat_hash_map<int, int> m;
+		std::unordered_map<int, int> ref;
+		std::mt19937 rng(42);
+
+		for (int i = 0; i < 100'000; i++)
+		{
+			int const key = rng() % 1000;
+			switch (rng() % 3)
+			{
+			case 0: m[key] = i; ref[key] = i; break;
+			case 1: assert(m.erase(key) == ref.erase(key)); break;
+			case 2: assert(m.contains(key) == (ref.count(key) == 1)); break;
+			}
+			assert(m.size() == ref.size());
+		}
+		for (auto & kv : ref)
+			assert(m.find(kv.first)->second == kv.second);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 1'000'000; // might need to adjust slightly for your machine
+
+	std::vector<std::uint64_t> keys(ITER), misses(ITER);
+	{
+		std::mt19937_64 rng(1);
+		for (int i = 0; i < ITER; i++)
+		{
+			keys[i] = rng() | 1;    // odd keys are in the map,
+			misses[i] = rng() & ~1ull; // even keys are not
+		}
+	}
+
+	{
+		std::unordered_map<std::uint64_t, std::uint64_t> u;
+		flat_hash_map<std::uint64_t, std::uint64_t> f;
+		std::chrono::high_resolution_clock c;
+		std::uint64_t sum = 0;
+
+		auto t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			u.insert({ keys[i], i });
+		auto t2 = c.now();
+		std::cout << "tInsert (std::unordered_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			f.insert(keys[i], i);
+		t2 = c.now();
+		std::cout << "tInsert (flat_hash_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			sum += u.find(keys[i])->second;
+		t2 = c.now();
+		std::cout << "tLookupHit (std::unordered_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			sum += f.find(keys[i])->second;
+		t2 = c.now();
+		std::cout << "tLookupHit (flat_hash_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			sum += u.count(misses[i]);
+		t2 = c.now();
+		std::cout << "tLookupMiss (std::unordered_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			sum += f.contains(misses[i]);
+		t2 = c.now();
+		std::cout << "tLookupMiss (flat_hash_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			u.erase(keys[i]);
+		t2 = c.now();
+		std::cout << "tErase (std::unordered_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			f.erase(keys[i]);
+		t2 = c.now();
+		std::cout << "tErase (flat_hash_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		// use the result so the compiler can't optimize the lookups away
+		std::cout << std::endl << "(checksum " << sum << ")" << std::endl;
+	}
+
+	return 0;
+}
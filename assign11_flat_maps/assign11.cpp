@@ -0,0 +1,258 @@
+#include "myflat_map.h"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test flat_set()
+		flat_set<int> s;
+
+		assert(s.size() == 0);
+		assert(s.empty());
+		assert(s.find(1) == s.end());
+		assert(s.lower_bound(1) == s.end());
+	}
+
+	{// Test bulk construction: sorted, duplicates removed
+		int const in[] = { 5, 3, 9, 3, 1, 5, 7 };
+		flat_set<int> s(in, in + 7);
+
+		assert(s.size() == 5);
+		int const expected[] = { 1, 3, 5, 7, 9 };
+		assert(std::equal(s.begin(), s.end(), expected));
+	}
+
+	{// Test lower_bound()/find()/contains()
+		int const in[] = { 10, 20, 30, 40, 50 };
+		flat_set<int> s(in, in + 5);
+
+		assert(* s.lower_bound(0) == 10);
+		assert(* s.lower_bound(10) == 10);
+		assert(* s.lower_bound(11) == 20);
+		assert(* s.lower_bound(50) == 50);
+		assert(s.lower_bound(51) == s.end());
+
+		for (int i = 0; i <= 60; i++)
+			assert(s.contains(i) == (i % 10 == 0 && i >= 10 && i <= 50));
+
+		assert(* s.find(30) == 30);
+		assert(s.find(31) == s.end());
+	}
+
+	{// Test insert() single element
+		flat_set<int> s;
+
+		assert(s.insert(3).second);
+		assert(s.insert(1).second);
+		assert(s.insert(2).second);
+		assert(!s.insert(2).second);
+
+		int const expected[] = { 1, 2, 3 };
+		assert(s.size() == 3);
+		assert(std::equal(s.begin(), s.end(), expected));
+	}
+
+	{// Test batch insert() merges, existing elements win
+		flat_map<int, char> m;
+		m.insert(2, 'a');
+		m.insert(4, 'a');
+		m.insert(6, 'a');
+
+		std::pair<int, char> const batch[] = { { 5, 'b' }, { 1, 'b' }, { 4, 'b' }, { 7, 'b' }, { 1, 'c' } };
+		m.insert(batch, batch + 5);
+
+		assert(m.size() == 6);
+		int const keys[] = { 1, 2, 4, 5, 6, 7 };
+		char const values[] = { 'b', 'a', 'a', 'b', 'a', 'b' };
+		int i = 0;
+		for (auto const & kv : m)
+		{
+			assert(kv.first == keys[i]);
+			assert(kv.second == values[i]);
+			i++;
+		}
+	}
+
+	{// Test flat_map iterators: keys are read-only
+		int const in[] = { 3, 1, 2 };
+		flat_map<int, int> m;
+		for (int k : in)
+			m.insert(k, k);
+
+		for (auto kv : m) // kv refers to the element, like a std::pair<int const, int> &
+			kv.second *= 10;
+		m.begin()->second++;
+		assert(m[1] == 11 && m[2] == 20 && m[3] == 30);
+		// Compiler error:
+		// m.begin()->first = 5;
+
+		auto it = m.end() - 1;
+		assert(it->first == 3 && (it - m.begin()) == 2 && m.begin()[1].second == 20);
+		flat_map<int, int>::const_iterator c = it;
+		assert(c == m.find(3) && (* c).second == 30);
+		std::pair<int, int> const copy = * --c;
+		assert(copy.first == 2 && copy.second == 20);
+	}
+
+	{// Test erase()
+		int const in[] = { 1, 2, 3, 4 };
+		flat_set<int> s(in, in + 4);
+
+		assert(s.erase(2) == 1);
+		assert(s.erase(2) == 0);
+		assert(s.size() == 3);
+		assert(!s.contains(2));
+		assert(s.contains(3));
+	}
+
+	{// Test operator[] and heterogeneous lookup
+		flat_map<std::string, int> m;
+
+		m["b"] = 2;
+		m["a"] = 1;
+		m["a"]++;
+		assert(m.size() == 2);
+		assert(m.find("a")->second == 2);
+		assert(m.begin()->first == "a");
+		assert(m.contains("b"));
+		assert(!m.contains("c"));
+	}
+
+	{// Test against std::set with random batches
+		std::mt19937 rng(42);
+		flat_set<int> s;
+		std::set<int> ref;
+
+		for (int round = 0; round < 100; round++)
+		{
+			std::vector<int> batch(rng() % 50);
+			for (auto & x : batch)
+				x = rng() % 1000;
+
+			s.insert(batch.begin(), batch.end());
+			ref.insert(batch.begin(), batch.end());
+			int const x = rng() % 1000;
+			assert(s.erase(x) == ref.erase(x));
+
+			assert(s.size() == ref.size());
+			assert(std::equal(s.begin(), s.end(), ref.begin()));
+		}
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 1'000'000; // might need to adjust slightly for your machine
+
+	std::vector<int> keys(ITER), lookups(ITER), batch(ITER / 10);
+	{
+		std::mt19937 rng(1);
+		for (auto & k : keys) k = rng() & ~1;    // even keys are in the map,
+		for (auto & k : lookups) k = keys[rng() % ITER] + (rng() & 1); // 50% hits, 50% misses
+		for (auto & k : batch) k = rng() | 1;    // odd keys are new
+	}
+
+	{
+		std::map<int, int> m;
+		flat_map<int, int> f;
+		std::vector<std::pair<int, int>> pairs;
+		for (int k : keys)
+			pairs.push_back({ k, k });
+		std::chrono::high_resolution_clock c;
+		long long sum = 0;
+
+		auto t1 = c.now();
+		for (auto & kv : pairs)
+			m.insert(kv);
+		auto t2 = c.now();
+		std::cout << "tBuild (std::map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		f.insert(pairs.begin(), pairs.end());
+		t2 = c.now();
+		std::cout << "tBuild (flat_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+
+		t1 = c.now();
+		for (int k : lookups)
+		{
+			auto it = m.find(k);
+			sum += it == m.end() ? 0 : it->second;
+		}
+		t2 = c.now();
+		std::cout << "tLookup (std::map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int k : lookups)
+		{
+			auto it = f.find(k);
+			sum += it == f.end() ? 0 : it->second;
+		}
+		t2 = c.now();
+		std::cout << "tLookup (flat_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+
+		t1 = c.now();
+		for (int k : batch)
+			m.insert({ k, k });
+		t2 = c.now();
+		std::cout << "tBatchInsert (std::map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		std::vector<std::pair<int, int>> batch_pairs;
+		for (int k : batch)
+			batch_pairs.push_back({ k, k });
+		t1 = c.now();
+		f.insert(batch_pairs.begin(), batch_pairs.end());
+		t2 = c.now();
+		std::cout << "tBatchInsert (flat_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+
+		t1 = c.now();
+		for (auto & kv : m)
+			sum += kv.second;
+		t2 = c.now();
+		std::cout << "tIterate (std::map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (auto const & kv : f)
+			sum += kv.second;
+		t2 = c.now();
+		std::cout << "tIterate (flat_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+
+		assert(m.size() == f.size());
+		std::cout << "(checksum " << sum << ")" << std::endl << std::endl;
+	}
+
+	{
+		std::set<int> s(keys.begin(), keys.end());
+		flat_set<int> f(keys.begin(), keys.end());
+		std::chrono::high_resolution_clock c;
+		long long hits = 0;
+
+		auto t1 = c.now();
+		for (int k : lookups)
+			hits += s.count(k);
+		auto t2 = c.now();
+		std::cout << "tLookup (std::set): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int k : lookups)
+			hits += f.contains(k);
+		t2 = c.now();
+		std::cout << "tLookup (flat_set): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		std::cout << "(hits " << hits << ")" << std::endl;
+	}
+
+	return 0;
+}
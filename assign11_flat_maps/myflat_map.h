@@ -0,0 +1,353 @@
+#pragma once
+
+#include "myvector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace my {
+namespace detail {
+/**
+ * Sorted, duplicate-free my::vector, the common implementation of flat_map and flat_set.
+ *
+ * Lookups are binary searches over contiguous memory. Inserting a single element
+ * has to shift all greater elements (O(n)), thus this data structure is meant for
+ * read-mostly data that is built in bulk: constructing from an unsorted range or
+ * inserting a batch sorts the new elements once and merges them in a single pass.
+ *
+ * @tparam Value Stored element type (K or std::pair<K, V>)
+ * @tparam KeyOf Function object extracting the key from a Value
+ * @tparam Iterator, ConstIterator Random access iterators over Value, constructible from
+ * Value * and Value const * respectively, that never hand out a mutable reference to
+ * a key: modifying a key in place would break the sort order
+ * @invariant elements are sorted by key, no two elements have equivalent keys
+ */
+template <typename Key, typename Value, typename KeyOf, typename Compare, typename Iterator, typename ConstIterator>
+class sorted_vector
+{
+public:
+	using iterator = Iterator;
+	using const_iterator = ConstIterator;
+
+	/**
+	 * Constructor, creates an empty container.
+	 * @exception no-throw
+	 */
+	sorted_vector() = default;
+
+	/**
+	 * Constructor, creates a container from the unsorted range [first, last).
+	 * If several elements have equivalent keys only the first one is kept.
+	 * @exception might throw if not enough memory is available or if Value's
+	 * assignment or Compare throw.
+	 */
+	template <typename It>
+	sorted_vector(It first, It last) { insert(first, last); }
+
+	/**
+	 * @return Number of elements
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _data.size(); }
+	bool empty() const { return _data.empty(); }
+
+	iterator begin() { return iterator(_data.begin()); }
+	iterator end() { return iterator(_data.end()); }
+	const_iterator begin() const { return const_iterator(_data.begin()); }
+	const_iterator end() const { return const_iterator(_data.end()); }
+
+	/**
+	 * Preallocates memory for n elements, see my::vector::reserve()
+	 */
+	void reserve(std::size_t n) { _data.reserve(n); }
+
+	/**
+	 * Removes all elements, keeps the capacity.
+	 * @exception no-throw
+	 */
+	void clear() { _data.clear(); }
+
+	/**
+	 * @return Iterator to the first element whose key is not less than 'key', end() if there is none.
+	 * Branchless binary search: the loop runs exactly ceil(log2(size())) times and the comparison
+	 * result only selects the next base pointer (compiled to a conditional move) instead of
+	 * a hard-to-predict branch.
+	 * @exception might throw if Compare throws
+	 */
+	template <typename Q>
+	iterator lower_bound(Q const & key) { return begin() + lower_bound_index(key); }
+	template <typename Q>
+	const_iterator lower_bound(Q const & key) const { return begin() + lower_bound_index(key); }
+
+	/**
+	 * @return Iterator to the element with key equivalent to 'key', end() if there is none.
+	 * @exception might throw if Compare throws
+	 */
+	template <typename Q>
+	iterator find(Q const & key) { return begin() + find_index(key); }
+	template <typename Q>
+	const_iterator find(Q const & key) const { return begin() + find_index(key); }
+
+	/**
+	 * @return true if there is an element with key equivalent to 'key'
+	 */
+	template <typename Q>
+	bool contains(Q const & key) const { return find_index(key) != size(); }
+
+	/**
+	 * Inserts 'val' unless an element with equivalent key exists already. O(n).
+	 * @return Iterator to the element with val's key and whether 'val' was inserted
+	 * @exception might throw if not enough memory is available or if Value's
+	 * assignment throws.
+	 */
+	std::pair<iterator, bool> insert(Value const & val)
+	{
+		std::size_t const i = lower_bound_index(KeyOf()(val));
+		if (i < size() && !Compare()(KeyOf()(val), KeyOf()(_data[i])))
+			return { begin() + i, false };
+
+		_data.push_back(val);
+		std::move_backward(_data.begin() + i, _data.end() - 1, _data.end());
+		_data[i] = val;
+		return { begin() + i, true };
+	}
+
+	/**
+	 * Inserts all elements of the unsorted range [first, last) whose keys don't exist yet.
+	 * Instead of shifting the existing elements once per inserted element (O(n * m))
+	 * the batch is sorted and merged with the existing elements back to front
+	 * in a single pass: O(m log m + n).
+	 * @exception might throw if not enough memory is available or if Value's
+	 * assignment or Compare throw. Basic exception safety.
+	 */
+	template <typename It>
+	void insert(It first, It last)
+	{
+		vector<Value> batch;
+		for (; first != last; ++first)
+			batch.push_back(*first);
+
+		// Sort the batch, keep only the first of equivalent elements
+		std::stable_sort(batch.begin(), batch.end(), less);
+		batch.resize(std::unique(batch.begin(), batch.end(), equivalent) - batch.begin());
+
+		std::ptrdiff_t const n = size();
+		std::ptrdiff_t const m = batch.size();
+
+		// Count the batch elements that already exist, so we know the final size.
+		std::ptrdiff_t dups = 0;
+		for (std::ptrdiff_t i = 0, j = 0; i < n && j < m; )
+			if (less(_data[i], batch[j]))
+				i++;
+			else if (less(batch[j], _data[i]))
+				j++;
+			else
+			{
+				dups++;
+				i++;
+				j++;
+			}
+
+		// Merge from the back into the grown vector: every element moves exactly once.
+		_data.resize(n + m - dups);
+		for (std::ptrdiff_t i = n - 1, j = m - 1, k = n + m - dups - 1; j >= 0; k--)
+			if (i >= 0 && !less(_data[i], batch[j]))
+			{
+				if (!less(batch[j], _data[i])) // equivalent: existing element wins
+					j--;
+				_data[k] = std::move(_data[i--]);
+			}
+			else
+				_data[k] = std::move(batch[j--]);
+	}
+
+	/**
+	 * Removes the element with key equivalent to 'key' (if any). O(n).
+	 * @return Number of elements removed (0 or 1)
+	 * @exception might throw if Value's move assignment throws
+	 */
+	template <typename Q>
+	std::size_t erase(Q const & key)
+	{
+		std::size_t const i = find_index(key);
+		if (i == size())
+			return 0;
+
+		std::move(_data.begin() + i + 1, _data.end(), _data.begin() + i);
+		_data.pop_back();
+		return 1;
+	}
+
+private:
+	static bool less(Value const & a, Value const & b) { return Compare()(KeyOf()(a), KeyOf()(b)); }
+	static bool equivalent(Value const & a, Value const & b) { return !less(a, b) && !less(b, a); }
+
+	template <typename Q>
+	std::size_t lower_bound_index(Q const & key) const
+	{
+		Value const * base = _data.data();
+		std::size_t n = size();
+		if (n == 0)
+			return 0;
+
+		// The answer always lies in [base, base + n]
+		while (n > 1)
+		{
+			std::size_t const half = n / 2;
+			base = Compare()(KeyOf()(base[half]), key) ? base + half : base;
+			n -= half;
+		}
+
+		return (base - _data.data()) + Compare()(KeyOf()(* base), key);
+	}
+
+	template <typename Q>
+	std::size_t find_index(Q const & key) const
+	{
+		std::size_t const i = lower_bound_index(key);
+		return (i < size() && !Compare()(key, KeyOf()(_data[i]))) ? i : size();
+	}
+
+	vector<Value> _data;
+};
+
+template <typename K, typename V>
+struct select_first
+{
+	K const & operator()(std::pair<K, V> const & p) const { return p.first; }
+};
+
+template <typename K>
+struct identity
+{
+	K const & operator()(K const & k) const { return k; }
+};
+
+/**
+ * What flat_map's iterators point to: the key and the value of an element, used
+ * like a std::pair<K const, V> &. The elements themselves are std::pair<K, V> (they
+ * are shifted around by assignment), so iterators can't hand out real references.
+ */
+template <typename K, typename V>
+struct pair_ref
+{
+	K const & first;
+	V & second;
+
+	operator std::pair<K, std::remove_const_t<V>>() const { return { first, second }; }
+	// it->first: the iterator's operator-> returns a pair_ref, which forwards to itself
+	pair_ref const * operator->() const { return this; }
+};
+
+/**
+ * flat_map's (const_)iterator: a pointer to std::pair<K, V> that returns pair_refs.
+ */
+template <typename K, typename V, bool Const>
+class pair_iterator
+{
+	using element = std::conditional_t<Const, std::pair<K, V> const, std::pair<K, V>>;
+
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = std::pair<K, V>;
+	using difference_type = std::ptrdiff_t;
+	using reference = pair_ref<K, std::conditional_t<Const, V const, V>>;
+	using pointer = reference;
+
+	pair_iterator() = default;
+	explicit pair_iterator(element * p) : _p(p) {}
+	// iterator -> const_iterator
+	template <bool C = Const, typename = std::enable_if_t<C>>
+	pair_iterator(pair_iterator<K, V, false> const & other) : _p(other._p) {}
+
+	reference operator*() const { return { _p->first, _p->second }; }
+	pointer operator->() const { return ** this; }
+	reference operator[](difference_type n) const { return { _p[n].first, _p[n].second }; }
+
+	pair_iterator & operator++() { ++_p; return * this; }
+	pair_iterator & operator--() { --_p; return * this; }
+	pair_iterator operator++(int) { return pair_iterator(_p++); }
+	pair_iterator operator--(int) { return pair_iterator(_p--); }
+	pair_iterator & operator+=(difference_type n) { _p += n; return * this; }
+	pair_iterator & operator-=(difference_type n) { _p -= n; return * this; }
+	pair_iterator operator+(difference_type n) const { return pair_iterator(_p + n); }
+	pair_iterator operator-(difference_type n) const { return pair_iterator(_p - n); }
+	friend pair_iterator operator+(difference_type n, pair_iterator it) { return it + n; }
+	difference_type operator-(pair_iterator rhs) const { return _p - rhs._p; }
+
+	bool operator==(pair_iterator rhs) const { return _p == rhs._p; }
+	bool operator!=(pair_iterator rhs) const { return _p != rhs._p; }
+	bool operator<(pair_iterator rhs) const { return _p < rhs._p; }
+	bool operator>(pair_iterator rhs) const { return _p > rhs._p; }
+	bool operator<=(pair_iterator rhs) const { return _p <= rhs._p; }
+	bool operator>=(pair_iterator rhs) const { return _p >= rhs._p; }
+
+private:
+	friend class pair_iterator<K, V, true>;
+
+	element * _p = nullptr;
+};
+} // namespace detail
+
+
+
+/**
+ * Ordered map from keys to values backed by a sorted my::vector
+ * (simplified version of C++23's std::flat_map).
+ *
+ * Inserting or erasing invalidates all iterators and references. Iterators return a
+ * pair_ref instead of a std::pair<K const, V> & (bind it with auto or auto const &, not
+ * auto &). K and V must be default constructible.
+ */
+template <typename K, typename V, typename Compare = std::less<>>
+class flat_map : public detail::sorted_vector<K, std::pair<K, V>, detail::select_first<K, V>, Compare,
+	detail::pair_iterator<K, V, false>, detail::pair_iterator<K, V, true>>
+{
+	using base = detail::sorted_vector<K, std::pair<K, V>, detail::select_first<K, V>, Compare,
+		detail::pair_iterator<K, V, false>, detail::pair_iterator<K, V, true>>;
+
+public:
+	using base::base;
+	using base::insert;
+
+	/**
+	 * Inserts the pair (key, val) unless 'key' already exists. O(n).
+	 */
+	std::pair<typename base::iterator, bool> insert(K const & key, V const & val)
+	{
+		return base::insert(std::pair<K, V>(key, val));
+	}
+
+	/**
+	 * @return Reference to the value mapped to 'key', inserts a default-constructed
+	 * value if 'key' doesn't exist yet.
+	 */
+	V & operator[](K const & key)
+	{
+		auto it = base::lower_bound(key);
+		if (it == base::end() || Compare()(key, it->first))
+			it = base::insert(std::pair<K, V>(key, V())).first;
+
+		return it->second;
+	}
+};
+
+/**
+ * Ordered set of unique keys backed by a sorted my::vector, see flat_map.
+ */
+template <typename K, typename Compare = std::less<>>
+class flat_set : public detail::sorted_vector<K, K, detail::identity<K>, Compare, K const *, K const *>
+{
+	using base = detail::sorted_vector<K, K, detail::identity<K>, Compare, K const *, K const *>;
+
+public:
+	using base::base;
+};
+} // namespace my
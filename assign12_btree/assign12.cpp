@@ -0,0 +1,297 @@
+#include "mybtree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+
+// Throws on the 'limit'th assignment, to test exception safety
+struct fragile
+{
+	static int assignments, limit;
+
+	fragile & operator=(fragile const &)
+	{
+		if (++assignments == limit)
+			throw std::runtime_error("fragile");
+		return * this;
+	}
+};
+int fragile::assignments = 0, fragile::limit = 0;
+
+int main()
+{
+	using namespace my;
+
+	{// Test btree_map()
+		btree_map<int, int> m;
+
+		assert(m.size() == 0);
+		assert(m.empty());
+		assert(m.begin() == m.end());
+		assert(m.find(1) == m.end());
+		assert(m.lower_bound(1) == m.end());
+	}
+
+	{// Test insert()/find() across many splits
+		btree_map<int, int> m;
+
+		for (int i = 0; i < 100'000; i++)
+		{
+			int const key = (i * 7919) % 100'000; // all keys, shuffled
+			auto r = m.insert(key, -key);
+			assert(r.second);
+			assert(r.first.key() == key);
+		}
+		assert(m.size() == 100'000);
+		assert(!m.insert(5, 0).second);
+
+		for (int i = 0; i < 100'000; i++)
+			assert(m.find(i).value() == -i);
+		assert(m.find(100'000) == m.end());
+		assert(m.find(-1) == m.end());
+
+		// iteration is ordered
+		int expected = 0;
+		for (auto kv : m)
+		{
+			assert(kv.first == expected);
+			assert(kv.second == -expected);
+			expected++;
+		}
+		assert(expected == 100'000);
+	}
+
+	{// Test lower_bound()/range()
+		btree_map<int, int> m;
+		for (int i = 0; i < 1000; i++)
+			m.insert(i * 10, i);
+
+		assert(m.lower_bound(0).key() == 0);
+		assert(m.lower_bound(1).key() == 10);
+		assert(m.lower_bound(9990).key() == 9990);
+		assert(m.lower_bound(9991) == m.end());
+
+		int n = 0;
+		for (auto kv : m.range(95, 205))
+		{
+			assert(kv.first >= 95 && kv.first < 205);
+			n++;
+		}
+		assert(n == 11); // 100, 110, .., 200
+	}
+
+	{// Test operator[]
+		btree_map<int, int> m;
+
+		m[3] = 1;
+		m[3]++;
+		assert(m[3] == 2);
+		assert(m[4] == 0);
+		assert(m.size() == 2);
+	}
+
+	{// Test erase()
+		btree_map<int, int> m;
+		for (int i = 0; i < 10'000; i++)
+			m.insert(i, i);
+
+		for (int i = 0; i < 10'000; i++)
+			if (i % 100 != 0)
+				assert(m.erase(i) == 1);
+		assert(m.erase(1) == 0);
+		assert(m.size() == 100);
+
+		// Iteration and lower_bound() skip emptied leaves
+		int expected = 0;
+		for (auto kv : m)
+		{
+			assert(kv.first == expected);
+			expected += 100;
+		}
+		assert(m.lower_bound(101).key() == 200);
+		assert(m.lower_bound(9901) == m.end());
+
+		m.insert(150, 0);
+		assert(m.lower_bound(101).key() == 150);
+	}
+
+	{// Test bulk_load()
+		std::vector<std::pair<int, int>> sorted;
+		for (int i = 0; i < 10'000; i++)
+			sorted.push_back({ 2 * i, i });
+
+		btree_map<int, int> m;
+		m.insert(-5, 0); // replaced
+		m.bulk_load(sorted.begin(), sorted.end());
+
+		assert(m.size() == 10'000);
+		assert(!m.contains(-5));
+		for (int i = 0; i < 10'000; i++)
+			assert(m.find(2 * i).value() == i);
+		assert(m.find(1) == m.end());
+
+		// a bulk-loaded tree accepts further inserts
+		for (int i = 0; i < 10'000; i++)
+			assert(m.insert(2 * i + 1, 0).second);
+		int expected = 0;
+		for (auto kv : m)
+			assert(kv.first == expected++);
+	}
+
+	{// Test bulk_load() with room for inserts, strong exception safety
+		std::vector<std::pair<int, int>> sorted;
+		for (int i = 0; i < 10'000; i++)
+			sorted.push_back({ i, i });
+
+		btree_map<int, int> full, half;
+		full.bulk_load(sorted.begin(), sorted.end());
+		half.bulk_load(sorted.begin(), sorted.end(), 0.5);
+		assert(half.size() == 10'000 && half.find(9'999).value() == 9'999);
+		assert(half.memory() > full.memory());
+		half.bulk_load(sorted.begin(), sorted.begin());
+		assert(half.empty() && half.begin() == half.end());
+
+		std::vector<std::pair<int, fragile>> values;
+		for (int i = 0; i < 1000; i++)
+			values.push_back({ i, fragile() });
+		btree_map<int, fragile> m;
+		m.bulk_load(values.begin(), values.begin() + 100);
+
+		fragile::limit = fragile::assignments + 500;
+		bool thrown = false;
+		try
+		{
+			m.bulk_load(values.begin(), values.end());
+		}
+		catch (std::runtime_error const &)
+		{
+			thrown = true;
+		}
+		assert(thrown && m.size() == 100 && m.contains(99) && !m.contains(100));
+	}
+
+	{// Test against std::map with random operations
+		std::mt19937 rng(42);
+		btree_map<int, int> m;
+		std::map<int, int> ref;
+
+		for (int i = 0; i < 200'000; i++)
+		{
+			int const key = rng() % 5000;
+			if (rng() % 3)
+			{
+				assert(m.insert(key, i).second == ref.insert({ key, i }).second);
+			}
+			else
+				assert(m.erase(key) == ref.erase(key));
+		}
+
+		assert(m.size() == ref.size());
+		auto it = ref.begin();
+		for (auto kv : m)
+		{
+			assert(kv.first == it->first && kv.second == it->second);
+			++it;
+		}
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 10'000'000; // might need to adjust slightly for your machine
+	int const RANGE = 100; // keys per range query
+
+	std::vector<int> keys(ITER), lookups(ITER / 10);
+	{
+		std::mt19937 rng(1);
+		for (auto & k : keys) k = rng();
+		for (auto & k : lookups) k = keys[rng() % ITER];
+	}
+
+	{
+		std::map<int, int> m;
+		btree_map<int, int> b;
+		std::chrono::high_resolution_clock c;
+		long long sum = 0;
+
+		auto t1 = c.now();
+		for (int k : keys)
+			m.insert({ k, k });
+		auto t2 = c.now();
+		std::cout << "tInsert (std::map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int k : keys)
+			b.insert(k, k);
+		t2 = c.now();
+		std::cout << "tInsert (btree_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+
+		t1 = c.now();
+		for (int k : lookups)
+			sum += m.find(k)->second;
+		t2 = c.now();
+		std::cout << "tLookup (std::map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int k : lookups)
+			sum += b.find(k).value();
+		t2 = c.now();
+		std::cout << "tLookup (btree_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+
+		t1 = c.now();
+		for (int k : lookups)
+		{
+			auto it = m.lower_bound(k);
+			for (int i = 0; i < RANGE && it != m.end(); i++, ++it)
+				sum += it->second;
+		}
+		t2 = c.now();
+		std::cout << "tRange (std::map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int k : lookups)
+		{
+			auto it = b.lower_bound(k);
+			for (int i = 0; i < RANGE && it != b.end(); i++, ++it)
+				sum += it.value();
+		}
+		t2 = c.now();
+		std::cout << "tRange (btree_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+
+		std::cout << "Memory (btree_map): " << b.memory() / (1024 * 1024) << "MB" << std::endl;
+		std::cout << "(checksum " << sum << ")" << std::endl << std::endl;
+	}
+
+	{// Bulk loading sorted input
+		std::vector<std::pair<int, int>> sorted;
+		for (int k : keys)
+			sorted.push_back({ k, k });
+		std::sort(sorted.begin(), sorted.end());
+		sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+		std::map<int, int> m;
+		btree_map<int, int> b;
+		std::chrono::high_resolution_clock c;
+
+		auto t1 = c.now();
+		for (auto & kv : sorted)
+			m.insert(m.end(), kv); // hint: append at the end
+		auto t2 = c.now();
+		std::cout << "tBulkLoad (std::map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		b.bulk_load(sorted.begin(), sorted.end());
+		t2 = c.now();
+		std::cout << "tBulkLoad (btree_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,453 @@
+#pragma once
+
+#include "mypool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+
+
+namespace my {
+/**
+ * Ordered map from keys to values (simplified version of std::map) implemented
+ * as a B+ tree.
+ *
+ * Instead of one node per element (std::map is a red-black tree) every node holds
+ * many keys in a contiguous array spanning several cache lines, so a lookup touches
+ * only log_B(n) nodes (B = fan-out, 64 for int keys) and searches inside each node
+ * are cache-friendly. All key/value pairs live in the leaves, which are chained
+ * together so that in-order iteration and range queries are linear scans.
+ * Nodes come from a pool (one allocation per 256 nodes instead of per element).
+ *
+ * erase() removes elements from their leaf without merging underfull nodes
+ * (like many databases do): lookups stay correct, but a map that shrank a lot
+ * should be rebuilt with bulk_load().
+ *
+ * Inserting or erasing invalidates iterators into the affected leaf.
+ * K and V must be default constructible.
+ *
+ * @tparam NodeBytes Size of a node's key array, a multiple of the cache line size
+ */
+template <typename K, typename V, typename Compare = std::less<>, std::size_t NodeBytes = 256>
+class btree_map
+{
+	static constexpr std::size_t fan_out = NodeBytes / sizeof(K) < 4 ? 4 : NodeBytes / sizeof(K);
+	static constexpr std::size_t max_height = 32;
+
+	struct node
+	{
+		std::uint32_t count = 0; // number of keys
+	};
+
+	struct leaf : node
+	{
+		leaf * next = nullptr;
+		alignas(64) K keys[fan_out];
+		V values[fan_out];
+	};
+
+	// Child i holds the keys in [keys[i-1], keys[i])
+	struct inner : node
+	{
+		alignas(64) K keys[fan_out];
+		node * children[fan_out + 1];
+	};
+
+public:
+	/**
+	 * Forward iterator over (key, value) pairs in ascending key order.
+	 * Dereferencing yields a std::pair<K const &, V &> (keys and values are
+	 * stored in separate arrays, there is no std::pair to refer to).
+	 */
+	template <bool Const>
+	class iterator_impl
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::pair<K const &, std::conditional_t<Const, V const &, V &>>;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type;
+		using pointer = void;
+
+		iterator_impl() = default;
+		iterator_impl(leaf * l, std::size_t i) : _leaf(l), _i(i) { skip_empty(); }
+		template <bool C = Const, typename = std::enable_if_t<C>>
+		iterator_impl(iterator_impl<false> const & other) : _leaf(other._leaf), _i(other._i) {}
+
+		K const & key() const { return _leaf->keys[_i]; }
+		std::conditional_t<Const, V const &, V &> value() const { return _leaf->values[_i]; }
+		reference operator*() const { return reference(key(), value()); }
+
+		iterator_impl & operator++()
+		{
+			_i++;
+			skip_empty();
+			return * this;
+		}
+
+		bool operator==(iterator_impl const & rhs) const { return _leaf == rhs._leaf && _i == rhs._i; }
+		bool operator!=(iterator_impl const & rhs) const { return !(* this == rhs); }
+
+	private:
+		friend class btree_map;
+		friend class iterator_impl<true>;
+
+		// Moves past the end of a leaf (or past empty leaves) to the next non-empty one.
+		void skip_empty()
+		{
+			while (_leaf && _i >= _leaf->count)
+			{
+				_leaf = _leaf->next;
+				_i = 0;
+			}
+		}
+
+		leaf * _leaf = nullptr;
+		std::size_t _i = 0;
+	};
+
+	using iterator = iterator_impl<false>;
+	using const_iterator = iterator_impl<true>;
+
+	/**
+	 * A pair of iterators usable in range-based for loops.
+	 */
+	template <typename It>
+	struct range_t
+	{
+		It first, last;
+		It begin() const { return first; }
+		It end() const { return last; }
+	};
+
+	/**
+	 * Constructor, creates an empty map.
+	 * @exception no-throw
+	 */
+	btree_map() : _root(nullptr), _first(nullptr), _height(0), _size(0) {}
+
+	// Nodes point to each other, a copy would need a deep clone of the tree.
+	btree_map(btree_map const &) = delete;
+	btree_map & operator=(btree_map const &) = delete;
+
+	/**
+	 * @return Number of elements
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * @return Number of bytes allocated for nodes
+	 * @exception no-throw
+	 */
+	std::size_t memory() const { return _leaves.memory() + _inners.memory(); }
+
+	iterator begin() { return iterator(_first, 0); }
+	iterator end() { return iterator(); }
+	const_iterator begin() const { return const_iterator(_first, 0); }
+	const_iterator end() const { return const_iterator(); }
+
+	/**
+	 * Removes all elements and frees all nodes.
+	 * @exception no-throw
+	 * @post size() == 0
+	 */
+	void clear()
+	{
+		_leaves.clear();
+		_inners.clear();
+		_root = nullptr;
+		_first = nullptr;
+		_height = 0;
+		_size = 0;
+	}
+
+	/**
+	 * @return Iterator to the first element whose key is not less than 'key', end() if there is none.
+	 * @exception might throw if Compare throws
+	 */
+	template <typename Q>
+	iterator lower_bound(Q const & key)
+	{
+		if (!_root)
+			return end();
+
+		leaf * l = find_leaf(key, nullptr);
+		return iterator(l, std::lower_bound(l->keys, l->keys + l->count, key, Compare()) - l->keys);
+	}
+	template <typename Q>
+	const_iterator lower_bound(Q const & key) const { return const_cast<btree_map *>(this)->lower_bound(key); }
+
+	/**
+	 * @return All elements with keys in [lo, hi), in ascending order
+	 */
+	template <typename Q>
+	range_t<iterator> range(Q const & lo, Q const & hi) { return { lower_bound(lo), lower_bound(hi) }; }
+	template <typename Q>
+	range_t<const_iterator> range(Q const & lo, Q const & hi) const { return { lower_bound(lo), lower_bound(hi) }; }
+
+	/**
+	 * @return Iterator to the element with key equivalent to 'key', end() if there is none.
+	 */
+	template <typename Q>
+	iterator find(Q const & key)
+	{
+		iterator it = lower_bound(key);
+		return (it == end() || Compare()(key, it.key())) ? end() : it;
+	}
+	template <typename Q>
+	const_iterator find(Q const & key) const { return const_cast<btree_map *>(this)->find(key); }
+
+	template <typename Q>
+	bool contains(Q const & key) const { return find(key) != end(); }
+
+	/**
+	 * Inserts the pair (key, val) unless 'key' already exists. O(log n).
+	 * @return Iterator to the element with key 'key' and whether it was inserted
+	 * @exception might throw if not enough memory is available or if K's/V's
+	 * assignment throws. Basic exception safety.
+	 */
+	std::pair<iterator, bool> insert(K const & key, V const & val)
+	{
+		if (!_root)
+		{
+			_first = _leaves.allocate();
+			_root = _first;
+			_height = 1;
+		}
+
+		// Descend, remembering the path so we can propagate splits upwards.
+		inner * path[max_height];
+		leaf * l = find_leaf(key, path);
+
+		std::size_t i = std::lower_bound(l->keys, l->keys + l->count, key, Compare()) - l->keys;
+		if (i < l->count && !Compare()(key, l->keys[i]))
+			return { iterator(l, i), false };
+
+		if (l->count == fan_out) // full => split in two halves
+		{
+			leaf * right = _leaves.allocate();
+			std::size_t const half = fan_out / 2;
+
+			std::move(l->keys + half, l->keys + fan_out, right->keys);
+			std::move(l->values + half, l->values + fan_out, right->values);
+			right->count = fan_out - half;
+			l->count = half;
+			right->next = l->next;
+			l->next = right;
+
+			insert_into_parent(path, _height - 1, right->keys[0], right);
+
+			if (i > half) // at i == half key < right->keys[0], it belongs to the left leaf
+			{
+				l = right;
+				i -= half;
+			}
+		}
+
+		std::move_backward(l->keys + i, l->keys + l->count, l->keys + l->count + 1);
+		std::move_backward(l->values + i, l->values + l->count, l->values + l->count + 1);
+		l->keys[i] = key;
+		l->values[i] = val;
+		l->count++;
+		_size++;
+
+		return { iterator(l, i), true };
+	}
+
+	/**
+	 * @return Reference to the value mapped to 'key', inserts a default-constructed
+	 * value if 'key' doesn't exist yet.
+	 */
+	V & operator[](K const & key)
+	{
+		iterator it = find(key);
+		if (it == end())
+			it = insert(key, V()).first;
+
+		return it.value();
+	}
+
+	/**
+	 * Removes the element with key equivalent to 'key' (if any), see class description.
+	 * @return Number of elements removed (0 or 1)
+	 * @exception might throw if K's/V's move assignment throws
+	 */
+	template <typename Q>
+	std::size_t erase(Q const & key)
+	{
+		iterator it = find(key);
+		if (it == end())
+			return 0;
+
+		leaf * l = it._leaf;
+		std::move(l->keys + it._i + 1, l->keys + l->count, l->keys + it._i);
+		std::move(l->values + it._i + 1, l->values + l->count, l->values + it._i);
+		l->count--;
+		_size--;
+		return 1;
+	}
+
+	/**
+	 * Replaces the contents of the map with the elements of [first, last), which must
+	 * be sorted by key and free of duplicates (dereferencing must yield something with
+	 * 'first' and 'second' members). Builds the tree bottom-up in O(n): fills the leaves
+	 * one after the other, then builds each inner level from the one below.
+	 * @param fill Fraction of each node to fill, leave room for future inserts with < 1
+	 * @pre 0 < fill <= 1
+	 * @exception might throw if not enough memory is available or if K's/V's assignment
+	 * throws. Provides strong exception safety: the new tree is built aside and only
+	 * replaces the old one once it is complete.
+	 */
+	template <typename It>
+	void bulk_load(It first, It last, double fill = 1.0)
+	{
+		assert(fill > 0 && fill <= 1);
+		std::size_t const per_node = std::clamp<std::size_t>(static_cast<std::size_t>(fan_out * fill), 2, fan_out);
+
+		btree_map tmp;
+		if (first == last)
+		{
+			swap(tmp);
+			return;
+		}
+
+		// Leaves, remembering each leaf and its smallest key for the level above
+		vector<node *> level;
+		vector<K> mins;
+		leaf * prev = nullptr;
+		while (first != last)
+		{
+			leaf * l = tmp._leaves.allocate();
+			for (; first != last && l->count < per_node; ++first)
+			{
+				assert(l->count == 0 || Compare()(l->keys[l->count - 1], first->first));
+				l->keys[l->count] = first->first;
+				l->values[l->count] = first->second;
+				l->count++;
+			}
+
+			(prev ? prev->next : tmp._first) = l;
+			prev = l;
+			level.push_back(l);
+			mins.push_back(l->keys[0]);
+			tmp._size += l->count;
+		}
+		tmp._height = 1;
+
+		// Inner levels: each inner node takes up to per_node + 1 children of the level below
+		while (level.size() > 1)
+		{
+			vector<node *> parents;
+			vector<K> parent_mins;
+			for (std::size_t c = 0; c < level.size(); )
+			{
+				inner * n = tmp._inners.allocate();
+				parent_mins.push_back(mins[c]);
+				n->children[0] = level[c++];
+				for (; c < level.size() && n->count < per_node; c++)
+				{
+					n->keys[n->count] = mins[c];
+					n->children[++n->count] = level[c];
+				}
+				parents.push_back(n);
+			}
+
+			level = parents;
+			mins = parent_mins;
+			tmp._height++;
+		}
+
+		tmp._root = level[0];
+		swap(tmp); // the old nodes go away with tmp
+	}
+
+private:
+	// Descends from the root to the leaf responsible for 'key', records the inner nodes on the way.
+	template <typename Q>
+	leaf * find_leaf(Q const & key, inner ** path) const
+	{
+		node * n = _root;
+		for (std::size_t h = 1; h < _height; h++)
+		{
+			inner * in = static_cast<inner *>(n);
+			if (path)
+				path[h - 1] = in;
+			n = in->children[std::upper_bound(in->keys, in->keys + in->count, key, Compare()) - in->keys];
+		}
+
+		return static_cast<leaf *>(n);
+	}
+
+	void swap(btree_map & other) noexcept
+	{
+		_leaves.swap(other._leaves);
+		_inners.swap(other._inners);
+		std::swap(_root, other._root);
+		std::swap(_first, other._first);
+		std::swap(_height, other._height);
+		std::swap(_size, other._size);
+	}
+
+	// Inserts separator 'key' and the new right sibling 'child' into path[depth - 1],
+	// splitting inner nodes up to the root as necessary.
+	void insert_into_parent(inner ** path, std::size_t depth, K key, node * child)
+	{
+		if (depth == 0) // the root itself split => grow a new root
+		{
+			assert(_height < max_height);
+			inner * root = _inners.allocate();
+			root->keys[0] = key;
+			root->children[0] = _root;
+			root->children[1] = child;
+			root->count = 1;
+			_root = root;
+			_height++;
+			return;
+		}
+
+		inner * p = path[depth - 1];
+		std::size_t i = std::upper_bound(p->keys, p->keys + p->count, key, Compare()) - p->keys;
+
+		if (p->count == fan_out)
+		{
+			// Split: the middle key moves up, the right half goes into a new node
+			inner * right = _inners.allocate();
+			std::size_t const half = fan_out / 2;
+			K const up = p->keys[half];
+
+			std::move(p->keys + half + 1, p->keys + fan_out, right->keys);
+			std::copy(p->children + half + 1, p->children + fan_out + 1, right->children);
+			right->count = fan_out - half - 1;
+			p->count = half;
+
+			insert_into_parent(path, depth - 1, up, right);
+
+			if (i > half)
+			{
+				p = right;
+				i -= half + 1;
+			}
+		}
+
+		std::move_backward(p->keys + i, p->keys + p->count, p->keys + p->count + 1);
+		std::copy_backward(p->children + i + 1, p->children + p->count + 1, p->children + p->count + 2);
+		p->keys[i] = key;
+		p->children[i + 1] = child;
+		p->count++;
+	}
+
+	pool<leaf> _leaves;
+	pool<inner> _inners;
+	node * _root;
+	leaf * _first; // leftmost leaf, start of iteration
+	std::size_t _height; // number of levels including the leaves, 0 if empty
+	std::size_t _size;
+};
+} // namespace my
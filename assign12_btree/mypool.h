@@ -0,0 +1,87 @@
+#pragma once
+
+#include "myarray.h"
+#include "myvector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+
+
+namespace my {
+/**
+ * Monotonic object pool: hands out default-constructed objects of type T from large
+ * chunks (my::array) instead of calling 'new' once per object. Objects allocated one
+ * after the other end up next to each other in memory, and allocating is a mere
+ * pointer bump. Individual objects are never freed, all of them are released at once
+ * by clear() or the destructor.
+ *
+ * Objects never move: pointers returned by allocate() stay valid until clear().
+ */
+template <typename T>
+class pool
+{
+public:
+	/**
+	 * Constructor, creates an empty pool. Does not allocate.
+	 * @param chunk_size Number of objects allocated at once
+	 * @exception no-throw
+	 */
+	explicit pool(std::size_t chunk_size = 256) : _chunk_size(chunk_size), _used(chunk_size) {}
+
+	// Objects are referred to by address, a copy would be useless.
+	pool(pool const &) = delete;
+	pool & operator=(pool const &) = delete;
+
+	/**
+	 * @return Pointer to a fresh, default-constructed T
+	 * @exception might throw if not enough memory is available to allocate a new chunk
+	 * or if T's constructor throws. Provides strong exception safety.
+	 */
+	T * allocate()
+	{
+		if (_used == _chunk_size)
+		{
+			array<T> chunk(_chunk_size);
+			_chunks.push_back(array<T>());
+			_chunks[_chunks.size() - 1].swap(chunk); // no deep copy
+			_used = 0;
+		}
+
+		return & _chunks[_chunks.size() - 1][_used++];
+	}
+
+	/**
+	 * Destroys all objects, invalidating all pointers handed out so far.
+	 * @exception no-throw
+	 */
+	void clear()
+	{
+		_chunks = vector<array<T>>();
+		_used = _chunk_size;
+	}
+
+	/**
+	 * Exchanges the objects of this pool with those of 'other', pointers stay valid.
+	 * @exception no-throw
+	 */
+	void swap(pool & other) noexcept
+	{
+		std::swap(_chunks, other._chunks);
+		std::swap(_chunk_size, other._chunk_size);
+		std::swap(_used, other._used);
+	}
+
+	/**
+	 * @return Number of bytes allocated by the pool
+	 * @exception no-throw
+	 */
+	std::size_t memory() const { return _chunks.size() * _chunk_size * sizeof(T); }
+
+private:
+	vector<array<T>> _chunks;
+	std::size_t _chunk_size;
+	std::size_t _used; // number of objects handed out from the last chunk
+};
+} // namespace my
@@ -0,0 +1,315 @@
+#include "myheap.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+
+// Baseline: pairing heap, the classic node-based priority queue with O(1) insert.
+// Every element is a separately allocated node (just like our list from assignment 7).
+class pairing_heap
+{
+public:
+	~pairing_heap()
+	{
+		while (!empty())
+			pop();
+	}
+
+	bool empty() const { return _root == nullptr; }
+	int top() const { return _root->value; }
+
+	void push(int x)
+	{
+		node * n = new node;
+		n->value = x;
+		_root = meld(_root, n);
+	}
+
+	void pop()
+	{
+		node * old = _root;
+		_root = merge_pairs(_root->child);
+		delete old;
+	}
+
+private:
+	struct node
+	{
+		int value = 0;
+		node * child = nullptr;
+		node * sibling = nullptr;
+	};
+
+	static node * meld(node * a, node * b)
+	{
+		if (!a) return b;
+		if (!b) return a;
+		if (a->value < b->value)
+			std::swap(a, b);
+
+		b->sibling = a->child;
+		a->child = b;
+		return a;
+	}
+
+	// Two-pass pairing: meld siblings pairwise left to right, then fold right to left
+	static node * merge_pairs(node * first)
+	{
+		std::vector<node *> pairs;
+		while (first)
+		{
+			node * a = first;
+			node * b = a->sibling;
+			first = b ? b->sibling : nullptr;
+			a->sibling = nullptr;
+			if (b)
+				b->sibling = nullptr;
+			pairs.push_back(meld(a, b));
+		}
+
+		node * result = nullptr;
+		for (std::size_t i = pairs.size(); i-- > 0; )
+			result = meld(pairs[i], result);
+		return result;
+	}
+
+	node * _root = nullptr;
+};
+
+// Pushes all 'keys' one by one, then pops everything
+// @return duration in ms
+template <typename Queue>
+long long push_pop(std::vector<int> const & keys, long long & checksum)
+{
+	std::chrono::high_resolution_clock c;
+	auto t1 = c.now();
+	{
+		Queue q;
+		for (int k : keys)
+			q.push(k);
+		while (!q.empty())
+		{
+			checksum += q.top();
+			q.pop();
+		}
+	}
+	auto t2 = c.now();
+	return std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+}
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test priority_queue()
+		priority_queue<int> q;
+
+		assert(q.size() == 0);
+		assert(q.empty());
+	}
+
+	{// Test push()/top()/pop()
+		priority_queue<int> q;
+		int const in[] = { 5, 1, 9, 3, 7, 9, 0 };
+		for (int x : in)
+			q.push(x);
+
+		assert(q.size() == 7);
+		int const expected[] = { 9, 9, 7, 5, 3, 1, 0 };
+		for (int x : expected)
+		{
+			assert(q.top() == x);
+			q.pop();
+		}
+		assert(q.empty());
+	}
+
+	{// Test heapify and bulk push() for several arities and against std::priority_queue
+		std::mt19937 rng(42);
+		std::vector<int> in(1000);
+		for (auto & x : in)
+			x = rng() % 100;
+
+		priority_queue<int, std::less<int>, 2> q2(in.begin(), in.end());
+		priority_queue<int, std::greater<int>, 4> q4(in.begin(), in.begin() + 10);
+		priority_queue<int, std::less<int>, 8> q8;
+		q4.push(in.begin() + 10, in.begin() + 12); // small batch: sift up
+		q4.push(in.begin() + 12, in.end());        // large batch: heapify
+		for (int x : in)
+			q8.push(x);
+
+		std::priority_queue<int> ref(in.begin(), in.end());
+		std::sort(in.begin(), in.end());
+		for (std::size_t i = 0; i < in.size(); i++)
+		{
+			assert(q2.top() == ref.top());
+			assert(q8.top() == ref.top());
+			assert(q4.top() == in[i]); // min-heap
+			q2.pop();
+			q4.pop();
+			q8.pop();
+			ref.pop();
+		}
+	}
+
+	{// Test indexed_priority_queue push()/pop()
+		indexed_priority_queue<int> q;
+		auto a = q.push(5);
+		auto b = q.push(7);
+		auto c = q.push(1);
+
+		assert(q.size() == 3);
+		assert(q.top() == 7);
+		assert(q.top_handle() == b);
+		assert(q[a] == 5 && q[c] == 1);
+
+		q.pop();
+		assert(!q.contains(b));
+		assert(q.top_handle() == a);
+
+		auto d = q.push(3); // reuses b's handle
+		assert(d == b);
+		assert(q[d] == 3);
+	}
+
+	{// Test decrease_key()/update()/erase() as a min-queue
+		indexed_priority_queue<int, std::greater<int>> q;
+		std::vector<indexed_priority_queue<int, std::greater<int>>::handle> h;
+		for (int i = 0; i < 100; i++)
+			h.push_back(q.push(100 + i));
+
+		q.decrease_key(h[50], 1);
+		assert(q.top() == 1 && q.top_handle() == h[50]);
+
+		q.update(h[50], 1000); // moves down
+		assert(q.top() == 100);
+
+		q.erase(h[0]);
+		assert(!q.contains(h[0]));
+		assert(q.top() == 101);
+		assert(q.size() == 99);
+
+		int prev = 0;
+		while (!q.empty())
+		{
+			assert(q.top() >= prev);
+			prev = q.top();
+			q.pop();
+		}
+		assert(prev == 1000);
+	}
+
+	{// Test pairing_heap (benchmark baseline)
+		pairing_heap q;
+		int const in[] = { 5, 1, 9, 3 };
+		for (int x : in)
+			q.push(x);
+		assert(q.top() == 9); q.pop();
+		assert(q.top() == 5); q.pop();
+		assert(q.top() == 3);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 10'000'000; // might need to adjust slightly for your machine
+
+	std::vector<int> keys(ITER);
+	{
+		std::mt19937 rng(1);
+		for (auto & k : keys)
+			k = rng();
+	}
+
+	{// push all, pop all
+		long long checksum = 0;
+
+		std::cout << "tPushPop (std::priority_queue): " << push_pop<std::priority_queue<int>>(keys, checksum) << "ms" << std::endl;
+		std::cout << "tPushPop (pairing heap): " << push_pop<pairing_heap>(keys, checksum) << "ms" << std::endl;
+		std::cout << "tPushPop (my::priority_queue, D = 2): " << push_pop<priority_queue<int, std::less<int>, 2>>(keys, checksum) << "ms" << std::endl;
+		std::cout << "tPushPop (my::priority_queue, D = 4): " << push_pop<priority_queue<int, std::less<int>, 4>>(keys, checksum) << "ms" << std::endl;
+		std::cout << "(checksum " << checksum << ")" << std::endl << std::endl;
+	}
+
+	{// Bulk push
+		std::chrono::high_resolution_clock c;
+
+		auto t1 = c.now();
+		std::priority_queue<int> s;
+		for (int k : keys)
+			s.push(k);
+		auto t2 = c.now();
+		std::cout << "tBulkPush (std::priority_queue, one by one): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		priority_queue<int> q(keys.begin(), keys.end());
+		t2 = c.now();
+		std::cout << "tBulkPush (my::priority_queue, heapify): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+	}
+
+	{// Scheduler: ITER decrease_key operations on N tasks, then drain
+		int const N = ITER / 10;
+		std::mt19937 rng(2);
+		std::chrono::high_resolution_clock c;
+		long long checksum = 0;
+
+		// std::priority_queue has no decrease_key: push a duplicate, skip outdated entries when popping
+		auto t1 = c.now();
+		{
+			std::vector<int> prio(N);
+			std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> q;
+			for (int i = 0; i < N; i++)
+				q.push({ prio[i] = keys[i] & 0x7FFFFFFF, i });
+			for (int i = 0; i < ITER; i++)
+			{
+				int const task = rng() % N;
+				prio[task] /= 2;
+				q.push({ prio[task], task });
+			}
+			while (!q.empty())
+			{
+				if (q.top().first == prio[q.top().second])
+				{
+					checksum += q.top().first;
+					prio[q.top().second] = -1;
+				}
+				q.pop();
+			}
+		}
+		auto t2 = c.now();
+		std::cout << "tDecreaseKey (std::priority_queue, lazy deletion): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		rng.seed(2);
+		t1 = c.now();
+		{
+			indexed_priority_queue<int, std::greater<int>> q;
+			std::vector<indexed_priority_queue<int, std::greater<int>>::handle> h(N);
+			for (int i = 0; i < N; i++)
+				h[i] = q.push(keys[i] & 0x7FFFFFFF);
+			for (int i = 0; i < ITER; i++)
+			{
+				int const task = rng() % N;
+				q.decrease_key(h[task], q[h[task]] / 2);
+			}
+			while (!q.empty())
+			{
+				checksum -= q.top();
+				q.pop();
+			}
+		}
+		t2 = c.now();
+		std::cout << "tDecreaseKey (indexed_priority_queue): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << checksum << ", should be 0)" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,389 @@
+#pragma once
+
+#include "myvector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+
+
+namespace my {
+namespace detail {
+/**
+ * Sift-up/sift-down for a D-ary heap stored in an array. The children of element i
+ * are D * i + 1 .. D * i + D, its parent is (i - 1) / D. Elements are moved into their
+ * new position with 'place(i, x)', which allows the indexed heap to keep track of
+ * where each element lives.
+ */
+template <std::size_t D, typename T, typename Less, typename Place>
+void sift_up(T * heap, std::size_t i, Less less, Place place)
+{
+	T x = std::move(heap[i]);
+	while (i > 0)
+	{
+		std::size_t const parent = (i - 1) / D;
+		if (!less(heap[parent], x))
+			break;
+
+		place(i, std::move(heap[parent]));
+		i = parent;
+	}
+	place(i, std::move(x));
+}
+
+template <std::size_t D, typename T, typename Less, typename Place>
+void sift_down(T * heap, std::size_t n, std::size_t i, Less less, Place place)
+{
+	T x = std::move(heap[i]);
+	for (;;)
+	{
+		std::size_t const first = D * i + 1;
+		if (first >= n)
+			break;
+
+		// Find the greatest child. The D children are adjacent in memory,
+		// with D = 4 and 16 byte elements they share a single cache line.
+		std::size_t const last = first + D < n ? first + D : n;
+		std::size_t best = first;
+		for (std::size_t c = first + 1; c < last; c++)
+			if (less(heap[best], heap[c]))
+				best = c;
+
+		if (!less(x, heap[best]))
+			break;
+
+		place(i, std::move(heap[best]));
+		i = best;
+	}
+	place(i, std::move(x));
+}
+
+template <typename T>
+struct assign_to
+{
+	T * heap;
+	void operator()(std::size_t i, T && x) const { heap[i] = std::move(x); }
+};
+
+/**
+ * Removes heap[0]: moves the hole at the top down to a leaf (always promoting the
+ * greatest child, without comparing against the element that will fill the hole),
+ * then drops the last element into the hole and sifts it up. The last element
+ * almost always belongs near the bottom, so this saves one comparison per level
+ * compared to sift_down(). (Floyd's trick, std::pop_heap does the same.)
+ * @return new number of elements
+ */
+template <std::size_t D, typename T, typename Less>
+std::size_t pop_top(T * heap, std::size_t n, Less less)
+{
+	std::size_t const last = n - 1;
+	std::size_t i = 0;
+	for (;;)
+	{
+		std::size_t const first = D * i + 1;
+		if (first >= last)
+			break;
+
+		std::size_t const end = first + D < last ? first + D : last;
+		std::size_t best = first;
+		for (std::size_t c = first + 1; c < end; c++)
+			if (less(heap[best], heap[c]))
+				best = c;
+
+		heap[i] = std::move(heap[best]);
+		i = best;
+	}
+
+	if (i != last)
+	{
+		heap[i] = std::move(heap[last]);
+		sift_up<D>(heap, i, less, assign_to<T>{ heap });
+	}
+	return last;
+}
+} // namespace detail
+
+
+
+/**
+ * Priority queue (simplified version of std::priority_queue) implemented as
+ * a D-ary heap over a my::vector.
+ *
+ * A binary heap (D = 2) is log2(n) levels deep and every level of sift-down
+ * touches a different cache line. A 4-ary heap is only half as deep and the
+ * 4 children it compares per level are adjacent in memory.
+ *
+ * As with std::priority_queue, top() is the greatest element according to Compare.
+ * @invariant no element is greater than its parent
+ */
+template <typename T, typename Compare = std::less<T>, std::size_t D = 4>
+class priority_queue
+{
+	static_assert(D >= 2, "a heap needs at least 2 children per node");
+
+public:
+	/**
+	 * Constructor, creates an empty queue.
+	 * @exception no-throw
+	 */
+	priority_queue() = default;
+
+	/**
+	 * Constructor, creates a queue from the elements [first, last) in O(n) (heapify).
+	 * @exception might throw if not enough memory is available or if T's
+	 * assignment or Compare throw.
+	 */
+	template <typename It>
+	priority_queue(It first, It last) { push(first, last); }
+
+	/**
+	 * @return Number of elements
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _heap.size(); }
+	bool empty() const { return _heap.empty(); }
+
+	/**
+	 * @return The greatest element
+	 * @pre !empty()
+	 * @exception no-throw
+	 */
+	T const & top() const { return _heap[0]; }
+
+	/**
+	 * Inserts 'val'. O(log_D n)
+	 * @exception might throw if not enough memory is available or if T's
+	 * assignment or Compare throw. Basic exception safety.
+	 */
+	void push(T const & val)
+	{
+		_heap.push_back(val);
+		detail::sift_up<D>(_heap.data(), size() - 1, Compare(), detail::assign_to<T>{ _heap.data() });
+	}
+
+	/**
+	 * Inserts all elements of [first, last). If the batch is large compared to the
+	 * heap it is cheaper to append everything and rebuild the heap bottom-up in O(n)
+	 * (Floyd's heapify) than to sift up each element in O(log n).
+	 * @exception see push(T const &)
+	 */
+	template <typename It>
+	void push(It first, It last)
+	{
+		std::size_t const n = size();
+		for (; first != last; ++first)
+			_heap.push_back(* first);
+
+		if (size() - n > n / 2)
+			heapify();
+		else
+			for (std::size_t i = n; i < size(); i++)
+				detail::sift_up<D>(_heap.data(), i, Compare(), detail::assign_to<T>{ _heap.data() });
+	}
+
+	/**
+	 * Removes the greatest element. O(D log_D n)
+	 * @pre !empty()
+	 * @exception might throw if T's move assignment or Compare throw.
+	 */
+	void pop()
+	{
+		assert(!empty());
+		detail::pop_top<D>(_heap.data(), size(), Compare());
+		_heap.pop_back();
+	}
+
+private:
+	// Sift down every inner node, starting with the last one
+	void heapify()
+	{
+		if (size() < 2)
+			return;
+
+		for (std::size_t i = (size() - 2) / D + 1; i-- > 0; )
+			detail::sift_down<D>(_heap.data(), size(), i, Compare(), detail::assign_to<T>{ _heap.data() });
+	}
+
+	vector<T> _heap;
+};
+
+
+
+/**
+ * D-ary heap priority queue whose elements can be addressed by handles, so
+ * their priority can be changed (decrease_key, as needed by Dijkstra's or Prim's
+ * algorithm) or they can be removed without popping everything above them.
+ *
+ * push() returns a handle (a small integer) which stays valid until the element
+ * is popped or erased; handles of removed elements are reused.
+ * A position table maps every handle to the element's current index in the heap.
+ */
+template <typename T, typename Compare = std::less<T>, std::size_t D = 4>
+class indexed_priority_queue
+{
+	static_assert(D >= 2, "a heap needs at least 2 children per node");
+
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	// The value is stored in the heap itself, so sifting doesn't need an indirection.
+	struct entry
+	{
+		T value;
+		std::size_t handle;
+	};
+
+	struct less
+	{
+		bool operator()(entry const & a, entry const & b) const { return Compare()(a.value, b.value); }
+	};
+
+	// Moves an entry and records its new position.
+	struct place
+	{
+		entry * heap;
+		std::size_t * pos;
+		void operator()(std::size_t i, entry && x) const
+		{
+			pos[x.handle] = i;
+			heap[i] = std::move(x);
+		}
+	};
+
+public:
+	using handle = std::size_t;
+
+	/**
+	 * @return Number of elements
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _heap.size(); }
+	bool empty() const { return _heap.empty(); }
+
+	/**
+	 * @return The greatest element and its handle
+	 * @pre !empty()
+	 * @exception no-throw
+	 */
+	T const & top() const { return _heap[0].value; }
+	handle top_handle() const { return _heap[0].handle; }
+
+	/**
+	 * @return true if 'h' refers to an element in the queue
+	 * @exception no-throw
+	 */
+	bool contains(handle h) const { return h < _pos.size() && _pos[h] != npos; }
+
+	/**
+	 * @return The element with handle 'h'
+	 * @pre contains(h)
+	 * @exception no-throw
+	 */
+	T const & operator[](handle h) const
+	{
+		assert(contains(h));
+		return _heap[_pos[h]].value;
+	}
+
+	/**
+	 * Inserts 'val'. O(log_D n)
+	 * @return Handle to the new element
+	 * @exception might throw if not enough memory is available or if T's
+	 * assignment or Compare throw. Basic exception safety.
+	 */
+	handle push(T const & val)
+	{
+		handle h;
+		if (_free.empty())
+		{
+			h = _pos.size();
+			_pos.push_back(npos);
+		}
+		else
+		{
+			h = _free[_free.size() - 1];
+			_free.pop_back();
+		}
+
+		_heap.push_back(entry{ val, h });
+		_pos[h] = size() - 1;
+		detail::sift_up<D>(_heap.data(), size() - 1, less(), place_fn());
+		return h;
+	}
+
+	/**
+	 * Removes the greatest element.
+	 * @pre !empty()
+	 */
+	void pop() { erase(top_handle()); }
+
+	/**
+	 * Gives element 'h' a new value and moves it up or down accordingly. O(D log_D n)
+	 * @pre contains(h)
+	 */
+	void update(handle h, T const & val)
+	{
+		assert(contains(h));
+		std::size_t const i = _pos[h];
+		bool const up = Compare()(_heap[i].value, val);
+		_heap[i].value = val;
+
+		if (up)
+			detail::sift_up<D>(_heap.data(), i, less(), place_fn());
+		else
+			detail::sift_down<D>(_heap.data(), size(), i, less(), place_fn());
+	}
+
+	/**
+	 * Moves element 'h' towards the top by giving it a value that is not less than
+	 * its current one (for a min-queue, Compare = std::greater<>, this literally
+	 * decreases the key). Only sifts up: O(log_D n), no child comparisons.
+	 * @pre contains(h) and !Compare()(val, (*this)[h])
+	 */
+	void decrease_key(handle h, T const & val)
+	{
+		assert(contains(h));
+		assert(!Compare()(val, (* this)[h]));
+		std::size_t const i = _pos[h];
+		_heap[i].value = val;
+		detail::sift_up<D>(_heap.data(), i, less(), place_fn());
+	}
+
+	/**
+	 * Removes element 'h', its handle becomes available for reuse.
+	 * @pre contains(h)
+	 */
+	void erase(handle h)
+	{
+		assert(contains(h));
+		std::size_t const i = _pos[h];
+		_pos[h] = npos;
+		_free.push_back(h);
+
+		std::size_t const last = size() - 1;
+		if (i == last)
+		{
+			_heap.pop_back();
+			return;
+		}
+
+		// Fill the hole with the last element, which might belong above or below it
+		bool const up = less()(_heap[i], _heap[last]);
+		place_fn()(i, std::move(_heap[last]));
+		_heap.pop_back();
+
+		if (up)
+			detail::sift_up<D>(_heap.data(), i, less(), place_fn());
+		else
+			detail::sift_down<D>(_heap.data(), size(), i, less(), place_fn());
+	}
+
+private:
+	place place_fn() { return { _heap.data(), _pos.data() }; }
+
+	vector<entry> _heap;
+	vector<std::size_t> _pos;	// handle -> index in _heap, npos if unused
+	vector<handle> _free;		// unused handles
+};
+} // namespace my
@@ -0,0 +1,278 @@
+#include "mysoa_vector.h"
+#include "myvector.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+
+
+// A typical record: 8 fields, 48 bytes. Most scans only look at one or two of them.
+struct record
+{
+	std::int64_t id = 0;
+	std::int64_t timestamp = 0;
+	double price = 0;
+	double discount = 0;
+	std::int32_t quantity = 0;
+	std::uint32_t flags = 0;
+	float weight = 0;
+	std::int32_t store = 0;
+};
+
+// The same record as columns, in the same order
+using record_columns = my::soa_vector<std::int64_t, std::int64_t, double, double, std::int32_t, std::uint32_t, float, std::int32_t>;
+enum { ID, TIMESTAMP, PRICE, DISCOUNT, QUANTITY, FLAGS, WEIGHT, STORE };
+
+// Assignment throws while 'fail' is set, to test exception safety
+struct fragile
+{
+	static bool fail;
+
+	fragile & operator=(fragile const &)
+	{
+		if (fail)
+			throw std::runtime_error("fragile");
+		return * this;
+	}
+};
+bool fragile::fail = false;
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test soa_vector()
+		soa_vector<int, double> v;
+
+		assert(v.size() == 0);
+		assert(v.capacity() == 0);
+		assert(v.empty());
+	}
+
+	{// Test soa_vector(n)
+		soa_vector<int, double> v(10);
+
+		assert(v.size() == 10);
+		assert(v.capacity() == 10);
+		assert(v.data<0>() != nullptr);
+		assert(v.data<1>() != nullptr);
+	}
+
+	{// Test push_back()/operator[]
+		soa_vector<int, char, double> v;
+
+		for (std::size_t i = 0; i < 100; i++)
+		{
+			v.push_back(std::make_tuple(int(i), char('a' + i % 26), i * 0.5));
+			assert(v.size() == i + 1);
+			assert(v.capacity() >= v.size());
+		}
+		v.push_back(100, 'z', 50.0);
+
+		for (int i = 0; i <= 100; i++)
+		{
+			assert(v[i].get<0>() == i);
+			assert(v[i].get<2>() == i * 0.5);
+			assert(v.data<0>()[i] == i); // columns are contiguous
+		}
+		assert(v[100].get<1>() == 'z');
+	}
+
+	{// Test row proxy: assignment writes through, conversion copies
+		soa_vector<int, double> v(3);
+
+		v[0] = std::make_tuple(1, 1.5);
+		v[1].get<0>() = 2;
+		v[2] = v[0];
+
+		std::tuple<int, double> row = v[0];
+		assert(std::get<0>(row) == 1 && std::get<1>(row) == 1.5);
+		assert(v[1].get<0>() == 2);
+		assert(v[2].get<0>() == 1 && v[2].get<1>() == 1.5);
+
+		soa_vector<int, double> const & c = v;
+		assert(c[2].get<1>() == 1.5);
+		// Compiler error:
+		// c[2].get<1>() = 0;
+	}
+
+	{// Test iteration
+		soa_vector<int, int> v;
+		for (int i = 0; i < 10; i++)
+			v.push_back(i, 2 * i);
+
+		int sum = 0;
+		for (auto row : v)
+			sum += row.get<1>();
+		assert(sum == 90);
+
+		for (auto row : v)
+			row.get<0>() = 0;
+		assert(v[9].get<0>() == 0);
+	}
+
+	{// Test random access iterator operations
+		soa_vector<int, int> v;
+		for (int i = 0; i < 10; i++)
+			v.push_back(i, 2 * i);
+
+		soa_vector<int, int>::iterator it = v.begin();
+		assert((* it++).get<1>() == 0 && (* it).get<1>() == 2);
+		it += 5;
+		assert((* it--).get<1>() == 12 && (* it).get<1>() == 10);
+		it -= 2;
+		assert(it[0].get<1>() == 6 && it[-1].get<1>() == 4);
+		assert((* (it + 2)).get<1>() == 10 && (* (2 + it)).get<1>() == 10 && (* (it - 3)).get<1>() == 0);
+		assert(v.end() - it == 7);
+		assert(it > v.begin() && it >= v.begin() && it <= it && !(it < v.begin()));
+
+		soa_vector<int, int>::const_iterator c = it;
+		assert(c == it + 0 && c[1].get<0>() == 4);
+		soa_vector<int, int>::iterator def; // default constructible
+		def = v.end();
+		assert(def - v.begin() == 10);
+	}
+
+	{// Test push_back() exception safety: a failed assignment leaves the size as it was
+		soa_vector<int, fragile> v;
+		v.push_back(1, fragile());
+
+		fragile::fail = true;
+		bool thrown = false;
+		try
+		{
+			v.push_back(2, fragile());
+		}
+		catch (std::runtime_error const &)
+		{
+			thrown = true;
+		}
+		fragile::fail = false;
+		assert(thrown && v.size() == 1 && v[0].get<0>() == 1);
+	}
+
+	{// Test copy (value semantics)
+		soa_vector<int> a;
+		a.push_back(1);
+
+		soa_vector<int> b(a);
+		b[0].get<0>() = 2;
+		assert(a[0].get<0>() == 1);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 10'000'000; // might need to adjust slightly for your machine
+
+	vector<record> aos;
+	record_columns soa;
+	for (int i = 0; i < ITER; i++)
+	{
+		record r;
+		r.id = i;
+		r.timestamp = 1'600'000'000 + i;
+		r.price = i % 1000 * 0.01;
+		r.discount = 0.1;
+		r.quantity = i % 7;
+		r.flags = i % 3;
+		r.weight = 1.0f;
+		r.store = i % 50;
+
+		aos.push_back(r);
+		soa.push_back(r.id, r.timestamp, r.price, r.discount, r.quantity, r.flags, r.weight, r.store);
+	}
+
+	{// Scan a single column: sum of all prices
+		std::chrono::high_resolution_clock c;
+		double sum_aos = 0, sum_soa = 0;
+
+		auto t1 = c.now();
+		for (std::size_t i = 0; i < aos.size(); i++)
+			sum_aos += aos[i].price;
+		auto t2 = c.now();
+		std::cout << "tSum1 (AoS my::vector<record>): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		double const * price = soa.data<PRICE>();
+		for (std::size_t i = 0; i < soa.size(); i++)
+			sum_soa += price[i];
+		t2 = c.now();
+		std::cout << "tSum1 (SoA soa_vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		std::cout << "(checksum " << sum_aos - sum_soa << ", should be 0)" << std::endl;
+		std::cout << std::endl;
+	}
+
+	{// Scan two columns: revenue = sum of price * quantity
+		std::chrono::high_resolution_clock c;
+		double sum_aos = 0, sum_soa = 0;
+
+		auto t1 = c.now();
+		for (std::size_t i = 0; i < aos.size(); i++)
+			sum_aos += aos[i].price * aos[i].quantity;
+		auto t2 = c.now();
+		std::cout << "tSum2 (AoS my::vector<record>): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		double const * price = soa.data<PRICE>();
+		std::int32_t const * quantity = soa.data<QUANTITY>();
+		for (std::size_t i = 0; i < soa.size(); i++)
+			sum_soa += price[i] * quantity[i];
+		t2 = c.now();
+		std::cout << "tSum2 (SoA soa_vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		std::cout << "(checksum " << sum_aos - sum_soa << ", should be 0)" << std::endl;
+		std::cout << std::endl;
+	}
+
+	{// Update a single column: apply 10% discount to all prices (vectorizable)
+		std::chrono::high_resolution_clock c;
+
+		auto t1 = c.now();
+		for (std::size_t i = 0; i < aos.size(); i++)
+			aos[i].price *= 0.9;
+		auto t2 = c.now();
+		std::cout << "tUpdate1 (AoS my::vector<record>): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		double * price = soa.data<PRICE>();
+		for (std::size_t i = 0; i < soa.size(); i++)
+			price[i] *= 0.9;
+		t2 = c.now();
+		std::cout << "tUpdate1 (SoA soa_vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << std::endl;
+	}
+
+	{// Whole rows: the case where AoS wins
+		std::chrono::high_resolution_clock c;
+		double sum_aos = 0, sum_soa = 0;
+
+		auto t1 = c.now();
+		for (std::size_t i = 0; i < aos.size(); i += 97)
+		{
+			record const & r = aos[i];
+			sum_aos += r.id + r.timestamp + r.price + r.discount + r.quantity + r.flags + r.weight + r.store;
+		}
+		auto t2 = c.now();
+		std::cout << "tRows (AoS my::vector<record>): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (std::size_t i = 0; i < soa.size(); i += 97)
+		{
+			auto r = soa[i];
+			sum_soa += r.get<ID>() + r.get<TIMESTAMP>() + r.get<PRICE>() + r.get<DISCOUNT>()
+				+ r.get<QUANTITY>() + r.get<FLAGS>() + r.get<WEIGHT>() + r.get<STORE>();
+		}
+		t2 = c.now();
+		std::cout << "tRows (SoA soa_vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		std::cout << "(checksum " << sum_aos - sum_soa << ", should be 0)" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "myarray.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace my {
+/**
+ * Growable list of records stored as a structure of arrays (SoA): instead of one
+ * array of structs { T0, T1, .. } ("array of structs", AoS, e.g. my::vector<Record>),
+ * it keeps one my::array per field (column), all sharing the same size and capacity.
+ *
+ * A loop touching only some fields of every record streams through exactly the columns
+ * it needs, every byte of every loaded cache line is useful and the compiler can vectorize
+ * the loop over data<I>(). Accessing a whole row touches one cache line per column instead.
+ *
+ * Rows are accessed through a proxy reference holding a reference to each field.
+ * @invariant all columns have capacity() elements, size() <= capacity()
+ */
+template <typename... Ts>
+class soa_vector
+{
+	static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+	using indices = std::index_sequence_for<Ts...>;
+
+public:
+	using value_type = std::tuple<Ts...>;
+
+	/**
+	 * Proxy reference to row i: behaves like a struct of references to the row's fields.
+	 */
+	template <bool Const>
+	class row_reference
+	{
+	public:
+		using tuple_type = std::tuple<std::conditional_t<Const, Ts const &, Ts &>...>;
+
+		explicit row_reference(tuple_type refs) : _refs(refs) {}
+
+		/**
+		 * @return Reference to field I of the row
+		 */
+		template <std::size_t I>
+		auto & get() const { return std::get<I>(_refs); }
+
+		/**
+		 * Assigns all fields of the row
+		 */
+		template <bool C = Const, typename = std::enable_if_t<!C>>
+		row_reference const & operator=(value_type const & vals) const
+		{
+			_refs = vals;
+			return * this;
+		}
+		row_reference const & operator=(row_reference const & rhs) const
+		{
+			static_assert(!Const, "can't assign through a const row");
+			_refs = value_type(rhs);
+			return * this;
+		}
+
+		/**
+		 * @return Copy of the row's fields
+		 */
+		operator value_type() const { return _refs; }
+
+	private:
+		mutable tuple_type _refs; // tuple of references: assigning writes through
+	};
+
+	using reference = row_reference<false>;
+	using const_reference = row_reference<true>;
+
+	/**
+	 * Random access iterator yielding row references.
+	 */
+	template <bool Const>
+	class iterator_impl
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::tuple<Ts...>;
+		using difference_type = std::ptrdiff_t;
+		using reference = row_reference<Const>;
+		using pointer = void;
+		using container_type = std::conditional_t<Const, soa_vector const, soa_vector>;
+
+		iterator_impl() = default;
+		iterator_impl(container_type * v, std::size_t i) : _v(v), _i(i) {}
+		// iterator -> const_iterator
+		template <bool C = Const, typename = std::enable_if_t<C>>
+		iterator_impl(iterator_impl<false> const & other) : _v(other._v), _i(other._i) {}
+
+		reference operator*() const { return (* _v)[_i]; }
+		reference operator[](difference_type n) const { return (* _v)[_i + n]; }
+
+		iterator_impl & operator++() { _i++; return * this; }
+		iterator_impl & operator--() { _i--; return * this; }
+		iterator_impl operator++(int) { return iterator_impl(_v, _i++); }
+		iterator_impl operator--(int) { return iterator_impl(_v, _i--); }
+		iterator_impl & operator+=(difference_type n) { _i += n; return * this; }
+		iterator_impl & operator-=(difference_type n) { _i -= n; return * this; }
+		iterator_impl operator+(difference_type n) const { return iterator_impl(_v, _i + n); }
+		iterator_impl operator-(difference_type n) const { return iterator_impl(_v, _i - n); }
+		friend iterator_impl operator+(difference_type n, iterator_impl const & it) { return it + n; }
+		difference_type operator-(iterator_impl const & rhs) const { return difference_type(_i) - difference_type(rhs._i); }
+
+		bool operator==(iterator_impl const & rhs) const { return _i == rhs._i; }
+		bool operator!=(iterator_impl const & rhs) const { return _i != rhs._i; }
+		bool operator<(iterator_impl const & rhs) const { return _i < rhs._i; }
+		bool operator>(iterator_impl const & rhs) const { return _i > rhs._i; }
+		bool operator<=(iterator_impl const & rhs) const { return _i <= rhs._i; }
+		bool operator>=(iterator_impl const & rhs) const { return _i >= rhs._i; }
+
+	private:
+		friend class iterator_impl<true>;
+
+		container_type * _v = nullptr;
+		std::size_t _i = 0;
+	};
+
+	using iterator = iterator_impl<false>;
+	using const_iterator = iterator_impl<true>;
+
+	/**
+	 * Constructor, creates an empty vector.
+	 * @exception no-throw
+	 * @post size() == capacity() == 0
+	 */
+	soa_vector() : _size(0), _capacity(0) {}
+
+	/**
+	 * Constructor, creates a vector with n default-constructed rows.
+	 * @exception might throw if not enough memory is available.
+	 * Provides strong exception safety.
+	 * @post size() == capacity() == n
+	 */
+	explicit soa_vector(std::size_t n) : _columns(array<Ts>(n)...), _size(n), _capacity(n) {}
+
+	/**
+	 * @return Number of rows
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * @return Number of rows that can be stored without growing
+	 * @exception no-throw
+	 */
+	std::size_t capacity() const { return _capacity; }
+
+	/**
+	 * @return Raw pointer to column I, use it to write tight (SIMD) loops over a single field
+	 * @exception no-throw
+	 */
+	template <std::size_t I>
+	auto * data() { return std::get<I>(_columns).data(); }
+	template <std::size_t I>
+	auto const * data() const { return std::get<I>(_columns).data(); }
+
+	/**
+	 * @return Proxy reference to row i
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	reference operator[](std::size_t i)
+	{
+		assert(i < size());
+		return row(i, indices());
+	}
+	const_reference operator[](std::size_t i) const
+	{
+		assert(i < size());
+		return row(i, indices());
+	}
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, _size); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, _size); }
+
+	/**
+	 * Appends a row, grows all columns if necessary.
+	 * @exception might throw if not enough memory is available or if an assignment throws.
+	 * Provides strong exception safety (the capacity might have grown, though).
+	 * @post size() grows by 1
+	 */
+	void push_back(value_type const & vals)
+	{
+		if (_size == _capacity)
+			reserve(_capacity + _capacity / 2 + 1); // 1.5x but at least 1
+
+		row(_size, indices()) = vals; // the spare row, size() only grows if this didn't throw
+		_size++;
+	}
+	void push_back(Ts const &... fields) { push_back(value_type(fields...)); }
+
+	/**
+	 * Removes the last row.
+	 * @pre size() > 0
+	 * @exception no-throw
+	 */
+	void pop_back()
+	{
+		assert(_size > 0);
+		_size--;
+	}
+
+	/**
+	 * Removes all rows, keeps the capacity.
+	 * @exception no-throw
+	 */
+	void clear() { _size = 0; }
+
+	/**
+	 * Grows all columns to a capacity of at least n rows, moving the existing rows.
+	 * Allocates all new columns before touching the old ones.
+	 * @exception might throw if not enough memory is available (strong exception safety)
+	 * or if a move assignment throws (basic exception safety).
+	 * @post capacity() >= n
+	 */
+	void reserve(std::size_t n)
+	{
+		if (n <= _capacity)
+			return;
+
+		std::tuple<array<Ts>...> tmp{ array<Ts>(n)... };
+		move_columns(tmp, indices());
+		_columns.swap(tmp);
+		_capacity = n;
+	}
+
+private:
+	template <std::size_t... Is>
+	reference row(std::size_t i, std::index_sequence<Is...>)
+	{
+		return reference(typename reference::tuple_type(std::get<Is>(_columns)[i]...));
+	}
+	template <std::size_t... Is>
+	const_reference row(std::size_t i, std::index_sequence<Is...>) const
+	{
+		return const_reference(typename const_reference::tuple_type(std::get<Is>(_columns)[i]...));
+	}
+
+	template <std::size_t... Is>
+	void move_columns(std::tuple<array<Ts>...> & to, std::index_sequence<Is...>)
+	{
+		// Expands to one std::move per column
+		(std::move(std::get<Is>(_columns).data(), std::get<Is>(_columns).data() + _size, std::get<Is>(to).data()), ...);
+	}
+
+	std::tuple<array<Ts>...> _columns;
+	std::size_t _size;
+	std::size_t _capacity;
+};
+} // namespace my
@@ -0,0 +1,242 @@
+#include "myarray.h"
+#include "mymdspan.h"
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+
+
+using matrix = my::mdspan<float, my::dextents<2>>;
+using tiled_matrix = my::mdspan<float, my::dextents<2>, my::layout_blocked<32>>;
+using grid = my::mdspan<float, my::dextents<3>>;
+
+// 7-point stencil (3D Jacobi step) at interior point (z, y, x)
+inline float stencil(my::mdspan<float const, my::dextents<3>> in, std::size_t z, std::size_t y, std::size_t x)
+{
+	return (in(z, y, x) + in(z - 1, y, x) + in(z + 1, y, x) + in(z, y - 1, x) + in(z, y + 1, x)
+		+ in(z, y, x - 1) + in(z, y, x + 1)) * (1.0f / 7);
+}
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test extents
+		extents<3, dynamic_extent, 4> e(5);
+		static_assert(decltype(e)::rank() == 3, "");
+		static_assert(decltype(e)::rank_dynamic() == 1, "");
+		static_assert(decltype(e)::static_extent(0) == 3, "");
+
+		assert(e.extent(0) == 3 && e.extent(1) == 5 && e.extent(2) == 4);
+		assert(e.size() == 60);
+
+		constexpr extents<2, 8> s;
+		static_assert(s.size() == 16, "static extents are compile-time constants");
+
+		dextents<2> d(std::array<std::size_t, 2>{ 2, 7 });
+		assert(d.extent(0) == 2 && d.extent(1) == 7);
+	}
+
+	{// Test layout_right/layout_left
+		layout_right::mapping<dextents<3>> r(dextents<3>(2, 3, 4));
+		assert(r(0, 0, 1) == 1);
+		assert(r(0, 1, 0) == 4);
+		assert(r(1, 0, 0) == 12);
+		assert(r(1, 2, 3) == 23);
+		assert(r.stride(0) == 12 && r.stride(1) == 4 && r.stride(2) == 1);
+		assert(r.required_span_size() == 24);
+
+		layout_left::mapping<dextents<3>> l(dextents<3>(2, 3, 4));
+		assert(l(1, 0, 0) == 1);
+		assert(l(0, 1, 0) == 2);
+		assert(l(0, 0, 1) == 6);
+		assert(l(1, 2, 3) == 23);
+		assert(l.stride(0) == 1 && l.stride(1) == 2 && l.stride(2) == 6);
+	}
+
+	{// Test mdspan over my::array
+		array<float> a(12);
+		mdspan<float, dextents<2>> m(a.data(), 3, 4);
+
+		assert(m.rank() == 2);
+		assert(m.extent(0) == 3 && m.extent(1) == 4);
+		assert(m.size() == 12);
+
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 4; j++)
+				m(i, j) = float(10 * i + j);
+		assert(a[0] == 0 && a[1] == 1 && a[4] == 10 && a[11] == 23); // row-major
+
+		mdspan<float, extents<4, 3>, layout_left> t(a.data()); // same memory, viewed as 4 x 3 column-major
+		assert(t(1, 0) == 1 && t(0, 1) == 10 && t(3, 2) == 23);
+
+		mdspan<float const, dextents<2>> c = m;
+		assert(c(2, 3) == 23);
+		// Compiler error:
+		// c(2, 3) = 0;
+	}
+
+	{// Test submdspan() (zero-copy)
+		array<float> a(20);
+		mdspan<float, dextents<2>> m(a.data(), 4, 5);
+		for (std::size_t i = 0; i < 4; i++)
+			for (std::size_t j = 0; j < 5; j++)
+				m(i, j) = float(10 * i + j);
+
+		auto s = submdspan(m, { 1, 2 }, { 2, 3 }); // rows 1-2, columns 2-4
+		assert(s.extent(0) == 2 && s.extent(1) == 3);
+		assert(s(0, 0) == 12 && s(1, 2) == 24);
+		assert(s.data() == a.data() + 7);
+		assert(s.mapping().required_span_size() == 8);
+
+		s(1, 1) = -1;
+		assert(m(2, 3) == -1); // writes through
+
+		auto ss = submdspan(s, { 1, 1 }, { 1, 2 });
+		assert(ss(0, 0) == -1 && ss(0, 1) == 24);
+
+		mdspan<float, dextents<2>, layout_left> l(a.data(), 4, 5);
+		auto sl = submdspan(l, { 1, 1 }, { 2, 2 });
+		assert(&sl(1, 0) == &l(2, 1));
+	}
+
+	{// Test layout_blocked
+		array<float> a(24);
+		layout_blocked<2>::mapping<dextents<2>> b(dextents<2>(3, 5));
+		assert(b.required_span_size() == 24); // padded to 4 x 6
+
+		// tile (0, 0) is elements 0..3, tile (0, 1) is 4..7, ..
+		assert(b(0, 0) == 0 && b(0, 1) == 1 && b(1, 0) == 2 && b(1, 1) == 3);
+		assert(b(0, 2) == 4);
+		assert(b(2, 0) == 12);
+
+		// every element gets its own slot
+		mdspan<float, dextents<2>, layout_blocked<2>> m(a.data(), b);
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 5; j++)
+				m(i, j) = float(10 * i + j);
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 5; j++)
+				assert(m(i, j) == 10 * i + j);
+	}
+
+	{// Test for_each_tile()/for_each_blocked() visit every index once
+		array<int> visits(7 * 10);
+		for (std::size_t i = 0; i < visits.size(); i++)
+			visits[i] = 0;
+		mdspan<int, dextents<2>> v(visits.data(), 7, 10);
+
+		int tiles = 0;
+		for_each_tile(7, 10, 4, [&](std::size_t i0, std::size_t j0, std::size_t i1, std::size_t j1)
+		{
+			assert(i1 - i0 <= 4 && j1 - j0 <= 4);
+			tiles++;
+		});
+		assert(tiles == 2 * 3);
+
+		for_each_blocked(7, 10, 4, [&](std::size_t i, std::size_t j) { v(i, j)++; });
+		for (std::size_t i = 0; i < visits.size(); i++)
+			assert(visits[i] == 1);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	std::size_t const N = 4096; // matrix size, might need to adjust slightly for your machine
+	std::size_t const TILE = 32;
+	std::size_t const G = 256; // grid size of the stencil
+
+	{// Transpose an N x N matrix
+		array<float> a(N * N), b(N * N);
+		matrix src(a.data(), N, N), dst(b.data(), N, N);
+		for (std::size_t i = 0; i < N; i++)
+			for (std::size_t j = 0; j < N; j++)
+				src(i, j) = float(i * N + j);
+
+		std::chrono::high_resolution_clock c;
+		float checksum = 0;
+
+		auto t1 = c.now();
+		for (std::size_t i = 0; i < N; i++)
+			for (std::size_t j = 0; j < N; j++)
+				dst(j, i) = src(i, j); // every write touches a new cache line
+		auto t2 = c.now();
+		std::cout << "tTranspose (row-major, naive): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		checksum += dst(N - 1, 0);
+
+		t1 = c.now();
+		for_each_blocked(N, N, TILE, [&](std::size_t i, std::size_t j) { dst(j, i) = src(i, j); });
+		t2 = c.now();
+		std::cout << "tTranspose (row-major, for_each_blocked): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		checksum += dst(N - 1, 0);
+
+		tiled_matrix tsrc(a.data(), N, N), tdst(b.data(), N, N);
+		for (std::size_t i = 0; i < N; i++)
+			for (std::size_t j = 0; j < N; j++)
+				tsrc(i, j) = float(i * N + j);
+
+		t1 = c.now();
+		for_each_blocked(N, N, TILE, [&](std::size_t i, std::size_t j) { tdst(j, i) = tsrc(i, j); });
+		t2 = c.now();
+		std::cout << "tTranspose (layout_blocked, for_each_blocked): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		checksum += tdst(N - 1, 0);
+
+		std::cout << "(checksum " << checksum << ")" << std::endl << std::endl;
+	}
+
+	{// 7-point stencil on a G x G x G grid, sweeping z for every (y, x) tile
+		array<float> a(G * G * G), b(G * G * G);
+		grid in(a.data(), G, G, G), out(b.data(), G, G, G);
+		for (std::size_t i = 0; i < a.size(); i++)
+		{
+			a[i] = float(i % 7);
+			b[i] = 0;
+		}
+
+		std::chrono::high_resolution_clock c;
+		float checksum = 0;
+
+		// Hand-written index math, as found all over our code
+		auto t1 = c.now();
+		std::ptrdiff_t const row = G, plane = G * G;
+		for (std::size_t z = 1; z < G - 1; z++)
+			for (std::size_t y = 1; y < G - 1; y++)
+				for (std::size_t x = 1; x < G - 1; x++)
+				{
+					float const * p = a.data() + (z * G + y) * G + x;
+					b[(z * G + y) * G + x] = (p[0] + p[-plane] + p[plane] + p[-row] + p[row] + p[-1] + p[1]) * (1.0f / 7);
+				}
+		auto t2 = c.now();
+		std::cout << "tStencil (naive index math): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		checksum += b[(G / 2 * G + G / 2) * G + G / 2];
+
+		t1 = c.now();
+		for (std::size_t z = 1; z < G - 1; z++)
+			for (std::size_t y = 1; y < G - 1; y++)
+				for (std::size_t x = 1; x < G - 1; x++)
+					out(z, y, x) = stencil(in, z, y, x);
+		t2 = c.now();
+		std::cout << "tStencil (mdspan, row-major order): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		checksum += out(G / 2, G / 2, G / 2);
+
+		t1 = c.now();
+		for_each_tile(G - 2, G - 2, TILE, [&](std::size_t y0, std::size_t x0, std::size_t y1, std::size_t x1)
+		{
+			// 3 planes of a tile (3 * 32 * 32 floats) fit into L1 while we sweep along z
+			for (std::size_t z = 1; z < G - 1; z++)
+				for (std::size_t y = y0 + 1; y < y1 + 1; y++)
+					for (std::size_t x = x0 + 1; x < x1 + 1; x++)
+						out(z, y, x) = stencil(in, z, y, x);
+		});
+		t2 = c.now();
+		std::cout << "tStencil (mdspan, for_each_tile): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		checksum += out(G / 2, G / 2, G / 2);
+
+		std::cout << "(checksum " << checksum << ")" << std::endl;
+	}
+
+	return 0;
+}
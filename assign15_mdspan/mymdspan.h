@@ -0,0 +1,457 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace my {
+std::size_t constexpr dynamic_extent = static_cast<std::size_t>(-1);
+
+/**
+ * Sizes of a multidimensional index space. Each extent is either fixed at compile time
+ * or dynamic_extent, in which case it is passed to the constructor at run time.
+ * Static extents allow the compiler to turn index computations into shifts and constants.
+ * Example: extents<dynamic_extent, 3> is an n x 3 index space.
+ */
+template <std::size_t... Es>
+class extents
+{
+	static_assert(sizeof...(Es) > 0, "extents need at least one dimension");
+
+public:
+	static constexpr std::size_t rank() { return sizeof...(Es); }
+	static constexpr std::size_t rank_dynamic() { return ((Es == dynamic_extent) + ...); }
+
+	/**
+	 * @return Extent r if known at compile time, otherwise dynamic_extent
+	 */
+	static constexpr std::size_t static_extent(std::size_t r)
+	{
+		constexpr std::size_t e[] = { Es... };
+		return e[r];
+	}
+
+	/**
+	 * Constructor, all dynamic extents are 0.
+	 * @exception no-throw
+	 */
+	constexpr extents() : _e{}
+	{
+		for (std::size_t r = 0; r < rank(); r++)
+			_e[r] = static_extent(r) == dynamic_extent ? 0 : static_extent(r);
+	}
+
+	/**
+	 * Constructor, takes the dynamic extents only (in order).
+	 * @exception no-throw
+	 */
+	template <typename... Is, typename = std::enable_if_t<sizeof...(Is) != 0 && sizeof...(Is) == rank_dynamic() && (std::is_integral<Is>::value && ...)>>
+	constexpr explicit extents(Is... dynamic) : _e{}
+	{
+		std::size_t const d[] = { static_cast<std::size_t>(dynamic)... };
+		for (std::size_t r = 0, i = 0; r < rank(); r++)
+			_e[r] = static_extent(r) == dynamic_extent ? d[i++] : static_extent(r);
+	}
+
+	/**
+	 * Constructor, takes all extents.
+	 * @pre e[r] == static_extent(r) for all static extents
+	 * @exception no-throw
+	 */
+	constexpr explicit extents(std::array<std::size_t, rank()> const & e) : _e(e)
+	{
+		for (std::size_t r = 0; r < rank(); r++)
+			assert(static_extent(r) == dynamic_extent || static_extent(r) == e[r]);
+	}
+
+	/**
+	 * @return Extent of dimension r
+	 * @exception no-throw
+	 */
+	constexpr std::size_t extent(std::size_t r) const
+	{
+		return static_extent(r) == dynamic_extent ? _e[r] : static_extent(r);
+	}
+
+	/**
+	 * @return Number of elements of the index space (product of all extents)
+	 * @exception no-throw
+	 */
+	constexpr std::size_t size() const
+	{
+		std::size_t n = 1;
+		for (std::size_t r = 0; r < rank(); r++)
+			n *= extent(r);
+		return n;
+	}
+
+private:
+	std::array<std::size_t, rank()> _e;
+};
+
+namespace detail {
+template <std::size_t>
+std::size_t constexpr always_dynamic = dynamic_extent;
+
+template <typename Seq>
+struct make_dextents;
+
+template <std::size_t... Is>
+struct make_dextents<std::index_sequence<Is...>>
+{
+	using type = extents<always_dynamic<Is>...>;
+};
+} // namespace detail
+
+/**
+ * Extents of rank R which are all dynamic.
+ */
+template <std::size_t R>
+using dextents = typename detail::make_dextents<std::make_index_sequence<R>>::type;
+
+
+
+/**
+ * Layout policies map a multidimensional index to an offset into a flat buffer.
+ * Each one provides a nested mapping<Extents> with:
+ * - operator()(i0, i1, ..): offset of element (i0, i1, ..)
+ * - required_span_size(): number of elements the buffer must hold
+ * - stride(r) (strided layouts only): offset difference between neighbours in dimension r
+ */
+
+/**
+ * Row-major (C) layout: the last index is contiguous.
+ */
+struct layout_right
+{
+	template <typename Extents>
+	class mapping
+	{
+	public:
+		using extents_type = Extents;
+
+		mapping() = default;
+		explicit mapping(Extents const & e) : _e(e) {}
+
+		Extents const & extents() const { return _e; }
+
+		template <typename... Is>
+		std::size_t operator()(Is... idx) const
+		{
+			static_assert(sizeof...(Is) == Extents::rank(), "wrong number of indices");
+			// Horner scheme ((i0 * e1 + i1) * e2 + i2).., the fold unrolls it at compile time
+			std::size_t offset = 0, r = 0;
+			((offset = offset * _e.extent(r++) + static_cast<std::size_t>(idx)), ...);
+			return offset;
+		}
+
+		std::size_t required_span_size() const { return _e.size(); }
+
+		std::size_t stride(std::size_t r) const
+		{
+			std::size_t s = 1;
+			for (std::size_t k = r + 1; k < Extents::rank(); k++)
+				s *= _e.extent(k);
+			return s;
+		}
+
+	private:
+		Extents _e;
+	};
+};
+
+/**
+ * Column-major (Fortran) layout: the first index is contiguous.
+ */
+struct layout_left
+{
+	template <typename Extents>
+	class mapping
+	{
+	public:
+		using extents_type = Extents;
+
+		mapping() = default;
+		explicit mapping(Extents const & e) : _e(e) {}
+
+		Extents const & extents() const { return _e; }
+
+		template <typename... Is>
+		std::size_t operator()(Is... idx) const
+		{
+			static_assert(sizeof...(Is) == Extents::rank(), "wrong number of indices");
+			std::size_t offset = 0, stride = 1, r = 0;
+			((offset += static_cast<std::size_t>(idx) * stride, stride *= _e.extent(r++)), ...);
+			return offset;
+		}
+
+		std::size_t required_span_size() const { return _e.size(); }
+
+		std::size_t stride(std::size_t r) const
+		{
+			std::size_t s = 1;
+			for (std::size_t k = 0; k < r; k++)
+				s *= _e.extent(k);
+			return s;
+		}
+
+	private:
+		Extents _e;
+	};
+};
+
+/**
+ * Arbitrary strides per dimension. This is the layout of sub-views (see submdspan())
+ * of row- or column-major data: same strides as the parent, smaller extents.
+ */
+struct layout_stride
+{
+	template <typename Extents>
+	class mapping
+	{
+	public:
+		using extents_type = Extents;
+		using strides_type = std::array<std::size_t, Extents::rank()>;
+
+		mapping() = default;
+		mapping(Extents const & e, strides_type const & strides) : _e(e), _strides(strides) {}
+
+		Extents const & extents() const { return _e; }
+
+		template <typename... Is>
+		std::size_t operator()(Is... idx) const
+		{
+			static_assert(sizeof...(Is) == Extents::rank(), "wrong number of indices");
+			std::size_t offset = 0, r = 0;
+			((offset += static_cast<std::size_t>(idx) * _strides[r++]), ...);
+			return offset;
+		}
+
+		std::size_t required_span_size() const
+		{
+			std::size_t last = 0;
+			for (std::size_t r = 0; r < Extents::rank(); r++)
+			{
+				if (_e.extent(r) == 0)
+					return 0;
+				last += (_e.extent(r) - 1) * _strides[r];
+			}
+			return last + 1;
+		}
+
+		std::size_t stride(std::size_t r) const { return _strides[r]; }
+
+	private:
+		Extents _e;
+		strides_type _strides;
+	};
+};
+
+/**
+ * Tiled (blocked) 2D layout: the matrix is cut into B x B tiles which are stored
+ * one after the other in row-major order, each tile itself row-major.
+ * Every tile is contiguous (B = 32 floats: 4KB, one page), so an algorithm that
+ * works tile by tile touches few cache lines and pages no matter in which direction
+ * it walks through the tile -- e.g. the column reads of a transpose.
+ * Extents are padded to multiples of B, the layout is not strided.
+ * @tparam B tile size, power of 2
+ */
+template <std::size_t B>
+struct layout_blocked
+{
+	static_assert(B > 0 && (B & (B - 1)) == 0, "tile size must be a power of 2");
+
+	template <typename Extents>
+	class mapping
+	{
+		static_assert(Extents::rank() == 2, "layout_blocked is 2D only");
+
+	public:
+		using extents_type = Extents;
+
+		mapping() = default;
+		explicit mapping(Extents const & e) : _e(e), _tiles_per_row((e.extent(1) + B - 1) / B) {}
+
+		Extents const & extents() const { return _e; }
+
+		std::size_t operator()(std::size_t i, std::size_t j) const
+		{
+			return ((i / B) * _tiles_per_row + j / B) * (B * B) + (i % B) * B + j % B;
+		}
+
+		std::size_t required_span_size() const
+		{
+			return (_e.extent(0) + B - 1) / B * _tiles_per_row * (B * B);
+		}
+
+	private:
+		Extents _e;
+		std::size_t _tiles_per_row = 0;
+	};
+};
+
+
+
+/**
+ * Non-owning multidimensional view of a flat buffer (simplified version of C++23's
+ * std::mdspan). Replaces hand-written index math like 'data[(z * ny + y) * nx + x]'
+ * with 'm(z, y, x)', the layout policy decides how indices map to memory.
+ *
+ * Copying an mdspan copies the view, not the data (like a pointer).
+ * mdspan<T const, ..> provides read-only access, mdspan<T, ..> converts to it implicitly.
+ * @pre the buffer holds at least mapping().required_span_size() elements
+ */
+template <typename T, typename Extents, typename Layout = layout_right>
+class mdspan
+{
+public:
+	using element_type = T;
+	using extents_type = Extents;
+	using layout_type = Layout;
+	using mapping_type = typename Layout::template mapping<Extents>;
+
+	/**
+	 * Constructor, creates an empty view.
+	 * @exception no-throw
+	 */
+	mdspan() : _data(nullptr) {}
+
+	/**
+	 * Constructor, views 'data' with the given dynamic extents.
+	 * Example: mdspan<float, dextents<2>> m(a.data(), rows, cols);
+	 * @exception no-throw
+	 */
+	template <typename... Is, typename = std::enable_if_t<(std::is_integral<Is>::value && ...)>>
+	explicit mdspan(T * data, Is... dynamic_extents) : _data(data), _map(Extents(dynamic_extents...)) {}
+
+	/**
+	 * Constructor, views 'data' through the given mapping.
+	 * @exception no-throw
+	 */
+	mdspan(T * data, mapping_type const & m) : _data(data), _map(m) {}
+
+	/**
+	 * Converting constructor, mdspan<T> to mdspan<T const>.
+	 * @exception no-throw
+	 */
+	template <typename U, typename = std::enable_if_t<std::is_same<T, U const>::value && !std::is_same<T, U>::value>>
+	mdspan(mdspan<U, Extents, Layout> const & rhs) : _data(rhs.data()), _map(rhs.mapping()) {}
+
+	static constexpr std::size_t rank() { return Extents::rank(); }
+
+	/**
+	 * @return Extent of dimension r
+	 * @exception no-throw
+	 */
+	std::size_t extent(std::size_t r) const { return _map.extents().extent(r); }
+
+	/**
+	 * @return Number of elements in the view
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _map.extents().size(); }
+
+	/**
+	 * @return Distance between neighbouring elements in dimension r (strided layouts only)
+	 * @exception no-throw
+	 */
+	std::size_t stride(std::size_t r) const { return _map.stride(r); }
+
+	T * data() const { return _data; }
+	mapping_type const & mapping() const { return _map; }
+	Extents const & extents() const { return _map.extents(); }
+
+	/**
+	 * @return Element (i0, i1, ..)
+	 * @pre i_r < extent(r) for all r
+	 * @exception no-throw
+	 */
+	template <typename... Is>
+	T & operator()(Is... idx) const
+	{
+		assert(in_bounds({ static_cast<std::size_t>(idx)... }));
+		return _data[_map(idx...)];
+	}
+
+private:
+	bool in_bounds(std::array<std::size_t, rank()> const & idx) const
+	{
+		for (std::size_t r = 0; r < rank(); r++)
+			if (idx[r] >= extent(r))
+				return false;
+		return true;
+	}
+
+	T * _data;
+	mapping_type _map;
+};
+
+namespace detail {
+template <typename T, typename E, typename L, std::size_t... Is>
+std::size_t offset_of(mdspan<T, E, L> const & m, std::array<std::size_t, E::rank()> const & idx, std::index_sequence<Is...>)
+{
+	return m.mapping()(idx[Is]...);
+}
+} // namespace detail
+
+/**
+ * Zero-copy sub-view of 'm': the block starting at index 'first' with 'count'
+ * elements in every dimension. Works for all strided layouts, the result shares
+ * the parent's strides (e.g. a rectangle cut out of a row-major matrix).
+ * @pre first[r] + count[r] <= m.extent(r) for all r
+ * @exception no-throw
+ */
+template <typename T, typename E, typename L>
+mdspan<T, dextents<E::rank()>, layout_stride> submdspan(
+	mdspan<T, E, L> const & m,
+	std::array<std::size_t, E::rank()> const & first,
+	std::array<std::size_t, E::rank()> const & count)
+{
+	std::array<std::size_t, E::rank()> strides;
+	for (std::size_t r = 0; r < E::rank(); r++)
+	{
+		assert(first[r] + count[r] <= m.extent(r));
+		strides[r] = m.stride(r);
+	}
+
+	T * origin = m.data() + detail::offset_of(m, first, std::make_index_sequence<E::rank()>());
+	return { origin, layout_stride::mapping<dextents<E::rank()>>(dextents<E::rank()>(count), strides) };
+}
+
+
+
+/**
+ * Cache-blocked iteration over a rows x cols index space: calls f(row0, col0, row1, col1)
+ * for every tile [row0, row1) x [col0, col1) of at most tile x tile elements, tiles in
+ * row-major order. Algorithms that read along one axis and write along the other
+ * (transpose, stencils) then work on a small window that stays in cache.
+ * @exception whatever f throws
+ */
+template <typename F>
+void for_each_tile(std::size_t rows, std::size_t cols, std::size_t tile, F && f)
+{
+	assert(tile > 0);
+	for (std::size_t i = 0; i < rows; i += tile)
+		for (std::size_t j = 0; j < cols; j += tile)
+			f(i, j, i + tile < rows ? i + tile : rows, j + tile < cols ? j + tile : cols);
+}
+
+/**
+ * Calls f(i, j) for every index of the rows x cols index space, tile by tile.
+ * @exception whatever f throws
+ */
+template <typename F>
+void for_each_blocked(std::size_t rows, std::size_t cols, std::size_t tile, F && f)
+{
+	for_each_tile(rows, cols, tile, [&f](std::size_t i0, std::size_t j0, std::size_t i1, std::size_t j1)
+	{
+		for (std::size_t i = i0; i < i1; i++)
+			for (std::size_t j = j0; j < j1; j++)
+				f(i, j);
+	});
+}
+} // namespace my
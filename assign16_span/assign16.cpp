@@ -0,0 +1,177 @@
+#include "myarray.h"
+#include "myspan.h"
+#include "myvector.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+
+// The same kernel three times: taking a copy, a pointer + size, and a view.
+int sum_copy(my::array<int> block)
+{
+	int sum = 0;
+	for (std::size_t i = 0; i < block.size(); i++)
+		sum += block[i];
+	return sum;
+}
+
+int sum_raw(int const * block, std::size_t n)
+{
+	int sum = 0;
+	for (std::size_t i = 0; i < n; i++)
+		sum += block[i];
+	return sum;
+}
+
+int sum_span(my::span<int const> block)
+{
+	int sum = 0;
+	for (int x : block)
+		sum += x;
+	return sum;
+}
+
+void fill(my::span<int> s, int value)
+{
+	for (int & x : s)
+		x = value;
+}
+
+int total(my::span<int const> s)
+{
+	int sum = 0;
+	for (int x : s)
+		sum += x;
+	return sum;
+}
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test span()
+		span<int> s;
+
+		assert(s.size() == 0);
+		assert(s.empty());
+		assert(s.data() == nullptr);
+		assert(s.begin() == s.end());
+	}
+
+	{// Test span(pointer, size)/span(first, last)/span(C array)
+		int raw[] = { 1, 2, 3, 4 };
+
+		span<int> a(raw, 4);
+		span<int> b(raw + 1, raw + 3);
+		span<int> c = raw;
+
+		assert(a.size() == 4 && a.data() == raw);
+		assert(b.size() == 2 && b[0] == 2 && b[1] == 3);
+		assert(c.size() == 4 && c.size_bytes() == 16);
+		assert(c.front() == 1 && c.back() == 4);
+	}
+
+	{// Test implicit conversion from my::array/my::vector (no copy)
+		array<int> a(10);
+		vector<int> v;
+		for (int i = 0; i < 10; i++)
+		{
+			a[i] = i;
+			v.push_back(i);
+		}
+
+		fill(a, 1);
+		fill(v, 2);
+		assert(total(a) == 10);
+		assert(total(v) == 20);
+
+		span<int> s = a;
+		assert(s.data() == a.data() && s.size() == a.size());
+		s[3] = 42;
+		assert(a[3] == 42); // writes through
+	}
+
+	{// Test const-correctness
+		array<int> a(4);
+		array<int> const & c = a;
+
+		span<int const> sc = c;			// const container -> span<T const>
+		span<int const> sm = span<int>(a);	// span<T> -> span<T const>
+		assert(sc.data() == sm.data());
+
+		static_assert(std::is_convertible<array<int> &, span<int>>::value, "");
+		static_assert(std::is_convertible<array<int> &, span<int const>>::value, "");
+		static_assert(!std::is_convertible<array<int> const &, span<int>>::value, "can't modify a const array through a span");
+		static_assert(!std::is_convertible<span<int const>, span<int>>::value, "can't drop const");
+		static_assert(!std::is_convertible<array<int> &&, span<int>>::value, "span of a temporary would dangle");
+		static_assert(!std::is_convertible<array<long> &, span<int>>::value, "element types must match");
+	}
+
+	{// Test first()/last()/subspan()
+		int raw[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+		span<int> s = raw;
+
+		assert(s.first(3).size() == 3 && s.first(3).back() == 2);
+		assert(s.last(2).size() == 2 && s.last(2).front() == 6);
+		assert(s.first(0).empty() && s.last(0).empty());
+
+		span<int> mid = s.subspan(2, 4);
+		assert(mid.size() == 4 && mid.front() == 2 && mid.back() == 5);
+		assert(s.subspan(5).size() == 3);
+		assert(s.subspan(8).empty());
+
+		// views of views still point into the original data
+		assert(&mid.subspan(1).last(1)[0] == &raw[5]);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 100'000; // might need to adjust slightly for your machine
+	std::size_t const N = 1 << 20;
+	std::size_t const BLOCK = 1024;
+
+	array<int> data(N);
+	for (std::size_t i = 0; i < N; i++)
+		data[i] = i % 3;
+
+	{// Process a large array block by block
+		std::chrono::high_resolution_clock c;
+		long long checksum = 0;
+		int const blocks = ITER;
+
+		auto t1 = c.now();
+		for (int b = 0; b < blocks; b++)
+		{
+			std::size_t const offset = b * BLOCK % N;
+			array<int> block(BLOCK); // the only way to pass "part of an array" before
+			for (std::size_t i = 0; i < BLOCK; i++)
+				block[i] = data[offset + i];
+			checksum += sum_copy(std::move(block));
+		}
+		auto t2 = c.now();
+		std::cout << "tBlocks (copy into my::array): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int b = 0; b < blocks; b++)
+			checksum -= sum_raw(data.data() + b * BLOCK % N, BLOCK);
+		t2 = c.now();
+		std::cout << "tBlocks (pointer + size): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		span<int const> all = data;
+		for (int b = 0; b < blocks; b++)
+			checksum += sum_span(all.subspan(b * BLOCK % N, BLOCK));
+		t2 = c.now();
+		std::cout << "tBlocks (my::span): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		std::cout << "(checksum " << checksum << ")" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace my {
+std::size_t constexpr dynamic_extent = static_cast<std::size_t>(-1);
+
+namespace detail {
+// U[] can be viewed as T[] if only qualifiers are added (int -> int const),
+// this rules out e.g. viewing derived[] as base[] (different element sizes).
+template <typename U, typename T>
+using is_compatible_element = std::is_convertible<U (*)[], T (*)[]>;
+
+// Container exposing a contiguous buffer through data() and size() (my::array, my::vector, ..)
+template <typename C, typename T, typename = void>
+struct is_compatible_container : std::false_type {};
+
+template <typename C, typename T>
+struct is_compatible_container<C, T, std::void_t<
+	decltype(std::declval<C &>().data()),
+	decltype(std::declval<C &>().size())>>
+	: is_compatible_element<std::remove_pointer_t<decltype(std::declval<C &>().data())>, T> {};
+} // namespace detail
+
+/**
+ * Non-owning view of a contiguous sequence of T (simplified version of std::span):
+ * a pointer and a size. Passing a span instead of a container hands out a part
+ * of it without copying a single element.
+ *
+ * A span<T> allows modifying the elements, a span<T const> doesn't. Viewing a const
+ * container yields a span<T const> (because its data() returns T const *), and
+ * span<T> converts to span<T const>, never the other way around.
+ *
+ * A span does not own its elements: it must not outlive the container it views,
+ * and operations invalidating the container's data() (e.g. vector::reserve) invalidate it.
+ */
+template <typename T>
+class span
+{
+public:
+	using element_type = T;
+	using value_type = std::remove_cv_t<T>;
+	using iterator = T *;
+
+	/**
+	 * Constructor, creates an empty view.
+	 * @exception no-throw
+	 * @post size() == 0, data() == nullptr
+	 */
+	span() : _data(nullptr), _size(0) {}
+
+	/**
+	 * Constructor, views [data, data + n).
+	 * @exception no-throw
+	 */
+	span(T * data, std::size_t n) : _data(data), _size(n) {}
+
+	/**
+	 * Constructor, views [first, last).
+	 * @pre first <= last
+	 * @exception no-throw
+	 */
+	span(T * first, T * last) : _data(first), _size(last - first) { assert(first <= last); }
+
+	/**
+	 * Constructor, views a C array.
+	 * @exception no-throw
+	 */
+	template <std::size_t N>
+	span(T (& arr)[N]) : _data(arr), _size(N) {}
+
+	/**
+	 * Implicit conversion from a container with data() and size(), such as my::array or
+	 * my::vector. Only lvalues: a span of a temporary would dangle immediately.
+	 * @exception no-throw
+	 */
+	template <typename C, typename = std::enable_if_t<detail::is_compatible_container<C, T>::value>>
+	span(C & c) : _data(c.data()), _size(c.size()) {}
+
+	/**
+	 * Implicit conversion span<T> -> span<T const>.
+	 * @exception no-throw
+	 */
+	template <typename U, typename = std::enable_if_t<
+		!std::is_same<U, T>::value && detail::is_compatible_element<U, T>::value>>
+	span(span<U> const & rhs) : _data(rhs.data()), _size(rhs.size()) {}
+
+	/**
+	 * @return Number of elements
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	std::size_t size_bytes() const { return _size * sizeof(T); }
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * A span is a view like a pointer: accessing elements is const even if they are mutable.
+	 * @exception no-throw
+	 */
+	T * data() const { return _data; }
+	iterator begin() const { return _data; }
+	iterator end() const { return _data + _size; }
+
+	/**
+	 * @return Element i
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	T & operator[](std::size_t i) const
+	{
+		assert(i < size());
+		return _data[i];
+	}
+
+	T & front() const { return (* this)[0]; }
+	T & back() const { return (* this)[_size - 1]; }
+
+	/**
+	 * @return View of the first/last n elements
+	 * @pre n <= size()
+	 * @exception no-throw
+	 */
+	span first(std::size_t n) const
+	{
+		assert(n <= size());
+		return span(_data, n);
+	}
+	span last(std::size_t n) const
+	{
+		assert(n <= size());
+		return span(_data + (_size - n), n);
+	}
+
+	/**
+	 * @return View of 'count' elements starting at 'offset' (all remaining ones if count == dynamic_extent)
+	 * @pre offset <= size(), offset + count <= size() unless count == dynamic_extent
+	 * @exception no-throw
+	 */
+	span subspan(std::size_t offset, std::size_t count = dynamic_extent) const
+	{
+		assert(offset <= size());
+		if (count == dynamic_extent)
+			count = _size - offset;
+
+		assert(count <= size() - offset);
+		return span(_data + offset, count);
+	}
+
+private:
+	T * _data;
+	std::size_t _size;
+};
+} // namespace my
@@ -0,0 +1,262 @@
+#include "myarray.h"
+#include "mybit_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test bit_vector()
+		bit_vector v;
+
+		assert(v.size() == 0);
+		assert(v.empty());
+		assert(v.count() == 0);
+		assert(v.find_first() == bit_vector::npos);
+	}
+
+	{// Test bit_vector(n, value)
+		bit_vector a(100), b(100, true);
+
+		assert(a.size() == 100 && b.size() == 100);
+		assert(a.count() == 0 && a.none());
+		assert(b.count() == 100 && b.any()); // bits beyond size() don't count
+		assert(a.num_words() == 2);
+	}
+
+	{// Test set()/reset()/flip()/test()
+		bit_vector v(130);
+
+		v.set(0);
+		v.set(64);
+		v.set(129);
+		assert(v[0] && v[64] && v[129] && !v[1]);
+		assert(v.count() == 3);
+
+		v.reset(64);
+		v.flip(1);
+		v.flip(0);
+		v.set(2, true);
+		assert(!v[0] && v[1] && v[2] && !v[64]);
+		assert(v.count() == 3);
+	}
+
+	{// Test set_range()/reset_range()/flip_range() against a single-bit reference
+		std::mt19937 rng(42);
+		bit_vector v(1000);
+		std::vector<bool> ref(1000);
+
+		for (int i = 0; i < 1000; i++)
+		{
+			std::size_t first = rng() % 1001, last = rng() % 1001;
+			if (first > last)
+				std::swap(first, last);
+
+			switch (rng() % 3)
+			{
+			case 0: v.set_range(first, last); for (std::size_t k = first; k < last; k++) ref[k] = true; break;
+			case 1: v.reset_range(first, last); for (std::size_t k = first; k < last; k++) ref[k] = false; break;
+			case 2: v.flip_range(first, last); for (std::size_t k = first; k < last; k++) ref[k] = !ref[k]; break;
+			}
+		}
+
+		for (std::size_t k = 0; k < 1000; k++)
+			assert(v[k] == ref[k]);
+		assert(v.count() == std::size_t(std::count(ref.begin(), ref.end(), true)));
+	}
+
+	{// Test push_back()/resize()
+		bit_vector v;
+		for (int i = 0; i < 200; i++)
+			v.push_back(i % 3 == 0);
+
+		assert(v.size() == 200);
+		assert(v.capacity() >= 200);
+		assert(v.count() == 67);
+
+		v.resize(10);
+		assert(v.count() == 4);
+		v.resize(300); // new bits are 0
+		assert(v.count() == 4);
+		assert(!v[150]);
+	}
+
+	{// Test and/or/xor/and_not/flip()
+		bit_vector a(100), b(100);
+		a.set_range(0, 50);
+		b.set_range(25, 75);
+
+		bit_vector c = a;
+		c &= b;
+		assert(c.count() == 25 && c.find_first() == 25);
+
+		c = a;
+		c |= b;
+		assert(c.count() == 75);
+
+		c = a;
+		c ^= b;
+		assert(c.count() == 50);
+
+		c = a;
+		c.and_not(b);
+		assert(c.count() == 25 && !c[25]);
+
+		c.flip();
+		assert(c.count() == 75);
+		assert(c != a);
+	}
+
+	{// Test find_next()
+		bit_vector v(1000);
+		std::size_t const bits[] = { 3, 64, 65, 500, 999 };
+		for (std::size_t i : bits)
+			v.set(i);
+
+		std::size_t k = 0;
+		for (auto i = v.find_first(); i != bit_vector::npos; i = v.find_next(i + 1))
+			assert(i == bits[k++]);
+		assert(k == 5);
+		assert(v.find_next(66) == 500);
+		assert(v.find_next(1000) == bit_vector::npos);
+	}
+
+	{// Test rank()/select() against a linear scan
+		std::mt19937 rng(7);
+		for (std::size_t n : { std::size_t(0), std::size_t(1), std::size_t(512), std::size_t(100'000) })
+		{
+			bit_vector v(n);
+			for (std::size_t i = 0; i < n; i++)
+				if (rng() % 4 == 0)
+					v.set(i);
+
+			rank_select rs(v);
+			assert(rs.ones() == v.count());
+			assert(rs.rank(n) == v.count());
+
+			std::size_t ones = 0;
+			for (std::size_t i = 0; i < n; i++)
+			{
+				assert(rs.rank(i) == ones);
+				if (v[i])
+					assert(rs.select(ones++) == i);
+			}
+		}
+
+		// a long run of zeros between two samples
+		bit_vector v(1'000'000);
+		v.set_range(0, 5000);
+		v.set_range(999'000, 1'000'000);
+		rank_select rs(v);
+		assert(rs.select(4999) == 4999);
+		assert(rs.select(5000) == 999'000);
+		assert(rs.select(5999) == 999'999);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	std::size_t const N = 200'000'000; // flags, might need to adjust slightly for your machine
+	int const QUERIES = 10'000'000;
+
+	array<bool> flags(N), other_flags(N);
+	bit_vector bits(N), other_bits(N);
+	{
+		std::mt19937 rng(1);
+		for (std::size_t i = 0; i < N; i++)
+		{
+			flags[i] = rng() % 16 == 0;
+			other_flags[i] = rng() % 2 == 0;
+			bits.set(i, flags[i]);
+			other_bits.set(i, other_flags[i]);
+		}
+	}
+
+	std::cout << "Memory (my::array<bool>): " << N * sizeof(bool) / (1024 * 1024) << "MB" << std::endl;
+	std::cout << "Memory (bit_vector): " << bits.memory() / (1024 * 1024) << "MB" << std::endl << std::endl;
+
+	{// Count set flags
+		std::chrono::high_resolution_clock c;
+		std::size_t n1 = 0, n2 = 0;
+
+		auto t1 = c.now();
+		for (std::size_t i = 0; i < N; i++)
+			n1 += flags[i];
+		auto t2 = c.now();
+		std::cout << "tCount (my::array<bool>): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		n2 = bits.count();
+		t2 = c.now();
+		std::cout << "tCount (bit_vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << n1 - n2 << ", should be 0)" << std::endl << std::endl;
+	}
+
+	{// Combine two flag sets
+		std::chrono::high_resolution_clock c;
+
+		auto t1 = c.now();
+		for (std::size_t i = 0; i < N; i++)
+			flags[i] = flags[i] && !other_flags[i];
+		auto t2 = c.now();
+		std::cout << "tAndNot (my::array<bool>): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		bits.and_not(other_bits);
+		t2 = c.now();
+		std::cout << "tAndNot (bit_vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl << std::endl;
+	}
+
+	{// Visit all set flags
+		std::chrono::high_resolution_clock c;
+		std::size_t sum1 = 0, sum2 = 0;
+
+		auto t1 = c.now();
+		for (std::size_t i = 0; i < N; i++)
+			if (flags[i])
+				sum1 += i;
+		auto t2 = c.now();
+		std::cout << "tIterate (my::array<bool>): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (auto i = bits.find_first(); i != bit_vector::npos; i = bits.find_next(i + 1))
+			sum2 += i;
+		t2 = c.now();
+		std::cout << "tIterate (bit_vector::find_next): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << sum1 - sum2 << ", should be 0)" << std::endl << std::endl;
+	}
+
+	{// rank/select queries
+		std::chrono::high_resolution_clock c;
+		std::mt19937 rng(2);
+		std::size_t sum = 0;
+
+		auto t1 = c.now();
+		rank_select rs(bits);
+		auto t2 = c.now();
+		std::cout << "tBuild (rank_select): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, "
+			<< rs.memory() / (1024 * 1024) << "MB" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < QUERIES; i++)
+			sum += rs.rank(rng() % N);
+		t2 = c.now();
+		std::cout << "tRank (rank_select): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < QUERIES; i++)
+			sum += rs.select(rng() % rs.ones());
+		t2 = c.now();
+		std::cout << "tSelect (rank_select): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << sum << ")" << std::endl;
+	}
+
+	return 0;
+}
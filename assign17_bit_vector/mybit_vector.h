@@ -0,0 +1,475 @@
+#pragma once
+
+#include "myarray.h"
+#include "myvector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+
+namespace my {
+namespace detail {
+/**
+ * Hardware bit counting. All compilers we care about map these to single
+ * instructions (popcnt, tzcnt/bsf) when the target supports them.
+ */
+inline std::size_t popcount(std::uint64_t w)
+{
+#ifdef _MSC_VER
+	return static_cast<std::size_t>(__popcnt64(w));
+#else
+	return static_cast<std::size_t>(__builtin_popcountll(w));
+#endif
+}
+
+/**
+ * @return Index of the lowest set bit
+ * @pre w != 0
+ */
+inline std::size_t countr_zero(std::uint64_t w)
+{
+	assert(w != 0);
+#ifdef _MSC_VER
+	unsigned long i;
+	_BitScanForward64(& i, w);
+	return i;
+#else
+	return static_cast<std::size_t>(__builtin_ctzll(w));
+#endif
+}
+
+/**
+ * @return Index of the k-th (0-based) set bit of w
+ * @pre k < popcount(w)
+ */
+inline std::size_t select_in_word(std::uint64_t w, std::size_t k)
+{
+	for (; k > 0; k--)
+		w &= w - 1; // clear lowest set bit
+	return countr_zero(w);
+}
+} // namespace detail
+
+
+
+/**
+ * Dynamic sequence of bits packed into 64 bit words (my::array<uint64_t>).
+ *
+ * Compared to my::array<bool> (one byte per flag) it needs 8x less memory, and
+ * operations on many bits (counting, searching, and/or/xor of two vectors) work
+ * on 64 bits at a time.
+ *
+ * Bit i is bit (i % 64) of word i / 64.
+ * @invariant all bits at positions >= size() in the last word are 0
+ */
+class bit_vector
+{
+public:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr std::size_t bits_per_word = 64;
+
+	/**
+	 * Constructor, creates an empty vector.
+	 * @exception no-throw
+	 */
+	bit_vector() : _size(0) {}
+
+	/**
+	 * Constructor, creates a vector of n bits, all set to 'value'.
+	 * @exception might throw if not enough memory is available.
+	 * @post size() == n
+	 */
+	explicit bit_vector(std::size_t n, bool value = false) : _words(words_for(n)), _size(n)
+	{
+		std::fill(_words.data(), _words.data() + _words.size(), value ? ~std::uint64_t(0) : 0);
+		clear_tail();
+	}
+
+	/**
+	 * @return Number of bits
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * @return Number of bits that can be stored without reallocating
+	 * @exception no-throw
+	 */
+	std::size_t capacity() const { return _words.size() * bits_per_word; }
+
+	/**
+	 * @return Number of words used by the first size() bits
+	 * @exception no-throw
+	 */
+	std::size_t num_words() const { return words_for(_size); }
+
+	/**
+	 * Raw access to the words, e.g. to serialize them.
+	 * Writing bits >= size() through data() breaks the class invariant.
+	 * @exception no-throw
+	 */
+	std::uint64_t * data() { return _words.data(); }
+	std::uint64_t const * data() const { return _words.data(); }
+
+	/**
+	 * @return Memory used in bytes
+	 * @exception no-throw
+	 */
+	std::size_t memory() const { return _words.size() * sizeof(std::uint64_t); }
+
+	/**
+	 * @return Bit i
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	bool test(std::size_t i) const
+	{
+		assert(i < size());
+		return (_words[i / bits_per_word] >> (i % bits_per_word)) & 1;
+	}
+	bool operator[](std::size_t i) const { return test(i); }
+
+	/**
+	 * Single bit modifiers.
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	void set(std::size_t i)
+	{
+		assert(i < size());
+		_words[i / bits_per_word] |= bit(i);
+	}
+	void reset(std::size_t i)
+	{
+		assert(i < size());
+		_words[i / bits_per_word] &= ~bit(i);
+	}
+	void flip(std::size_t i)
+	{
+		assert(i < size());
+		_words[i / bits_per_word] ^= bit(i);
+	}
+	void set(std::size_t i, bool value)
+	{
+		if (value)
+			set(i);
+		else
+			reset(i);
+	}
+
+	/**
+	 * Range modifiers: set/reset/flip all bits in [first, last).
+	 * Whole words in the middle of the range are written at once.
+	 * (Not overloads of set() etc., set(i, true) vs. set(first, last) would be ambiguous.)
+	 * @pre first <= last <= size()
+	 * @exception no-throw
+	 */
+	void set_range(std::size_t first, std::size_t last) { apply(first, last, [](std::uint64_t & w, std::uint64_t m) { w |= m; }); }
+	void reset_range(std::size_t first, std::size_t last) { apply(first, last, [](std::uint64_t & w, std::uint64_t m) { w &= ~m; }); }
+	void flip_range(std::size_t first, std::size_t last) { apply(first, last, [](std::uint64_t & w, std::uint64_t m) { w ^= m; }); }
+
+	/**
+	 * Appends a bit, doubles the capacity if necessary.
+	 * @exception might throw if not enough memory is available (strong exception safety).
+	 */
+	void push_back(bool value)
+	{
+		if (_size == capacity())
+			reserve(std::max<std::size_t>(2 * capacity(), bits_per_word));
+
+		_size++;
+		set(_size - 1, value);
+	}
+
+	/**
+	 * Grows the capacity to at least n bits.
+	 * @exception might throw if not enough memory is available (strong exception safety).
+	 */
+	void reserve(std::size_t n)
+	{
+		if (n <= capacity())
+			return;
+
+		array<std::uint64_t> tmp(words_for(n));
+		std::copy(_words.data(), _words.data() + _words.size(), tmp.data());
+		std::fill(tmp.data() + _words.size(), tmp.data() + tmp.size(), 0);
+		_words.swap(tmp);
+	}
+
+	/**
+	 * Resizes to n bits, new bits are 0.
+	 * @exception might throw if not enough memory is available (strong exception safety).
+	 */
+	void resize(std::size_t n)
+	{
+		reserve(n);
+		if (n < _size)
+		{
+			std::size_t const old_words = num_words();
+			_size = n;
+			std::fill(_words.data() + num_words(), _words.data() + old_words, 0);
+			clear_tail();
+		}
+		else
+			_size = n;
+	}
+
+	/**
+	 * @return Number of set bits (hardware popcount, one per word)
+	 * @exception no-throw
+	 */
+	std::size_t count() const
+	{
+		std::size_t n = 0;
+		for (std::size_t i = 0; i < num_words(); i++)
+			n += detail::popcount(_words[i]);
+		return n;
+	}
+
+	bool any() const
+	{
+		for (std::size_t i = 0; i < num_words(); i++)
+			if (_words[i])
+				return true;
+		return false;
+	}
+	bool none() const { return !any(); }
+
+	/**
+	 * @return Index of the first set bit >= i, npos if there is none. Skips
+	 * 64 zeros at a time, use it to iterate over all set bits:
+	 * for (auto i = v.find_next(0); i != bit_vector::npos; i = v.find_next(i + 1))
+	 * @exception no-throw
+	 */
+	std::size_t find_next(std::size_t i) const
+	{
+		if (i >= _size)
+			return npos;
+
+		std::size_t w = i / bits_per_word;
+		std::uint64_t word = _words[w] & (~std::uint64_t(0) << (i % bits_per_word));
+		while (word == 0)
+		{
+			if (++w == num_words())
+				return npos;
+			word = _words[w];
+		}
+		return w * bits_per_word + detail::countr_zero(word);
+	}
+	std::size_t find_first() const { return find_next(0); }
+
+	/**
+	 * Word-parallel bitwise operations, 64 bits per instruction (and the compiler
+	 * vectorizes the loops on top of that).
+	 * @pre size() == rhs.size()
+	 * @exception no-throw
+	 */
+	bit_vector & operator&=(bit_vector const & rhs) { return combine(rhs, [](std::uint64_t a, std::uint64_t b) { return a & b; }); }
+	bit_vector & operator|=(bit_vector const & rhs) { return combine(rhs, [](std::uint64_t a, std::uint64_t b) { return a | b; }); }
+	bit_vector & operator^=(bit_vector const & rhs) { return combine(rhs, [](std::uint64_t a, std::uint64_t b) { return a ^ b; }); }
+
+	/**
+	 * Clears all bits which are set in rhs (*this &= ~rhs).
+	 * @pre size() == rhs.size()
+	 * @exception no-throw
+	 */
+	bit_vector & and_not(bit_vector const & rhs) { return combine(rhs, [](std::uint64_t a, std::uint64_t b) { return a & ~b; }); }
+
+	/**
+	 * Flips all bits.
+	 * @exception no-throw
+	 */
+	void flip()
+	{
+		for (std::size_t i = 0; i < num_words(); i++)
+			_words[i] = ~_words[i];
+		clear_tail();
+	}
+
+	bool operator==(bit_vector const & rhs) const
+	{
+		return _size == rhs._size && std::equal(_words.data(), _words.data() + num_words(), rhs._words.data());
+	}
+	bool operator!=(bit_vector const & rhs) const { return !(* this == rhs); }
+
+private:
+	static std::size_t words_for(std::size_t bits) { return (bits + bits_per_word - 1) / bits_per_word; }
+	static std::uint64_t bit(std::size_t i) { return std::uint64_t(1) << (i % bits_per_word); }
+
+	// Restores the invariant after operations that may have set bits >= size()
+	void clear_tail()
+	{
+		if (_size % bits_per_word)
+			_words[_size / bits_per_word] &= ~std::uint64_t(0) >> (bits_per_word - _size % bits_per_word);
+	}
+
+	// Calls op(word, mask) for every word overlapping [first, last)
+	template <typename Op>
+	void apply(std::size_t first, std::size_t last, Op op)
+	{
+		assert(first <= last && last <= size());
+		if (first == last)
+			return;
+
+		std::size_t const w0 = first / bits_per_word;
+		std::size_t const w1 = (last - 1) / bits_per_word;
+		std::uint64_t const head = ~std::uint64_t(0) << (first % bits_per_word);
+		std::uint64_t const tail = ~std::uint64_t(0) >> (bits_per_word - 1 - (last - 1) % bits_per_word);
+
+		if (w0 == w1)
+		{
+			op(_words[w0], head & tail);
+			return;
+		}
+
+		op(_words[w0], head);
+		for (std::size_t w = w0 + 1; w < w1; w++)
+			op(_words[w], ~std::uint64_t(0));
+		op(_words[w1], tail);
+	}
+
+	template <typename Op>
+	bit_vector & combine(bit_vector const & rhs, Op op)
+	{
+		assert(size() == rhs.size());
+		std::uint64_t * a = _words.data();
+		std::uint64_t const * b = rhs._words.data();
+		for (std::size_t i = 0, n = num_words(); i < n; i++)
+			a[i] = op(a[i], b[i]);
+		return * this;
+	}
+
+	array<std::uint64_t> _words;
+	std::size_t _size;
+};
+
+
+
+/**
+ * Rank/select index over an (unmodified) bit_vector:
+ * - rank(i):   number of set bits in [0, i), O(1)
+ * - select(k): position of the k-th (0-based) set bit, O(log) over a small range
+ *
+ * rank stores the number of set bits before every 512 bit block (8 words, one cache
+ * line): 12.5% space overhead. A query adds up to 8 popcounts within the block.
+ * select samples the block of every 'select_sample'-th set bit and binary searches
+ * the block counts between two samples.
+ *
+ * The index refers to the bit vector, it must be rebuilt after modifying it.
+ */
+class rank_select
+{
+public:
+	static constexpr std::size_t words_per_block = 8;
+	static constexpr std::size_t bits_per_block = words_per_block * bit_vector::bits_per_word;
+	static constexpr std::size_t select_sample = 4096;
+
+	/**
+	 * Constructor, builds the index in a single pass over 'bits'.
+	 * @exception might throw if not enough memory is available.
+	 */
+	explicit rank_select(bit_vector const & bits) :
+		_bits(& bits),
+		_blocks(bits.num_words() / words_per_block + 2)
+	{
+		std::uint64_t const * w = bits.data();
+		std::size_t const num_words = bits.num_words();
+		std::size_t const num_blocks = _blocks.size() - 1;
+
+		std::size_t ones = 0;
+		for (std::size_t b = 0; b < num_blocks; b++)
+		{
+			_blocks[b] = ones;
+			for (std::size_t i = b * words_per_block; i < std::min((b + 1) * words_per_block, num_words); i++)
+			{
+				std::size_t const c = detail::popcount(w[i]);
+				// record the block of every select_sample-th one
+				while (_samples.size() * select_sample < ones + c)
+					_samples.push_back(b);
+				ones += c;
+			}
+		}
+		_blocks[num_blocks] = ones;
+		_ones = ones;
+	}
+
+	/**
+	 * @return Number of set bits in [0, i)
+	 * @pre i <= size of the bit vector
+	 * @exception no-throw
+	 */
+	std::size_t rank(std::size_t i) const
+	{
+		assert(i <= _bits->size());
+		std::uint64_t const * w = _bits->data();
+		std::size_t const b = i / bits_per_block;
+		std::size_t const last = i / bit_vector::bits_per_word;
+
+		std::size_t n = _blocks[b];
+		for (std::size_t k = b * words_per_block; k < last; k++)
+			n += detail::popcount(w[k]);
+		if (i % bit_vector::bits_per_word)
+			n += detail::popcount(w[last] << (bit_vector::bits_per_word - i % bit_vector::bits_per_word));
+		return n;
+	}
+
+	/**
+	 * @return Position of the k-th (0-based) set bit
+	 * @pre k < number of set bits
+	 * @exception no-throw
+	 */
+	std::size_t select(std::size_t k) const
+	{
+		assert(k < _ones);
+
+		// The block containing the k-th one lies between two samples:
+		// find the last block b with _blocks[b] <= k
+		std::size_t lo = _samples[k / select_sample];
+		std::size_t hi = k / select_sample + 1 < _samples.size() ? _samples[k / select_sample + 1] + 1 : _blocks.size() - 1;
+		while (hi - lo > 1)
+		{
+			std::size_t const mid = (lo + hi) / 2;
+			if (_blocks[mid] <= k)
+				lo = mid;
+			else
+				hi = mid;
+		}
+
+		std::uint64_t const * w = _bits->data();
+		std::size_t remaining = k - _blocks[lo];
+		for (std::size_t i = lo * words_per_block; ; i++)
+		{
+			std::size_t const c = detail::popcount(w[i]);
+			if (remaining < c)
+				return i * bit_vector::bits_per_word + detail::select_in_word(w[i], remaining);
+			remaining -= c;
+		}
+	}
+
+	/**
+	 * @return Total number of set bits
+	 * @exception no-throw
+	 */
+	std::size_t ones() const { return _ones; }
+
+	/**
+	 * @return Memory used by the index in bytes
+	 * @exception no-throw
+	 */
+	std::size_t memory() const { return (_blocks.size() + _samples.size()) * sizeof(std::size_t); }
+
+private:
+	bit_vector const * _bits;
+	array<std::size_t> _blocks;		// _blocks[b]: number of set bits before block b
+	vector<std::size_t> _samples;		// _samples[s]: block containing set bit s * select_sample
+	std::size_t _ones = 0;
+};
+} // namespace my
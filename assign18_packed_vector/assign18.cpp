@@ -0,0 +1,147 @@
+#include "mypacked_vector.h"
+#include "myvector.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test packed_vector()
+		packed_vector v;
+
+		assert(v.size() == 0);
+		assert(v.empty());
+	}
+
+	{// Test pack()/unpack() round trip for every bit width
+		std::mt19937 rng(42);
+		for (unsigned bits = 0; bits <= 32; bits++)
+		{
+			std::uint32_t in[128], packed[128], out[128];
+			for (auto & x : in)
+				x = bits == 0 ? 0 : rng() >> (32 - bits);
+
+			detail::pack(bits, in, packed);
+			detail::unpack(bits, packed, out);
+			for (int i = 0; i < 128; i++)
+				assert(in[i] == out[i]);
+		}
+	}
+
+	{// Test push_back()/operator[] with sorted values (delta blocks)
+		packed_vector v;
+		vector<std::uint32_t> ref;
+		std::uint32_t x = 1'000'000;
+		for (int i = 0; i < 1000; i++)
+		{
+			x += i % 17;
+			v.push_back(x);
+			ref.push_back(x);
+		}
+
+		assert(v.size() == 1000);
+		for (int i = 0; i < 1000; i++)
+			assert(v[i] == ref[i]);
+		assert(v.memory() < 1000 * sizeof(std::uint32_t));
+	}
+
+	{// Test unsorted values (FOR blocks), extreme values
+		std::mt19937 rng(7);
+		vector<std::uint32_t> ref;
+		for (int i = 0; i < 1000; i++)
+			ref.push_back(i < 128 ? rng() : i < 256 ? 0xFFFFFFFF - rng() % 10 : rng() % 5000);
+
+		packed_vector v(ref.begin(), ref.end());
+		for (int i = 0; i < 1000; i++)
+			assert(v[i] == ref[i]);
+	}
+
+	{// Test decode()/for_each()
+		std::mt19937 rng(3);
+		vector<std::uint32_t> ref;
+		std::uint32_t x = 0;
+		for (int i = 0; i < 10'000; i++)
+		{
+			x += rng() % 3 ? rng() % 100 : 0;
+			ref.push_back(i % 1000 < 500 ? x : rng()); // sorted and unsorted blocks
+		}
+
+		packed_vector v(ref.begin(), ref.end());
+
+		vector<std::uint32_t> out(v.size());
+		v.decode(out.data());
+		for (int i = 0; i < 10'000; i++)
+			assert(out[i] == ref[i]);
+
+		std::size_t i = 0;
+		v.for_each([&](std::uint32_t y) { assert(y == ref[i]); i++; });
+		assert(i == 10'000);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 100'000'000; // might need to adjust slightly for your machine
+	int const QUERIES = 10'000'000;
+
+	vector<std::uint32_t> ids;	// sorted, gaps < 64
+	vector<std::uint32_t> codes;	// unsorted, 16 bit
+	{
+		std::mt19937 rng(1);
+		std::uint32_t x = 0;
+		for (int i = 0; i < ITER; i++)
+		{
+			ids.push_back(x += rng() % 64);
+			codes.push_back(rng() % 65536);
+		}
+	}
+
+	for (auto * values : { & ids, & codes })
+	{
+		std::chrono::high_resolution_clock c;
+		std::uint64_t sum1 = 0, sum2 = 0;
+		char const * name = values == & ids ? "sorted IDs" : "16 bit codes";
+
+		auto t1 = c.now();
+		packed_vector p(values->begin(), values->end());
+		auto t2 = c.now();
+		std::cout << "tCompress (" << name << "): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "Compression ratio (" << name << "): " << double(values->size() * sizeof(std::uint32_t)) / p.memory() << std::endl;
+
+		t1 = c.now();
+		for (std::uint32_t x : * values)
+			sum1 += x;
+		t2 = c.now();
+		std::cout << "tScan (" << name << ", my::vector<uint32_t>): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		p.for_each([&](std::uint32_t x) { sum2 += x; });
+		t2 = c.now();
+		auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+		std::cout << "tScan (" << name << ", packed_vector): " << ms << "ms, "
+			<< double(p.size() * sizeof(std::uint32_t)) / (ms + 1) / 1e6 << "GB/s decoded" << std::endl;
+
+		std::mt19937 rng(2);
+		t1 = c.now();
+		for (int i = 0; i < QUERIES; i++)
+			sum1 += (* values)[rng() % ITER];
+		t2 = c.now();
+		std::cout << "tRandom (" << name << ", my::vector<uint32_t>): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		rng.seed(2);
+		t1 = c.now();
+		for (int i = 0; i < QUERIES; i++)
+			sum2 += p[rng() % ITER];
+		t2 = c.now();
+		std::cout << "tRandom (" << name << ", packed_vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << sum1 - sum2 << ", should be 0)" << std::endl << std::endl;
+	}
+
+	return 0;
+}
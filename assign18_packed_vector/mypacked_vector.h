@@ -0,0 +1,352 @@
+#pragma once
+
+#include "myvector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+
+
+namespace my {
+namespace detail {
+/**
+ * Bit-packing of blocks of 128 uint32_t values, 'B' bits per value.
+ *
+ * The values are distributed across 4 interleaved lanes: value i belongs to lane i % 4,
+ * the lanes are packed independently and their 32 bit words are interleaved. Unpacking
+ * thus performs the exact same shifts and masks on 4 adjacent words at a time, which
+ * the compiler turns into a single SIMD (SSE/NEON) instruction each, without us having
+ * to write intrinsics. (The layout is the one of the SIMD-BP128 scheme.)
+ *
+ * A block with B bits per value occupies 4 * B words.
+ */
+std::size_t constexpr block_size = 128;
+std::size_t constexpr lanes = 4;
+
+// Row J of a block: value J of all 4 lanes. All shifts are compile-time constants.
+template <unsigned B, unsigned J>
+void unpack_row(std::uint32_t const * in, std::uint32_t * out)
+{
+	unsigned constexpr pos = J * B, k = pos / 32, shift = pos % 32;
+	std::uint32_t constexpr mask = B == 32 ? ~std::uint32_t(0) : (std::uint32_t(1) << (B % 32)) - 1;
+	std::uint32_t const * w = in + lanes * k;
+	std::uint32_t * o = out + lanes * J;
+
+	// Load all lanes before storing any (in and out can't alias),
+	// so the lane loops become straight SIMD code
+	std::uint32_t v[lanes];
+	if constexpr (shift + B > 32) // values straddle two words
+		for (unsigned l = 0; l < lanes; l++)
+			v[l] = (w[l] >> shift) | (w[lanes + l] << ((32 - shift) % 32));
+	else
+		for (unsigned l = 0; l < lanes; l++)
+			v[l] = w[l] >> shift;
+
+	for (unsigned l = 0; l < lanes; l++)
+		o[l] = v[l] & mask;
+}
+
+template <unsigned B, unsigned... Js>
+void unpack(std::uint32_t const * in, std::uint32_t * out, std::integer_sequence<unsigned, Js...>)
+{
+	(unpack_row<B, Js>(in, out), ...); // fully unrolled
+}
+
+template <unsigned B>
+void unpack(std::uint32_t const * in, std::uint32_t * out)
+{
+	if constexpr (B == 0)
+		std::fill(out, out + block_size, 0);
+	else
+		unpack<B>(in, out, std::make_integer_sequence<unsigned, block_size / lanes>());
+}
+
+using unpack_fn = void (*)(std::uint32_t const *, std::uint32_t *);
+
+template <unsigned... Bs>
+unpack_fn const * unpack_table(std::integer_sequence<unsigned, Bs...>)
+{
+	static unpack_fn const table[] = { & unpack<Bs>... };
+	return table;
+}
+
+/**
+ * Unpacks a block of 128 values with 'bits' bits each (0..32).
+ * Dispatches to an unpack<B>() specialization so all shifts are compile-time constants.
+ */
+inline void unpack(unsigned bits, std::uint32_t const * in, std::uint32_t * out)
+{
+	static unpack_fn const * table = unpack_table(std::make_integer_sequence<unsigned, 33>());
+	table[bits](in, out);
+}
+
+/**
+ * Packs a block of 128 values (each < 2^bits) into 4 * bits words.
+ */
+inline void pack(unsigned bits, std::uint32_t const * in, std::uint32_t * out)
+{
+	std::fill(out, out + lanes * bits, 0);
+	for (unsigned j = 0; j < block_size / lanes; j++)
+	{
+		unsigned const pos = j * bits, k = pos / 32, shift = pos % 32;
+		for (unsigned l = 0; l < lanes; l++)
+		{
+			std::uint32_t const v = in[lanes * j + l];
+			out[lanes * k + l] |= v << shift;
+			if (shift + bits > 32)
+				out[lanes * (k + 1) + l] |= v >> (32 - shift);
+		}
+	}
+}
+
+/**
+ * @return Number of bits needed to represent x
+ */
+inline unsigned bit_width(std::uint32_t x)
+{
+	unsigned b = 0;
+	for (; x; x >>= 1)
+		b++;
+	return b;
+}
+} // namespace detail
+
+
+
+/**
+ * Compressed, append-only sequence of uint32_t (e.g. sorted ID lists).
+ *
+ * Values are stored in blocks of 128. Every block is encoded with the cheaper of two schemes:
+ * - frame of reference (FOR): value - min(block), bit-packed with just enough bits for the
+ *   greatest difference. 128 values in [1000, 1500) take 9 bits each.
+ * - delta: difference to the value 4 positions earlier (one per SIMD lane, so decoding is
+ *   a vectorizable prefix sum), bit-packed. Sorted lists with small gaps compress best.
+ *
+ * A small header per block (base value, bit width, scheme, offset of its words) allows
+ * random access: operator[] only decodes (part of) a single block.
+ * Sequential access through for_each()/decode() unpacks a whole block at a time.
+ *
+ * The most recent (up to 127) values are kept uncompressed until their block is full.
+ */
+class packed_vector
+{
+public:
+	/**
+	 * Constructor, creates an empty vector.
+	 * @exception no-throw
+	 */
+	packed_vector() : _size(0), _tail_size(0) {}
+
+	/**
+	 * Constructor, compresses [first, last).
+	 * @exception might throw if not enough memory is available.
+	 */
+	template <typename It>
+	packed_vector(It first, It last) : packed_vector()
+	{
+		for (; first != last; ++first)
+			push_back(* first);
+	}
+
+	/**
+	 * @return Number of values
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * @return Memory used in bytes (compressed blocks, headers and the uncompressed tail)
+	 * @exception no-throw
+	 */
+	std::size_t memory() const
+	{
+		return _words.size() * sizeof(std::uint32_t) + _blocks.size() * sizeof(header) + sizeof(_tail);
+	}
+
+	/**
+	 * Appends a value, compresses the tail once it holds a whole block.
+	 * @exception might throw if not enough memory is available, or std::length_error if
+	 * the packed blocks would need more than 2^32 words. Strong exception safety.
+	 */
+	void push_back(std::uint32_t x)
+	{
+		_tail[_tail_size++] = x;
+		_size++;
+
+		if (_tail_size == detail::block_size)
+		{
+			try
+			{
+				compress_tail();
+			}
+			catch (...)
+			{
+				_tail_size--;
+				_size--;
+				throw;
+			}
+			_tail_size = 0;
+		}
+	}
+
+	/**
+	 * @return Value i, decodes at most one lane (a quarter) of i's block.
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	std::uint32_t operator[](std::size_t i) const
+	{
+		assert(i < size());
+		std::size_t const b = i / detail::block_size;
+		if (b == _blocks.size())
+			return _tail[i % detail::block_size];
+
+		header const & h = _blocks[b];
+		std::uint32_t const * in = _words.data() + h.offset;
+		unsigned const lane = i % detail::lanes;
+		unsigned const row = i % detail::block_size / detail::lanes;
+
+		// FOR: extract a single value. delta: sum up the lane's deltas up to it.
+		std::uint32_t x = h.base;
+		for (unsigned j = h.delta ? 0 : row; j <= row; j++)
+			x += extract(in, h.bits, j, lane);
+		return x;
+	}
+
+	/**
+	 * Decodes block b (128 values) into out.
+	 * @pre b < number of full blocks (size() / 128)
+	 * @exception no-throw
+	 */
+	void decode_block(std::size_t b, std::uint32_t * out) const
+	{
+		header const & h = _blocks[b];
+		detail::unpack(h.bits, _words.data() + h.offset, out);
+
+		if (h.delta)
+		{
+			// prefix sum per lane: out[i] += out[i - 4]
+			for (unsigned l = 0; l < detail::lanes; l++)
+				out[l] += h.base;
+			for (std::size_t i = detail::lanes; i < detail::block_size; i += detail::lanes)
+				for (unsigned l = 0; l < detail::lanes; l++)
+					out[i + l] += out[i - detail::lanes + l];
+		}
+		else
+			for (std::size_t i = 0; i < detail::block_size; i++)
+				out[i] += h.base;
+	}
+
+	/**
+	 * Decodes all values into out.
+	 * @pre out has room for size() values
+	 * @exception no-throw
+	 */
+	void decode(std::uint32_t * out) const
+	{
+		for (std::size_t b = 0; b < _blocks.size(); b++)
+			decode_block(b, out + b * detail::block_size);
+		std::copy(_tail, _tail + _tail_size, out + _blocks.size() * detail::block_size);
+	}
+
+	/**
+	 * Calls f(x) for every value in order, decoding one block at a time into a buffer
+	 * on the stack (fits into L1).
+	 * @exception whatever f throws
+	 */
+	template <typename F>
+	void for_each(F && f) const
+	{
+		std::uint32_t buf[detail::block_size];
+		for (std::size_t b = 0; b < _blocks.size(); b++)
+		{
+			decode_block(b, buf);
+			for (std::size_t i = 0; i < detail::block_size; i++)
+				f(buf[i]);
+		}
+		for (std::size_t i = 0; i < _tail_size; i++)
+			f(_tail[i]);
+	}
+
+private:
+	struct header
+	{
+		std::uint32_t base;	// minimum, FOR: subtracted from all values, delta: from the first 4
+		std::uint32_t offset;	// index of the block's first word in _words (< 2^32, checked)
+		std::uint8_t bits;	// bits per value
+		bool delta;		// delta or FOR encoded
+	};
+
+	// Value j of 'lane' in a block packed with 'bits' bits per value
+	static std::uint32_t extract(std::uint32_t const * in, unsigned bits, unsigned j, unsigned lane)
+	{
+		if (bits == 0)
+			return 0;
+
+		unsigned const pos = j * bits, k = pos / 32, shift = pos % 32;
+		std::uint64_t v = in[detail::lanes * k + lane] >> shift;
+		if (shift + bits > 32)
+			v |= std::uint64_t(in[detail::lanes * (k + 1) + lane]) << (32 - shift);
+		return static_cast<std::uint32_t>(v & ((std::uint64_t(1) << bits) - 1));
+	}
+
+	// Encodes _tail as a new block with the cheaper scheme
+	void compress_tail()
+	{
+		std::uint32_t const * v = _tail;
+		std::uint32_t const lo = * std::min_element(v, v + detail::block_size);
+		std::uint32_t const hi = * std::max_element(v, v + detail::block_size);
+		unsigned const for_bits = detail::bit_width(hi - lo);
+
+		// Deltas are only an option if every lane is non-decreasing
+		std::uint32_t deltas[detail::block_size];
+		bool sorted = true;
+		std::uint32_t max_delta = 0;
+		for (std::size_t i = 0; i < detail::block_size && sorted; i++)
+		{
+			std::uint32_t const prev = i < detail::lanes ? lo : v[i - detail::lanes];
+			sorted = v[i] >= prev;
+			deltas[i] = v[i] - prev;
+			max_delta = std::max(max_delta, deltas[i]);
+		}
+		unsigned const delta_bits = detail::bit_width(max_delta);
+
+		if (_words.size() > std::numeric_limits<std::uint32_t>::max())
+			throw std::length_error("packed_vector: more than 2^32 words (16 GB) of packed blocks");
+
+		header h;
+		h.base = lo;
+		h.offset = static_cast<std::uint32_t>(_words.size());
+		h.delta = sorted && delta_bits < for_bits;
+		h.bits = static_cast<std::uint8_t>(h.delta ? delta_bits : for_bits);
+
+		std::uint32_t packed[detail::lanes * 32];
+		if (h.delta)
+			detail::pack(h.bits, deltas, packed);
+		else
+		{
+			std::uint32_t offsets[detail::block_size];
+			for (std::size_t i = 0; i < detail::block_size; i++)
+				offsets[i] = v[i] - lo;
+			detail::pack(h.bits, offsets, packed);
+		}
+
+		// If this throws half way, the words appended so far are unreferenced but harmless
+		for (std::size_t i = 0; i < detail::lanes * h.bits; i++)
+			_words.push_back(packed[i]);
+		_blocks.push_back(h);
+	}
+
+	vector<std::uint32_t> _words;	// packed blocks, back to back
+	vector<header> _blocks;
+	std::uint32_t _tail[detail::block_size]; // not yet compressed values
+	std::size_t _size;
+	std::size_t _tail_size;
+};
+} // namespace my
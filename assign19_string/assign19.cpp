@@ -0,0 +1,234 @@
+#include "myhash_map.h"
+#include "mystring.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test string()
+		string s;
+
+		assert(s.size() == 0);
+		assert(s.empty());
+		assert(s.capacity() == string::sso_capacity);
+		assert(std::strcmp(s.c_str(), "") == 0);
+		assert(sizeof(string) == 3 * sizeof(void *));
+	}
+
+	{// Test string(char const *) short and long
+		string a("hello"), b("a string too long for the inline buffer");
+
+		assert(a.size() == 5 && a == "hello");
+		assert(a.capacity() == string::sso_capacity);
+		assert(b.size() == 39 && b.capacity() >= 39);
+		assert(std::strcmp(b.c_str(), "a string too long for the inline buffer") == 0);
+
+		string c(std::string_view("xyz1234", 3)), d("0123456789012345678901"); // exactly sso_capacity
+		assert(c == "xyz" && c.c_str()[3] == '\0');
+		assert(d.size() == 22 && d.capacity() == string::sso_capacity);
+	}
+
+	{// Test copy/move constructor and assignment
+		string a("short"), b("long enough to be stored on the heap");
+
+		string c(a), d(b);
+		assert(c == a && d == b);
+		assert(d.data() != b.data()); // deep copy
+
+		char const * buf = d.data();
+		string e(std::move(d));
+		assert(e == b && e.data() == buf); // stole the buffer
+		assert(d.empty());
+
+		c = b;
+		assert(c == b);
+		e = a; // fits into e's buffer
+		assert(e == a && e.data() == buf);
+		e = std::move(c);
+		assert(e == b && c.empty());
+		c = c;
+		assert(c.empty());
+	}
+
+	{// Test append()/push_back()/reserve()
+		string s;
+		std::string ref;
+		for (int i = 0; i < 1000; i++)
+		{
+			char const c = char('a' + i % 26);
+			s.push_back(c);
+			ref.push_back(c);
+			assert(s.size() == ref.size() && s == ref);
+		}
+
+		s.append(s.data(), 10); // self-append
+		ref.append(ref.data(), 10);
+		assert(s == ref);
+
+		s += "!!";
+		s += '?';
+		assert(s.size() == 1013 && s[1012] == '?');
+
+		std::size_t const cap = s.capacity();
+		s.clear();
+		assert(s.empty() && s.capacity() == cap && s == "");
+
+		string t("abc");
+		t.reserve(100);
+		assert(t.capacity() >= 100 && t == "abc");
+	}
+
+	{// Test find()
+		string s("the quick brown fox jumps over the lazy dog");
+
+		assert(s.find('q') == 4);
+		assert(s.find('t', 1) == 31);
+		assert(s.find('x', 19) == string::npos);
+		assert(s.find('z', 100) == string::npos);
+
+		assert(s.find("the") == 0);
+		assert(s.find("the", 1) == 31);
+		assert(s.find("dog") == 40);
+		assert(s.find("dogs") == string::npos);
+		assert(s.find("") == 0 && s.find("", 43) == 43 && s.find("", 44) == string::npos);
+		assert(string("aaab").find("aab") == 1);
+	}
+
+	{// Test comparisons
+		string a("apple"), b("banana");
+
+		assert(a < b && !(b < a));
+		assert(a != b && a == string("apple"));
+		assert(a == std::string("apple") && std::string_view("apple") == a);
+	}
+
+	{// Test hash<string> and flat_hash_map
+		assert(hash<string>()(string("key")) == hash<std::string>()(std::string("key")));
+
+		flat_hash_map<string, int> m;
+		m["one"] = 1;
+		m["a key longer than twenty-two chars"] = 2;
+
+		assert(m.contains("one"));
+		assert(m.contains(std::string_view("a key longer than twenty-two chars")));
+		assert(m.contains(std::string("one")));
+		assert(!m.contains("two"));
+		assert(m.find("one")->second == 1);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 2'000'000; // might need to adjust slightly for your machine
+
+	// Short keys, 3 to 22 chars (std::string keeps up to 15 inline, string up to 22)
+	std::vector<std::string> words;
+	{
+		std::mt19937 rng(1);
+		for (int i = 0; i < ITER; i++)
+		{
+			std::string w(3 + rng() % 20, ' ');
+			for (char & c : w)
+				c = char('a' + rng() % 26);
+			words.push_back(w);
+		}
+	}
+
+	{// Create and copy keys
+		std::chrono::high_resolution_clock c;
+		std::size_t sum1 = 0, sum2 = 0;
+
+		auto t1 = c.now();
+		{
+			std::vector<std::string> keys;
+			keys.reserve(ITER);
+			for (auto const & w : words)
+				keys.emplace_back(w.data(), w.size());
+			std::vector<std::string> copy = keys;
+			for (auto const & k : copy)
+				sum1 += k.size();
+		}
+		auto t2 = c.now();
+		std::cout << "tCreate (std::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		{
+			std::vector<string> keys;
+			keys.reserve(ITER);
+			for (auto const & w : words)
+				keys.emplace_back(w.data(), w.size());
+			std::vector<string> copy = keys;
+			for (auto const & k : copy)
+				sum2 += k.size();
+		}
+		t2 = c.now();
+		std::cout << "tCreate (my::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << sum1 - sum2 << ", should be 0)" << std::endl << std::endl;
+	}
+
+	{// Insert into and look up in a flat_hash_map
+		std::chrono::high_resolution_clock c;
+		std::size_t sum1 = 0, sum2 = 0;
+
+		auto t1 = c.now();
+		{
+			flat_hash_map<std::string, int> m;
+			for (int i = 0; i < ITER; i++)
+				m[words[i]] = i;
+			for (int i = ITER - 1; i >= 0; i--)
+				sum1 += m.find(words[i])->second;
+		}
+		auto t2 = c.now();
+		std::cout << "tHashMap (std::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		{
+			flat_hash_map<string, int> m;
+			for (int i = 0; i < ITER; i++)
+				m[string(words[i])] = i;
+			for (int i = ITER - 1; i >= 0; i--)
+				sum2 += m.find(words[i])->second;
+		}
+		t2 = c.now();
+		std::cout << "tHashMap (my::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << sum1 - sum2 << ", should be 0)" << std::endl << std::endl;
+	}
+
+	{// Build a long string, then search it
+		std::chrono::high_resolution_clock c;
+		std::size_t sum1 = 0, sum2 = 0;
+
+		auto t1 = c.now();
+		std::string s1;
+		for (auto const & w : words)
+			s1.append(w);
+		for (std::size_t i = s1.find('z'); i != std::string::npos; i = s1.find('z', i + 1))
+			sum1 += i;
+		sum1 += s1.find("zzzzz");
+		auto t2 = c.now();
+		std::cout << "tAppendFind (std::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		string s2;
+		for (auto const & w : words)
+			s2.append(w);
+		for (std::size_t i = s2.find('z'); i != string::npos; i = s2.find('z', i + 1))
+			sum2 += i;
+		sum2 += s2.find("zzzzz");
+		t2 = c.now();
+		std::cout << "tAppendFind (my::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << sum1 - sum2 << ", should be 0)" << std::endl;
+	}
+
+	return 0;
+}
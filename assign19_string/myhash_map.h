@@ -0,0 +1,420 @@
+#pragma once
+
+#include "myarray.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+
+
+namespace my {
+/**
+ * Hash function object used by default by flat_hash_map/flat_hash_set.
+ * Identical to std::hash except for strings, where it is 'transparent': it hashes
+ * anything convertible to std::string_view, so we can look up a std::string key
+ * with a string literal without constructing a temporary std::string.
+ */
+template <typename T>
+struct hash : std::hash<T> {};
+
+template <>
+struct hash<std::string>
+{
+	using is_transparent = void;
+
+	std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+};
+
+namespace detail {
+/**
+ * Open addressing hash table with Robin Hood probing, the common implementation
+ * of flat_hash_map and flat_hash_set.
+ *
+ * All elements live directly inside a single my::array (no per-element nodes).
+ * A parallel array of one-byte 'distances' holds, for each slot, 1 + the distance
+ * of its element from its home slot (0 = empty). Robin Hood insertion lets a new
+ * element take the slot of any element that is closer to its home ("richer") than
+ * the new one, which keeps all probe sequences short and allows lookups to stop as
+ * soon as they meet an element closer to its home than the key would be.
+ * Erasing shifts the following elements back by one slot (no tombstones).
+ *
+ * @tparam Value Stored element type (K or std::pair<K, V>)
+ * @tparam KeyOf Function object extracting the key from a Value
+ * @invariant size() <= capacity() * max_load_factor
+ */
+template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+class robin_hood_table
+{
+	template <bool Const>
+	class iterator_impl
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Value;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, Value const *, Value *>;
+		using reference = std::conditional_t<Const, Value const &, Value &>;
+		using table_type = std::conditional_t<Const, robin_hood_table const, robin_hood_table>;
+
+		iterator_impl() = default;
+		iterator_impl(table_type * table, std::size_t i) : _table(table), _i(i) { skip_empty(); }
+		// iterator -> const_iterator
+		template <bool C = Const, typename = std::enable_if_t<C>>
+		iterator_impl(iterator_impl<false> const & other) : _table(other._table), _i(other._i) {}
+
+		reference operator*() const { return _table->_slots[_i]; }
+		pointer operator->() const { return & _table->_slots[_i]; }
+
+		iterator_impl & operator++()
+		{
+			_i++;
+			skip_empty();
+			return * this;
+		}
+
+		bool operator==(iterator_impl const & rhs) const { return _i == rhs._i; }
+		bool operator!=(iterator_impl const & rhs) const { return _i != rhs._i; }
+
+	private:
+		friend class robin_hood_table;
+		friend class iterator_impl<true>;
+
+		void skip_empty()
+		{
+			while (_i < _table->capacity() && _table->_dist[_i] == 0)
+				_i++;
+		}
+
+		table_type * _table = nullptr;
+		std::size_t _i = 0;
+	};
+
+public:
+	using iterator = iterator_impl<false>;
+	using const_iterator = iterator_impl<true>;
+
+	/**
+	 * Constructor, creates an empty table. Does not allocate.
+	 * @exception no-throw
+	 * @post size() == capacity() == 0
+	 */
+	robin_hood_table() : _size(0), _shift(64) {}
+
+	/**
+	 * @return Number of elements in the table
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * @return Number of slots (always 0 or a power of two)
+	 * @exception no-throw
+	 */
+	std::size_t capacity() const { return _slots.size(); }
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, capacity()); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, capacity()); }
+
+	/**
+	 * Grows the table so it can hold n elements without rehashing.
+	 * @exception might throw if not enough memory is available or if Value's move
+	 * assignment throws. Provides strong exception safety if it doesn't.
+	 * @post capacity() * max_load_factor >= n
+	 */
+	void reserve(std::size_t n)
+	{
+		std::size_t cap = 8;
+		while (cap * max_load_num / max_load_den < n)
+			cap *= 2;
+
+		if (cap > capacity())
+			rehash(cap);
+	}
+
+	/**
+	 * Removes all elements, keeps the capacity.
+	 * @exception might throw if Value's assignment throws
+	 * @post size() == 0
+	 */
+	void clear()
+	{
+		for (std::size_t i = 0; i < capacity(); i++)
+			if (_dist[i])
+			{
+				_slots[i] = Value();
+				_dist[i] = 0;
+			}
+		_size = 0;
+	}
+
+	/**
+	 * @return Iterator to the element with key equivalent to 'key', end() if there is none.
+	 * The template overload is only available if Hash and KeyEqual are transparent
+	 * (define 'is_transparent') and allows looking up keys of a different type than Key.
+	 * @exception might throw if Hash or KeyEqual throw
+	 */
+	iterator find(Key const & key) { return iterator(this, find_index(key)); }
+	const_iterator find(Key const & key) const { return const_iterator(this, find_index(key)); }
+
+	template <typename Q, typename H = Hash, typename E = KeyEqual,
+		typename = typename H::is_transparent, typename = typename E::is_transparent>
+	iterator find(Q const & key) { return iterator(this, find_index(key)); }
+	template <typename Q, typename H = Hash, typename E = KeyEqual,
+		typename = typename H::is_transparent, typename = typename E::is_transparent>
+	const_iterator find(Q const & key) const { return const_iterator(this, find_index(key)); }
+
+	/**
+	 * Inserts 'val' unless an element with an equivalent key already exists.
+	 * @return Iterator to the element with val's key and whether 'val' was inserted
+	 * @exception might throw if not enough memory is available to grow the table or
+	 * if Value's assignment throws. Provides strong exception safety only if the
+	 * table does not have to grow.
+	 * @post find(key of val) != end()
+	 */
+	std::pair<iterator, bool> insert(Value val)
+	{
+		std::size_t i = find_index(KeyOf()(val));
+		if (i != capacity())
+			return { iterator(this, i), false };
+
+		if (_size + 1 > capacity() * max_load_num / max_load_den)
+			reserve(_size + 1);
+
+		i = insert_unique(std::move(val));
+		return { iterator(this, i), true };
+	}
+
+	/**
+	 * Removes the element with key equivalent to 'key' (if any).
+	 * As with find(), the template overload requires transparent Hash and KeyEqual.
+	 * @return Number of elements removed (0 or 1)
+	 * @exception might throw if Value's move assignment throws
+	 */
+	std::size_t erase(Key const & key) { return erase_key(key); }
+
+	template <typename Q, typename H = Hash, typename E = KeyEqual,
+		typename = typename H::is_transparent, typename = typename E::is_transparent>
+	std::size_t erase(Q const & key) { return erase_key(key); }
+
+	/**
+	 * Removes the element at 'pos'.
+	 * @return Iterator to the element that now occupies pos's slot (shifted back
+	 * into it), or the next element
+	 * @pre pos != end()
+	 */
+	iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+	iterator erase(const_iterator pos)
+	{
+		assert(pos._i < capacity() && _dist[pos._i]);
+		erase_index(pos._i);
+		return iterator(this, pos._i);
+	}
+
+private:
+	// Maximum load factor 7/8: Robin Hood keeps probe sequences short even when nearly full
+	static constexpr std::size_t max_load_num = 7;
+	static constexpr std::size_t max_load_den = 8;
+
+	// Fibonacci hashing: multiply with 2^64 / golden ratio and keep the topmost bits.
+	// Scrambles weak hash functions (e.g. std::hash<int> is the identity).
+	template <typename Q>
+	std::size_t home(Q const & key) const
+	{
+		return static_cast<std::size_t>((static_cast<std::uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ull) >> _shift);
+	}
+
+	template <typename Q>
+	std::size_t erase_key(Q const & key)
+	{
+		std::size_t const i = find_index(key);
+		if (i == capacity())
+			return 0;
+
+		erase_index(i);
+		return 1;
+	}
+
+	template <typename Q>
+	std::size_t find_index(Q const & key) const
+	{
+		if (_size == 0)
+			return capacity();
+
+		std::size_t const mask = capacity() - 1;
+		std::size_t i = home(key);
+		// A key can't be further than dist from its home once we see a 'richer' element.
+		for (std::uint8_t dist = 1; _dist[i] >= dist; i = (i + 1) & mask, dist++)
+			if (_dist[i] == dist && KeyEqual()(KeyOf()(_slots[i]), key))
+				return i;
+
+		return capacity();
+	}
+
+	// @pre val's key is not in the table, size() < capacity()
+	// @return Slot val ended up in
+	std::size_t insert_unique(Value val)
+	{
+		std::size_t const mask = capacity() - 1;
+		std::size_t result = capacity();
+		std::size_t i = home(KeyOf()(val));
+		std::uint8_t dist = 1;
+
+		for (;; i = (i + 1) & mask, dist++)
+		{
+			if (dist == 255) // probe sequence too long (weak hash function), grow and retry
+			{
+				Key const key = result == capacity() ? KeyOf()(val) : KeyOf()(_slots[result]);
+				rehash(capacity() * 2);
+				insert_unique(std::move(val));
+				return find_index(key);
+			}
+
+			if (_dist[i] == 0)
+			{
+				_slots[i] = std::move(val);
+				_dist[i] = dist;
+				_size++;
+				return result == capacity() ? i : result;
+			}
+
+			if (_dist[i] < dist) // rob the rich: the resident is closer to its home than we are
+			{
+				std::swap(_slots[i], val);
+				std::swap(_dist[i], dist);
+				if (result == capacity())
+					result = i;
+			}
+		}
+	}
+
+	void erase_index(std::size_t i)
+	{
+		std::size_t const mask = capacity() - 1;
+
+		// Backward shift: pull following elements one slot closer to their home.
+		for (std::size_t next = (i + 1) & mask; _dist[next] > 1; i = next, next = (next + 1) & mask)
+		{
+			_slots[i] = std::move(_slots[next]);
+			_dist[i] = _dist[next] - 1;
+		}
+
+		_slots[i] = Value(); // release resources held by the element
+		_dist[i] = 0;
+		_size--;
+	}
+
+	void rehash(std::size_t new_capacity)
+	{
+		robin_hood_table tmp;
+		tmp._slots = array<Value>(new_capacity);
+		tmp._dist = array<std::uint8_t>(new_capacity);
+		std::fill(tmp._dist.data(), tmp._dist.data() + new_capacity, std::uint8_t(0));
+		tmp._shift = 64;
+		for (std::size_t c = new_capacity; c > 1; c /= 2)
+			tmp._shift--;
+
+		for (std::size_t i = 0; i < capacity(); i++)
+			if (_dist[i])
+				tmp.insert_unique(std::move(_slots[i]));
+
+		_slots.swap(tmp._slots);
+		_dist.swap(tmp._dist);
+		_shift = tmp._shift;
+	}
+
+	array<Value> _slots;
+	array<std::uint8_t> _dist;
+	std::size_t _size;
+	unsigned _shift; // 64 - log2(capacity())
+};
+
+template <typename K, typename V>
+struct select_first
+{
+	K const & operator()(std::pair<K, V> const & p) const { return p.first; }
+};
+
+template <typename K>
+struct identity
+{
+	K const & operator()(K const & k) const { return k; }
+};
+} // namespace detail
+
+
+
+/**
+ * Unordered map from keys to values (simplified version of std::unordered_map)
+ * using open addressing: all pairs live in one contiguous array instead of one
+ * heap-allocated node per element.
+ *
+ * Unlike std::unordered_map, inserting or erasing invalidates all iterators and
+ * references. K and V must be default constructible. Probe distances are stored in
+ * a single byte, so Hash must not map hundreds of keys to the exact same value (the
+ * table would keep growing in an attempt to separate them).
+ */
+template <typename K, typename V, typename Hash = hash<K>, typename KeyEqual = std::equal_to<>>
+class flat_hash_map : public detail::robin_hood_table<K, std::pair<K, V>, detail::select_first<K, V>, Hash, KeyEqual>
+{
+	using base = detail::robin_hood_table<K, std::pair<K, V>, detail::select_first<K, V>, Hash, KeyEqual>;
+
+public:
+	using base::insert;
+
+	/**
+	 * Inserts the pair (key, val) unless 'key' already exists.
+	 * @return see robin_hood_table::insert()
+	 */
+	std::pair<typename base::iterator, bool> insert(K const & key, V const & val)
+	{
+		return base::insert(std::pair<K, V>(key, val));
+	}
+
+	/**
+	 * @return Reference to the value mapped to 'key', inserts a default-constructed
+	 * value if 'key' doesn't exist yet.
+	 * @exception see robin_hood_table::insert()
+	 */
+	V & operator[](K const & key)
+	{
+		auto it = base::find(key);
+		if (it == base::end())
+			it = base::insert(std::pair<K, V>(key, V())).first;
+
+		return it->second;
+	}
+
+	/**
+	 * @return true if the map contains an element with key equivalent to 'key'
+	 */
+	template <typename Q>
+	bool contains(Q const & key) const { return base::find(key) != base::end(); }
+};
+
+/**
+ * Unordered set of unique keys (simplified version of std::unordered_set),
+ * see flat_hash_map.
+ */
+template <typename K, typename Hash = hash<K>, typename KeyEqual = std::equal_to<>>
+class flat_hash_set : public detail::robin_hood_table<K, K, detail::identity<K>, Hash, KeyEqual>
+{
+	using base = detail::robin_hood_table<K, K, detail::identity<K>, Hash, KeyEqual>;
+
+public:
+	/**
+	 * @return true if the set contains an element equivalent to 'key'
+	 */
+	template <typename Q>
+	bool contains(Q const & key) const { return base::find(key) != base::end(); }
+};
+} // namespace my
@@ -0,0 +1,416 @@
+#pragma once
+
+#include "myhash_map.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string_view>
+#include <utility>
+
+
+
+namespace my {
+/**
+ * Owning, growable sequence of chars (simplified version of std::string), the
+ * descendant of assign01's memory_block: a heap-allocated char buffer, plus the
+ * small string optimization (SSO).
+ *
+ * Strings of up to 22 chars are stored inside the object itself (24 bytes, like a
+ * char pointer and two sizes), so short keys never touch the heap: no allocation
+ * when they are created, no cache miss when they are compared. Longer strings live
+ * in a heap buffer which grows by 1.5x, so append() takes amortized O(1) per char.
+ *
+ * The chars are always followed by '\0', so c_str() doesn't need to copy.
+ * @invariant size() <= capacity()
+ */
+class string
+{
+public:
+	using value_type = char;
+	using iterator = char *;
+	using const_iterator = char const *;
+
+	static std::size_t constexpr npos = static_cast<std::size_t>(-1);
+
+	/**
+	 * Number of chars stored without allocating memory.
+	 */
+	static std::size_t constexpr sso_capacity = 22;
+
+	/**
+	 * Constructor, creates an empty string.
+	 * @exception no-throw
+	 * @post size() == 0, capacity() == sso_capacity
+	 */
+	string() noexcept { set_short(0); }
+
+	/**
+	 * Constructor, copies the C-string 's' / the n chars at 's' / the chars viewed by 's'.
+	 * @exception might throw if not enough memory is available (only if the size
+	 * exceeds sso_capacity)
+	 */
+	string(char const * s) : string(s, std::strlen(s)) {}
+	string(char const * s, std::size_t n) { assign_new(s, n); }
+	explicit string(std::string_view s) : string(s.data(), s.size()) {}
+
+	/**
+	 * Copy constructor, creates a deep copy of 'other'.
+	 * @exception might throw if not enough memory is available. Provides strong exception safety.
+	 * @post *this == other
+	 */
+	string(string const & other) : string(other.data(), other.size()) {}
+
+	/**
+	 * Move constructor, steals the buffer of 'other'. Short strings are copied,
+	 * which is just as fast (24 bytes).
+	 * @exception no-throw
+	 * @post other.empty()
+	 */
+	string(string && other) noexcept : _rep(other._rep) { other.set_short(0); }
+
+	/**
+	 * Destructor, releases the heap buffer (if any).
+	 * @exception no-throw
+	 */
+	~string() { release(); }
+
+	/**
+	 * Copy assignment operator, creates a deep copy of 'rhs'.
+	 * @exception might throw if not enough memory is available. Provides strong exception safety.
+	 * @post *this == rhs
+	 */
+	string & operator=(string const & rhs)
+	{
+		if (this != & rhs)
+		{
+			if (rhs.size() <= capacity()) // reuse our buffer
+				copy_into(rhs.data(), rhs.size());
+			else
+			{
+				string tmp(rhs);
+				swap(tmp);
+			}
+		}
+
+		return * this;
+	}
+
+	/**
+	 * Move assignment operator, steals the buffer of 'rhs'.
+	 * @exception no-throw
+	 * @post rhs.empty()
+	 */
+	string & operator=(string && rhs) noexcept
+	{
+		if (this != & rhs)
+		{
+			release();
+			_rep = rhs._rep;
+			rhs.set_short(0);
+		}
+
+		return * this;
+	}
+
+	/**
+	 * Exchanges the contents of this string with 'other'.
+	 * @exception no-throw
+	 */
+	void swap(string & other) noexcept { std::swap(_rep, other._rep); }
+
+	/**
+	 * @return Number of chars (without the terminating '\0')
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return is_long() ? _rep.l.size : _rep.s.size; }
+	std::size_t length() const { return size(); }
+	bool empty() const { return size() == 0; }
+
+	/**
+	 * @return Number of chars that can be stored without allocating (more) memory
+	 * @exception no-throw
+	 */
+	std::size_t capacity() const { return is_long() ? heap_capacity(_rep.l.data) : sso_capacity; }
+
+	/**
+	 * @return Raw pointer to the chars, followed by '\0'
+	 * @exception no-throw
+	 */
+	char * data() { return is_long() ? _rep.l.data : _rep.s.data; }
+	char const * data() const { return is_long() ? _rep.l.data : _rep.s.data; }
+	char const * c_str() const { return data(); }
+
+	iterator begin() { return data(); }
+	iterator end() { return data() + size(); }
+	const_iterator begin() const { return data(); }
+	const_iterator end() const { return data() + size(); }
+
+	/**
+	 * @return (Reference to) char at index i
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	char & operator[](std::size_t i)
+	{
+		assert(i < size());
+		return data()[i];
+	}
+	char operator[](std::size_t i) const
+	{
+		assert(i < size());
+		return data()[i];
+	}
+
+	/**
+	 * Implicit conversion to a view, e.g. to pass a my::string to any function taking a std::string_view.
+	 * @exception no-throw
+	 */
+	operator std::string_view() const { return std::string_view(data(), size()); }
+
+	/**
+	 * Grows the capacity to at least n chars.
+	 * @exception might throw if not enough memory is available. Provides strong exception safety.
+	 * @post capacity() >= n
+	 */
+	void reserve(std::size_t n)
+	{
+		if (n <= capacity())
+			return;
+
+		std::size_t const sz = size();
+		char * tmp = allocate(n);
+		std::memcpy(tmp, data(), sz + 1);
+
+		release();
+		set_long(tmp, sz);
+	}
+
+	/**
+	 * Appends n chars starting at s. The buffer grows by at least 1.5x, so appending
+	 * one char at a time takes amortized O(1). 's' may point into this string.
+	 * @exception might throw if not enough memory is available. Provides strong exception safety.
+	 * @post size() grows by n
+	 */
+	string & append(char const * s, std::size_t n)
+	{
+		std::size_t const sz = size(), cap = capacity();
+		if (sz + n > cap)
+		{
+			// grow into a new buffer first, 's' stays valid even if it points into the old one
+			char * tmp = allocate(std::max(sz + n, cap + cap / 2));
+			std::memcpy(tmp, data(), sz);
+			std::memcpy(tmp + sz, s, n);
+			tmp[sz + n] = '\0';
+
+			release();
+			set_long(tmp, sz + n);
+		}
+		else
+		{
+			char * d = data();
+			std::memmove(d + sz, s, n);
+			d[sz + n] = '\0';
+			set_size(sz + n);
+		}
+
+		return * this;
+	}
+	string & append(std::string_view s) { return append(s.data(), s.size()); }
+	string & operator+=(std::string_view s) { return append(s.data(), s.size()); }
+	string & operator+=(char c) { push_back(c); return * this; }
+
+	void push_back(char c) { append(& c, 1); }
+
+	/**
+	 * Removes all chars, keeps the capacity.
+	 * @exception no-throw
+	 * @post size() == 0
+	 */
+	void clear() { set_size(0); data()[0] = '\0'; }
+
+	/**
+	 * @return Index of the first occurrence of c at or after pos, or npos.
+	 * Uses std::memchr, which the standard libraries implement with SIMD (SSE2/AVX2/NEON)
+	 * comparing 16 or 32 chars at a time.
+	 * @exception no-throw
+	 */
+	std::size_t find(char c, std::size_t pos = 0) const
+	{
+		std::size_t const sz = size();
+		if (pos >= sz)
+			return npos;
+
+		char const * d = data();
+		auto p = static_cast<char const *>(std::memchr(d + pos, c, sz - pos));
+		return p ? p - d : npos;
+	}
+
+	/**
+	 * @return Index of the first occurrence of s at or after pos, or npos.
+	 * Jumps from candidate to candidate with memchr() for s[0], and only compares
+	 * the remaining chars where the first one matches.
+	 * @exception no-throw
+	 */
+	std::size_t find(std::string_view s, std::size_t pos = 0) const
+	{
+		std::size_t const sz = size();
+		if (s.empty())
+			return pos <= sz ? pos : npos;
+		if (pos > sz || s.size() > sz - pos)
+			return npos;
+
+		char const * d = data();
+		char const * const last = d + (sz - s.size()); // last possible start
+		for (char const * p = d + pos; p <= last; p++)
+		{
+			p = static_cast<char const *>(std::memchr(p, s[0], last - p + 1));
+			if (!p)
+				break;
+			if (std::memcmp(p + 1, s.data() + 1, s.size() - 1) == 0)
+				return p - d;
+		}
+
+		return npos;
+	}
+	std::size_t find(char const * s, std::size_t pos = 0) const { return find(std::string_view(s), pos); }
+
+	/**
+	 * Comparisons, also against anything convertible to std::string_view (std::string, "literals").
+	 * @exception no-throw
+	 */
+	friend bool operator==(string const & a, string const & b) { return std::string_view(a) == std::string_view(b); }
+	friend bool operator!=(string const & a, string const & b) { return !(a == b); }
+	friend bool operator<(string const & a, string const & b) { return std::string_view(a) < std::string_view(b); }
+	friend bool operator==(string const & a, std::string_view b) { return std::string_view(a) == b; }
+	friend bool operator==(std::string_view a, string const & b) { return a == std::string_view(b); }
+	friend bool operator!=(string const & a, std::string_view b) { return !(a == b); }
+	friend bool operator!=(std::string_view a, string const & b) { return !(a == b); }
+	friend bool operator==(string const & a, char const * b) { return std::string_view(a) == b; }
+	friend bool operator==(char const * a, string const & b) { return a == std::string_view(b); }
+	friend bool operator!=(string const & a, char const * b) { return !(a == b); }
+	friend bool operator!=(char const * a, string const & b) { return !(a == b); }
+
+	friend std::ostream & operator<<(std::ostream & os, string const & s) { return os << std::string_view(s); }
+
+private:
+	/*
+	 * Both representations start with a byte, so which one is active can be read
+	 * from either (common initial sequence): the size of a short string, or 'long_tag'.
+	 * The capacity of a long string is stored in front of its chars on the heap,
+	 * which leaves room for 22 chars + '\0' in the short representation.
+	 */
+	static unsigned char constexpr long_tag = 0xFF;
+
+	struct short_rep
+	{
+		unsigned char size;
+		char data[sso_capacity + 1];
+	};
+
+	struct long_rep
+	{
+		unsigned char tag;
+		std::size_t size;
+		char * data;	// preceded by the capacity, see allocate()
+	};
+
+	union rep
+	{
+		short_rep s;
+		long_rep l;
+	};
+
+	static_assert(sizeof(short_rep) <= sizeof(long_rep), "short strings must not enlarge the object");
+
+	bool is_long() const { return _rep.s.size == long_tag; }
+
+	void set_short(std::size_t n)
+	{
+		_rep.s.size = static_cast<unsigned char>(n);
+		_rep.s.data[n] = '\0';
+	}
+
+	void set_long(char * data, std::size_t n)
+	{
+		_rep.l.tag = long_tag;
+		_rep.l.size = n;
+		_rep.l.data = data;
+	}
+
+	void set_size(std::size_t n)
+	{
+		if (is_long())
+			_rep.l.size = n;
+		else
+			_rep.s.size = static_cast<unsigned char>(n);
+	}
+
+	// Buffer for cap chars + '\0', preceded by cap (the layout a memory_block would have
+	// if it knew its size)
+	static char * allocate(std::size_t cap)
+	{
+		char * block = new char[sizeof(std::size_t) + cap + 1];
+		std::memcpy(block, & cap, sizeof(cap));
+		return block + sizeof(std::size_t);
+	}
+
+	static std::size_t heap_capacity(char const * data)
+	{
+		std::size_t cap;
+		std::memcpy(& cap, data - sizeof(std::size_t), sizeof(cap));
+		return cap;
+	}
+
+	void release()
+	{
+		if (is_long())
+			delete[] (_rep.l.data - sizeof(std::size_t));
+	}
+
+	// Initializes a string under construction with n chars at s
+	void assign_new(char const * s, std::size_t n)
+	{
+		if (n <= sso_capacity)
+		{
+			std::memcpy(_rep.s.data, s, n);
+			set_short(n);
+		}
+		else
+		{
+			char * d = allocate(n);
+			std::memcpy(d, s, n);
+			d[n] = '\0';
+			set_long(d, n);
+		}
+	}
+
+	// Overwrites the contents with n chars at s
+	// @pre n <= capacity()
+	void copy_into(char const * s, std::size_t n)
+	{
+		char * d = data();
+		std::memmove(d, s, n);
+		d[n] = '\0';
+		set_size(n);
+	}
+
+	rep _rep;
+};
+
+/**
+ * Hashes the same chars as hash<std::string>, and is transparent as well, so a
+ * flat_hash_map<my::string, V> can be searched with a std::string_view, a "literal"
+ * or a std::string without creating a temporary my::string.
+ */
+template <>
+struct hash<string>
+{
+	using is_transparent = void;
+
+	std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+};
+} // namespace my
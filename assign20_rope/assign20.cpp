@@ -0,0 +1,209 @@
+#include "myrope.h"
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+
+
+
+// Flattened copy of r, without modifying r
+static std::string str(my::rope const & r)
+{
+	std::string s(r.size(), ' ');
+	r.copy(& s[0]);
+	return s;
+}
+
+int main()
+{
+	using namespace my;
+
+	{// Test rope()
+		rope r;
+
+		assert(r.size() == 0);
+		assert(r.empty());
+		assert(r.flatten().empty());
+	}
+
+	{// Test rope(string_view)/operator[]
+		rope r("hello world");
+
+		assert(r.size() == 11);
+		assert(r[0] == 'h' && r[10] == 'd');
+		assert(r.height() == 0);
+	}
+
+	{// Test append()/operator+
+		rope a("hello"), b(" "), c("world");
+		rope d = a + b + c;
+
+		assert(str(d) == "hello world");
+		assert(str(a) == "hello"); // unchanged
+
+		std::string big(1000, 'x');
+		rope e(big);
+		e += rope(big);
+		assert(e.size() == 2000 && e.height() == 1); // no merging of large leaves
+	}
+
+	{// Test insert()/erase()/substr() against std::string
+		std::mt19937 rng(42);
+		std::string ref(5000, ' ');
+		for (char & ch : ref)
+			ch = char('a' + rng() % 26);
+		rope r(ref);
+
+		for (int i = 0; i < 2000; i++)
+		{
+			std::size_t const pos = rng() % (ref.size() + 1);
+			if (rng() % 2)
+			{
+				std::string s(rng() % 600, char('A' + i % 26));
+				r.insert(pos, s);
+				ref.insert(pos, s);
+			}
+			else
+			{
+				std::size_t const n = rng() % (ref.size() - pos + 1) % 300;
+				r.erase(pos, n);
+				ref.erase(pos, n);
+			}
+
+			assert(r.size() == ref.size());
+			if (!ref.empty())
+			{
+				std::size_t const k = rng() % ref.size();
+				assert(r[k] == ref[k]);
+			}
+		}
+
+		assert(str(r) == ref);
+
+		// balanced: AVL height bound (1.44 log2 of the number of leaves), leaves are
+		// at least 1 char, but there are at most 2 per edit + the original one
+		assert(r.height() <= 1.45 * std::log2(2 * 2000 + 1) + 2);
+
+		std::size_t const pos = ref.size() / 3;
+		rope sub = r.substr(pos, ref.size() / 3);
+		assert(str(sub) == ref.substr(pos, ref.size() / 3));
+		assert(str(r) == ref); // unchanged
+
+		std::string_view flat = r.flatten();
+		assert(flat == ref);
+		assert(r.height() == 0);
+		assert(str(sub) == ref.substr(pos, ref.size() / 3)); // unaffected by flatten()
+	}
+
+	{// Test copies share the text but are independent
+		rope a("The quick brown fox");
+		rope b = a;
+		b.erase(4, 6);
+		b.insert(0, "See: ");
+
+		assert(str(a) == "The quick brown fox");
+		assert(str(b) == "See: The brown fox");
+	}
+
+	{// Test small leaves are merged
+		rope r;
+		for (int i = 0; i < 1000; i++)
+			r += "x";
+
+		assert(r.size() == 1000);
+		assert(r.height() <= 4); // 1000 / 256 leaves
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	std::size_t const DOC = 100'000'000; // 100 MB document, might need to adjust slightly for your machine
+	int const EDITS = 200;
+
+	std::string text(DOC, ' ');
+	{
+		std::mt19937 rng(1);
+		for (char & ch : text)
+			ch = char('a' + rng() % 26);
+	}
+
+	std::chrono::high_resolution_clock c;
+	std::string s;
+	rope r;
+
+	auto t1 = c.now();
+	for (std::size_t i = 0; i < DOC; i += 1'000'000)
+		s.append(text, i, 1'000'000);
+	auto t2 = c.now();
+	std::cout << "tBuild (std::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+	t1 = c.now();
+	for (std::size_t i = 0; i < DOC; i += 1'000'000)
+		r += std::string_view(text).substr(i, 1'000'000);
+	t2 = c.now();
+	std::cout << "tBuild (rope): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl << std::endl;
+
+	{// Random small edits: insert a word, erase a few chars, copy a paragraph elsewhere
+		std::mt19937 rng(2);
+		t1 = c.now();
+		for (int i = 0; i < EDITS; i++)
+		{
+			s.insert(rng() % s.size(), "inserted");
+			s.erase(rng() % (s.size() - 100), 50);
+			std::size_t const from = rng() % (s.size() - 1000);
+			s.insert(rng() % s.size(), s.substr(from, 1000));
+		}
+		t2 = c.now();
+		std::cout << "tEdit (std::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		rng.seed(2);
+		t1 = c.now();
+		for (int i = 0; i < EDITS; i++)
+		{
+			r.insert(rng() % r.size(), "inserted");
+			r.erase(rng() % (r.size() - 100), 50);
+			std::size_t const from = rng() % (r.size() - 1000);
+			r.insert(rng() % r.size(), r.substr(from, 1000));
+		}
+		t2 = c.now();
+		std::cout << "tEdit (rope): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, height " << r.height() << std::endl << std::endl;
+	}
+
+	{// Keep a copy of the document (e.g. for undo)
+		t1 = c.now();
+		std::string s2 = s;
+		t2 = c.now();
+		std::cout << "tCopy (std::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		rope r2 = r;
+		t2 = c.now();
+		std::cout << "tCopy (rope): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl << std::endl;
+	}
+
+	{// Read the whole document
+		std::size_t sum1 = 0, sum2 = 0;
+
+		t1 = c.now();
+		for (char ch : s)
+			sum1 += ch;
+		t2 = c.now();
+		std::cout << "tScan (std::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		r.for_each_chunk([&](std::string_view v) { for (char ch : v) sum2 += ch; });
+		t2 = c.now();
+		std::cout << "tScan (rope::for_each_chunk): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		std::string_view flat = r.flatten();
+		t2 = c.now();
+		std::cout << "tFlatten (rope): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << sum1 - sum2 + (flat != s) << ", should be 0)" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,329 @@
+#pragma once
+
+#include "myarray.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+
+
+namespace my {
+/**
+ * Immutable sequence of chars for large texts that are edited a lot (a simplified
+ * version of SGI's rope): a balanced binary tree whose leaves are views into
+ * chunks of text.
+ *
+ * Chunks (my::array<char>, the memory_block of assignment 2) are never modified once
+ * written and are shared through reference counting, and so are the tree's nodes.
+ * Therefore an edit never copies the text: insert()/erase()/concatenation split
+ * and join trees in O(log n), copying a rope is O(1), and substr() returns a rope
+ * sharing the chunks of the original.
+ *
+ * The price is access: operator[] is O(log n), and reading the text sequentially
+ * hops from leaf to leaf (for_each_chunk()). flatten() copies the text into a single
+ * chunk once it has to be contiguous.
+ */
+class rope
+{
+public:
+	/**
+	 * Concatenating two leaves smaller than this copies them into a new chunk instead
+	 * of creating a node, so appending one char at a time doesn't create a tree of chars.
+	 */
+	static std::size_t constexpr small_leaf = 256;
+
+	/**
+	 * Constructor, creates an empty rope.
+	 * @exception no-throw
+	 */
+	rope() {}
+
+	/**
+	 * Constructor, copies the text 's' into a new chunk.
+	 * @exception might throw if not enough memory is available
+	 */
+	explicit rope(std::string_view s) : _root(make_leaf(s)) {}
+
+	/**
+	 * Copy constructor/assignment operator, shares all of the text: O(1).
+	 * @exception no-throw
+	 */
+	rope(rope const &) = default;
+	rope & operator=(rope const &) = default;
+	rope(rope &&) noexcept = default;
+	rope & operator=(rope &&) noexcept = default;
+
+	/**
+	 * @return Number of chars
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _root ? _root->size : 0; }
+	bool empty() const { return size() == 0; }
+
+	/**
+	 * @return Height of the tree (0 if the text is a single leaf), O(log(number of leaves))
+	 * @exception no-throw
+	 */
+	std::size_t height() const { return _root ? _root->height : 0; }
+
+	/**
+	 * @return Char i, O(log n)
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	char operator[](std::size_t i) const
+	{
+		assert(i < size());
+		node const * n = _root.get();
+		while (!n->is_leaf())
+		{
+			if (i < n->left->size)
+				n = n->left.get();
+			else
+			{
+				i -= n->left->size;
+				n = n->right.get();
+			}
+		}
+		return n->chunk->data()[n->offset + i];
+	}
+
+	/**
+	 * Appends 'rhs', shares its text: O(log n).
+	 * @exception might throw if not enough memory is available. Provides strong exception safety.
+	 */
+	rope & append(rope const & rhs)
+	{
+		_root = join(_root, rhs._root);
+		return * this;
+	}
+	rope & operator+=(rope const & rhs) { return append(rhs); }
+	rope & operator+=(std::string_view s) { return append(rope(s)); }
+
+	friend rope operator+(rope lhs, rope const & rhs) { return lhs.append(rhs); }
+
+	/**
+	 * Inserts 'r' before position pos, O(log n).
+	 * @pre pos <= size()
+	 * @exception might throw if not enough memory is available. Provides strong exception safety.
+	 */
+	void insert(std::size_t pos, rope const & r)
+	{
+		assert(pos <= size());
+		auto parts = split(_root, pos);
+		_root = join(join(parts.first, r._root), parts.second);
+	}
+	void insert(std::size_t pos, std::string_view s) { insert(pos, rope(s)); }
+
+	/**
+	 * Removes n chars starting at pos, O(log n).
+	 * @pre pos + n <= size()
+	 * @exception might throw if not enough memory is available. Provides strong exception safety.
+	 */
+	void erase(std::size_t pos, std::size_t n)
+	{
+		assert(pos <= size() && n <= size() - pos);
+		auto left = split(_root, pos);
+		auto right = split(left.second, n);
+		_root = join(left.first, right.second);
+	}
+
+	/**
+	 * @return The n chars starting at pos, sharing the chunks of this rope: O(log n),
+	 * no matter how large n is.
+	 * @pre pos + n <= size()
+	 * @exception might throw if not enough memory is available
+	 */
+	rope substr(std::size_t pos, std::size_t n) const
+	{
+		assert(pos <= size() && n <= size() - pos);
+		rope r;
+		r._root = split(split(_root, pos).second, n).first;
+		return r;
+	}
+
+	/**
+	 * Calls f(std::string_view) for every leaf in order: the fastest way to read the text.
+	 * @exception whatever f throws
+	 */
+	template <typename F>
+	void for_each_chunk(F && f) const
+	{
+		if (_root)
+			for_each_chunk(_root.get(), f);
+	}
+
+	/**
+	 * Copies all chars to 'out'.
+	 * @pre out has room for size() chars
+	 * @exception no-throw
+	 */
+	void copy(char * out) const
+	{
+		for_each_chunk([&](std::string_view s) { out = std::copy(s.begin(), s.end(), out); });
+	}
+
+	/**
+	 * Makes the text contiguous: copies it into a single chunk, unless it already is one.
+	 * Other ropes sharing the old chunks are unaffected.
+	 * @return View of the text, valid until this rope is modified or destroyed
+	 * @exception might throw if not enough memory is available. Provides strong exception safety.
+	 */
+	std::string_view flatten()
+	{
+		if (!_root)
+			return std::string_view();
+
+		if (!_root->is_leaf())
+		{
+			auto chunk = std::make_shared<array<char>>(size());
+			copy(chunk->data());
+			_root = std::make_shared<node>(std::move(chunk), 0, size());
+		}
+		return std::string_view(_root->chunk->data() + _root->offset, _root->size);
+	}
+
+private:
+	struct node;
+	using node_ptr = std::shared_ptr<node const>;
+	using chunk_ptr = std::shared_ptr<array<char> const>;
+
+	/*
+	 * Either a leaf, viewing chunk[offset, offset + size), or an inner node
+	 * concatenating left and right. Inner nodes are kept balanced like an AVL
+	 * tree: the heights of their children differ by at most 1.
+	 */
+	struct node
+	{
+		node(chunk_ptr c, std::size_t off, std::size_t n) :
+			size(n), height(0), chunk(std::move(c)), offset(off) {}
+
+		node(node_ptr l, node_ptr r) :
+			size(l->size + r->size), height(std::max(l->height, r->height) + 1),
+			left(std::move(l)), right(std::move(r)), offset(0) {}
+
+		bool is_leaf() const { return chunk != nullptr; }
+
+		std::size_t size;
+		std::size_t height;
+		node_ptr left, right;	// inner node
+		chunk_ptr chunk;	// leaf
+		std::size_t offset;	// leaf
+	};
+
+	static std::size_t height(node_ptr const & n) { return n ? n->height : 0; }
+
+	static node_ptr make_leaf(std::string_view s)
+	{
+		if (s.empty())
+			return nullptr;
+
+		auto chunk = std::make_shared<array<char>>(s.size());
+		std::copy(s.begin(), s.end(), chunk->data());
+		return std::make_shared<node>(std::move(chunk), 0, s.size());
+	}
+
+	static std::string_view view(node const & leaf)
+	{
+		return std::string_view(leaf.chunk->data() + leaf.offset, leaf.size);
+	}
+
+	// Chars [pos, pos + n) of a leaf, shares its chunk
+	static node_ptr sub_leaf(node_ptr const & leaf, std::size_t pos, std::size_t n)
+	{
+		if (n == 0)
+			return nullptr;
+		if (n == leaf->size)
+			return leaf;
+		return std::make_shared<node>(leaf->chunk, leaf->offset + pos, n);
+	}
+
+	// Node (a, b), rotated once or twice if a and b's heights differ by 2
+	static node_ptr balance(node_ptr const & a, node_ptr const & b)
+	{
+		if (a->height > b->height + 1)
+		{
+			if (a->left->height >= a->right->height)
+				return std::make_shared<node>(a->left, std::make_shared<node>(a->right, b));
+
+			node_ptr const & ar = a->right;
+			return std::make_shared<node>(std::make_shared<node>(a->left, ar->left), std::make_shared<node>(ar->right, b));
+		}
+		if (b->height > a->height + 1)
+		{
+			if (b->right->height >= b->left->height)
+				return std::make_shared<node>(std::make_shared<node>(a, b->left), b->right);
+
+			node_ptr const & bl = b->left;
+			return std::make_shared<node>(std::make_shared<node>(a, bl->left), std::make_shared<node>(bl->right, b->right));
+		}
+		return std::make_shared<node>(a, b);
+	}
+
+	/*
+	 * Concatenation of a and b (AVL join): descends along the right spine of the
+	 * taller tree until the heights match, then rebalances on the way back up.
+	 * O(|height(a) - height(b)|)
+	 */
+	static node_ptr join(node_ptr const & a, node_ptr const & b)
+	{
+		if (!a)
+			return b;
+		if (!b)
+			return a;
+
+		if (a->is_leaf() && b->is_leaf() && a->size + b->size <= small_leaf)
+		{
+			auto chunk = std::make_shared<array<char>>(a->size + b->size);
+			std::string_view const va = view(* a), vb = view(* b);
+			std::copy(vb.begin(), vb.end(), std::copy(va.begin(), va.end(), chunk->data()));
+			return std::make_shared<node>(std::move(chunk), 0, a->size + b->size);
+		}
+
+		if (a->height > b->height + 1)
+			return balance(a->left, join(a->right, b));
+		if (b->height > a->height + 1)
+			return balance(join(a, b->left), b->right);
+		return std::make_shared<node>(a, b);
+	}
+
+	// Splits n into [0, pos) and [pos, size), O(log n)
+	static std::pair<node_ptr, node_ptr> split(node_ptr const & n, std::size_t pos)
+	{
+		if (!n || pos == 0)
+			return { nullptr, n };
+		if (pos == n->size)
+			return { n, nullptr };
+
+		if (n->is_leaf())
+			return { sub_leaf(n, 0, pos), sub_leaf(n, pos, n->size - pos) };
+
+		if (pos < n->left->size)
+		{
+			auto parts = split(n->left, pos);
+			return { parts.first, join(parts.second, n->right) };
+		}
+		auto parts = split(n->right, pos - n->left->size);
+		return { join(n->left, parts.first), parts.second };
+	}
+
+	template <typename F>
+	static void for_each_chunk(node const * n, F & f)
+	{
+		if (n->is_leaf())
+			f(view(* n));
+		else
+		{
+			for_each_chunk(n->left.get(), f);
+			for_each_chunk(n->right.get(), f);
+		}
+	}
+
+	node_ptr _root;
+};
+} // namespace my
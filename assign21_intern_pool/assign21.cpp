@@ -0,0 +1,148 @@
+#include "myintern_pool.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+
+int main()
+{
+	using namespace my;
+
+	{// Test intern_pool()
+		intern_pool p;
+
+		assert(p.size() == 0);
+	}
+
+	{// Test intern()/str()
+		intern_pool p;
+		auto a = p.intern("apple");
+		auto b = p.intern("banana");
+		auto c = p.intern(std::string("apple"));
+		auto e = p.intern("");
+
+		assert(a == c && a != b && a != e);
+		assert(p.size() == 3);
+		assert(p.str(a) == "apple" && p.str(b) == "banana" && p.str(e).empty());
+
+		std::string const big(100'000, 'x'); // longer than a page
+		auto d = p.intern(big);
+		assert(p.str(d) == big);
+		assert(p.intern(big) == d);
+		assert(p.str(a) == "apple"); // earlier strings are unaffected
+	}
+
+	{// Test many strings, views remain valid
+		intern_pool p;
+		std::vector<intern_pool::handle> handles;
+		std::vector<std::string_view> views;
+		for (int i = 0; i < 100'000; i++)
+		{
+			handles.push_back(p.intern("tag" + std::to_string(i)));
+			views.push_back(p.str(handles.back()));
+		}
+
+		assert(p.size() == 100'000);
+		for (int i = 0; i < 100'000; i++)
+		{
+			assert(p.intern("tag" + std::to_string(i)) == handles[i]);
+			assert(views[i] == "tag" + std::to_string(i)); // never moved
+		}
+		assert(p.memory() > 100'000 * 4);
+	}
+
+	{// Test concurrent intern(): all threads get the same handles
+		intern_pool p;
+		int const N = 20'000, THREADS = 4;
+		std::vector<std::vector<intern_pool::handle>> handles(THREADS, std::vector<intern_pool::handle>(N));
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < THREADS; t++)
+			threads.emplace_back([&, t]() {
+				for (int i = 0; i < N; i++)
+				{
+					int const k = t % 2 ? i : N - 1 - i; // half of the threads in reverse order
+					handles[t][k] = p.intern("host-" + std::to_string(k));
+				}
+			});
+		for (auto & t : threads)
+			t.join();
+
+		assert(p.size() == N);
+		for (int i = 0; i < N; i++)
+		{
+			for (int t = 1; t < THREADS; t++)
+				assert(handles[t][i] == handles[0][i]);
+			assert(p.str(handles[0][i]) == "host-" + std::to_string(i));
+		}
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 50'000'000; // might need to adjust slightly for your machine
+	int const UNIQUE = ITER / 100;
+
+	// Hostnames, too long for std::string's small string optimization
+	std::vector<std::string> hosts;
+	for (int i = 0; i < UNIQUE; i++)
+		hosts.push_back("srv-" + std::to_string(1'000'000 + i) + ".example.com");
+
+	std::chrono::high_resolution_clock c;
+	std::size_t equal1 = 0, equal2 = 0;
+
+	{// Records storing std::string
+		std::mt19937 rng(1);
+		auto t1 = c.now();
+		std::vector<std::string> records;
+		records.reserve(ITER);
+		for (int i = 0; i < ITER; i++)
+			records.push_back(hosts[rng() % UNIQUE]);
+		auto t2 = c.now();
+		std::cout << "tBuild (std::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		std::size_t bytes = records.size() * sizeof(std::string);
+		for (auto const & s : records)
+			if (s.data() < reinterpret_cast<char const *>(& s) || s.data() >= reinterpret_cast<char const *>(& s + 1))
+				bytes += s.capacity() + 1; // heap-allocated
+		std::cout << "Memory (std::string): " << bytes / (1024 * 1024) << "MB" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			equal1 += records[i] == records[(i + UNIQUE) % ITER];
+		t2 = c.now();
+		std::cout << "tCompare (std::string): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl << std::endl;
+	}
+
+	{// Records storing handles
+		std::mt19937 rng(1);
+		intern_pool pool;
+		auto t1 = c.now();
+		std::vector<intern_pool::handle> records;
+		records.reserve(ITER);
+		for (int i = 0; i < ITER; i++)
+			records.push_back(pool.intern(hosts[rng() % UNIQUE]));
+		auto t2 = c.now();
+		std::cout << "tBuild (intern_pool): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		std::size_t const bytes = records.size() * sizeof(intern_pool::handle) + pool.memory();
+		std::cout << "Memory (intern_pool): " << bytes / (1024 * 1024) << "MB (" << pool.size() << " unique strings, "
+			<< pool.memory() / (1024 * 1024) << "MB pool)" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			equal2 += records[i] == records[(i + UNIQUE) % ITER];
+		t2 = c.now();
+		std::cout << "tCompare (intern_pool): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+	}
+
+	std::cout << "(checksum " << equal1 - equal2 << ", should be 0)" << std::endl;
+
+	return 0;
+}
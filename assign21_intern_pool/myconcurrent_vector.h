@@ -0,0 +1,200 @@
+#pragma once
+
+#include "myarray.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+
+
+namespace my {
+/**
+ * Append-only, thread-safe growable list of elements.
+ *
+ * Unlike my::vector, which copies all its elements into a bigger array when it grows,
+ * concurrent_vector never moves an element once it has been constructed. It grows by
+ * adding segments to a fixed-size segment table: segment k is a my::array of
+ * first_segment_size * 2^k elements holding the indices
+ * [first_segment_size * (2^k - 1), first_segment_size * (2^(k+1) - 1)).
+ * Thus references/pointers to elements stay valid for the lifetime of the container
+ * and the number of segments grows only logarithmically with the number of elements.
+ *
+ * Threads reserve indices with a single fetch_add (wait-free) and then write their
+ * element without any further synchronization.
+ *
+ * @invariant size() <= capacity() once all push_back() calls have returned
+ */
+template <typename T>
+class concurrent_vector
+{
+public:
+	/**
+	 * Constructor, creates an empty vector.
+	 * @exception no-throw
+	 * @post size() == capacity() == 0
+	 */
+	concurrent_vector()
+	{
+		for (auto & s : _segments)
+			s.store(nullptr, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Destructor, frees all segments.
+	 * @pre No other thread accesses the vector anymore.
+	 * @exception no-throw
+	 */
+	~concurrent_vector()
+	{
+		for (auto & s : _segments)
+			delete s.load(std::memory_order_relaxed);
+	}
+
+	// Copying while other threads are appending can't produce a consistent result.
+	concurrent_vector(concurrent_vector const &) = delete;
+	concurrent_vector & operator=(concurrent_vector const &) = delete;
+
+	/**
+	 * @return Number of elements appended so far (a snapshot). Elements whose push_back()
+	 * has not returned yet are included: another thread may only read element i after
+	 * the thread that appended it has handed it over (e.g. via the returned index).
+	 * @exception no-throw
+	 */
+	std::size_t size() const
+	{
+		return _size.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @return Number of elements that can be stored without allocating another segment
+	 * @exception no-throw
+	 */
+	std::size_t capacity() const
+	{
+		std::size_t result = 0;
+		for (std::size_t k = 0; k < max_segments && _segments[k].load(std::memory_order_acquire); k++)
+			result += segment_size(k);
+
+		return result;
+	}
+
+	/**
+	 * @return Element at index i
+	 * @pre i < size() and the element has been fully written
+	 * @exception no-throw
+	 */
+	T & operator[](std::size_t i)
+	{
+		std::size_t const k = segment_of(i);
+		return (*_segments[k].load(std::memory_order_acquire))[i - segment_begin(k)];
+	}
+	T const & operator[](std::size_t i) const
+	{
+		std::size_t const k = segment_of(i);
+		return (*_segments[k].load(std::memory_order_acquire))[i - segment_begin(k)];
+	}
+
+	/**
+	 * Appends the element 'val' to the end of this vector, allocates a new segment
+	 * if necessary. Safe to call from any number of threads concurrently.
+	 * @return Index of the newly appended element
+	 * @exception might throw if not enough memory is available for a new segment or if
+	 * T's copy assignment operator throws. The reserved element then remains default
+	 * constructed (or unallocated until another thread allocates its segment).
+	 * @post references to all other elements remain valid
+	 */
+	std::size_t push_back(T const & val)
+	{
+		std::size_t const i = _size.fetch_add(1, std::memory_order_acq_rel);
+		std::size_t const k = segment_of(i);
+		assert(k < max_segments);
+
+		(*acquire_segment(k))[i - segment_begin(k)] = val;
+		return i;
+	}
+
+	/**
+	 * Allocates the segments for the first n elements, so push_back() doesn't need
+	 * to allocate until size() reaches n. Safe to call concurrently with push_back().
+	 * @exception might throw if not enough memory is available (the vector remains unchanged)
+	 * @post capacity() >= n
+	 */
+	void reserve(std::size_t n)
+	{
+		for (std::size_t k = 0; k < max_segments && segment_begin(k) < n; k++)
+			if (!_segments[k].load(std::memory_order_acquire))
+				publish_segment(k, new array<T>(segment_size(k)));
+	}
+
+	/**
+	 * Removes the last element, to take back a push_back() whose index was never handed out.
+	 * @pre size() > 0, no push_back() runs concurrently, nobody reads the last element
+	 * @exception no-throw
+	 * @post size() shrinks by 1
+	 */
+	void pop_back()
+	{
+		assert(size() > 0);
+		_size.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+private:
+	// 2^6 * (2^58 - 1) elements are more than we could ever address.
+	static constexpr std::size_t first_segment_log2 = 6;
+	static constexpr std::size_t first_segment_size = std::size_t(1) << first_segment_log2;
+	static constexpr std::size_t max_segments = 58;
+
+	// Segment k starts at index first_segment_size * (2^k - 1)
+	static std::size_t segment_begin(std::size_t k)
+	{
+		return first_segment_size * ((std::size_t(1) << k) - 1);
+	}
+
+	static std::size_t segment_size(std::size_t k)
+	{
+		return first_segment_size << k;
+	}
+
+	// = floor(log2(i / first_segment_size + 1))
+	static std::size_t segment_of(std::size_t i)
+	{
+		std::size_t x = (i >> first_segment_log2) + 1;
+		std::size_t k = 0;
+		while (x >>= 1)
+			k++;
+
+		return k;
+	}
+
+	/**
+	 * @return Segment k. Every thread that finds it missing allocates it and tries to
+	 * publish its copy, the losers delete theirs. Nobody ever waits for another thread,
+	 * so a failed allocation only throws to its own caller. Threads racing past a segment
+	 * boundary might allocate it more than once, the extra copies are freed right away.
+	 */
+	array<T> * acquire_segment(std::size_t k)
+	{
+		array<T> * seg = _segments[k].load(std::memory_order_acquire);
+		if (seg)
+			return seg;
+
+		return publish_segment(k, new array<T>(segment_size(k)));
+	}
+
+	// Publishes 'seg' as segment k, unless another thread or reserve() got there first
+	// @return The published segment
+	array<T> * publish_segment(std::size_t k, array<T> * seg)
+	{
+		array<T> * expected = nullptr;
+		if (_segments[k].compare_exchange_strong(expected, seg, std::memory_order_acq_rel))
+			return seg;
+
+		delete seg;
+		return expected;
+	}
+
+	std::atomic<std::size_t> _size{0};
+	std::atomic<array<T> *> _segments[max_segments];
+};
+} // namespace my
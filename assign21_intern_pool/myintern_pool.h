@@ -0,0 +1,198 @@
+#pragma once
+
+#include "myarray.h"
+#include "myconcurrent_vector.h"
+#include "myhash_map.h"
+#include "myvector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+
+
+
+namespace my {
+/**
+ * Thread-safe pool of unique strings (string interning).
+ *
+ * intern(s) stores every distinct string exactly once and returns a 32 bit handle
+ * for it: the same string always yields the same handle. Records can store 4 byte
+ * handles instead of strings, and comparing two of them for equality is a single
+ * integer comparison instead of a memcmp() behind two pointers.
+ *
+ * The chars are stored back to back in 64 KB arena pages (no per-string allocation
+ * or header), a flat_hash_map maps them (and their hash) to their handles. Both are
+ * split into 16 shards, chosen by the string's hash, each guarded by its own mutex:
+ * threads interning different strings rarely wait for each other. Translating a handle back
+ * (str()) doesn't lock at all.
+ *
+ * Strings are never removed, all string_views returned by str() remain valid for
+ * the lifetime of the pool.
+ */
+class intern_pool
+{
+	static unsigned constexpr shard_bits = 4;
+	static unsigned constexpr index_bits = 32 - shard_bits;
+
+public:
+	static std::size_t constexpr shards = std::size_t(1) << shard_bits;
+	static std::size_t constexpr page_size = 64 * 1024;
+
+	/**
+	 * Identifies an interned string: the shard in the upper 4 bits, the index
+	 * of the string within its shard in the lower 28 bits.
+	 */
+	class handle
+	{
+	public:
+		handle() : _id(0) {}
+		std::uint32_t id() const { return _id; }
+
+		friend bool operator==(handle a, handle b) { return a._id == b._id; }
+		friend bool operator!=(handle a, handle b) { return a._id != b._id; }
+		friend bool operator<(handle a, handle b) { return a._id < b._id; } // not alphabetical!
+
+	private:
+		friend class intern_pool;
+		explicit handle(std::uint32_t id) : _id(id) {}
+
+		std::uint32_t _id;
+	};
+
+	intern_pool() = default;
+	intern_pool(intern_pool const &) = delete;
+	intern_pool & operator=(intern_pool const &) = delete;
+
+	/**
+	 * @return The handle of 's', copies 's' into the pool if it isn't there yet.
+	 * Safe to call from any number of threads concurrently.
+	 * @exception might throw if not enough memory is available (the pool remains unchanged)
+	 * or std::length_error if a shard would hold more than 2^28 strings.
+	 */
+	handle intern(std::string_view s)
+	{
+		std::size_t const h = std::hash<std::string_view>()(s);
+		std::size_t const k = h >> (sizeof(std::size_t) * 8 - shard_bits);
+		shard & sh = _shards[k];
+
+		std::lock_guard<std::mutex> lock(sh.mutex);
+		auto it = sh.index.find(hashed{ s, h });
+		if (it != sh.index.end())
+			return handle(it->second);
+
+		std::size_t const i = sh.strings.size();
+		if (i >> index_bits)
+			throw std::length_error("intern_pool: too many strings");
+
+		std::uint32_t const id = static_cast<std::uint32_t>(k << index_bits | i);
+		std::string_view const stored = sh.store(s); // if anything below throws, the stored chars are unreferenced but harmless
+		sh.strings.reserve(i + 1); // push_back() can't throw anymore
+		sh.strings.push_back(stored);
+		try
+		{
+			sh.index.insert(hashed{ stored, h }, id);
+		}
+		catch (...)
+		{
+			sh.strings.pop_back(); // id was never handed out, the next string gets it
+			throw;
+		}
+		_size.fetch_add(1, std::memory_order_relaxed);
+
+		return handle(id);
+	}
+
+	/**
+	 * @return The string of handle h, lock-free
+	 * @pre h was returned by intern() of this pool (and handed over to this thread)
+	 * @exception no-throw
+	 */
+	std::string_view str(handle h) const
+	{
+		return _shards[h._id >> index_bits].strings[h._id & ((std::uint32_t(1) << index_bits) - 1)];
+	}
+
+	/**
+	 * @return Number of unique strings (a snapshot)
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size.load(std::memory_order_relaxed); }
+
+	/**
+	 * @return Memory used in bytes: arena pages, hash tables and handle -> string tables
+	 * @exception no-throw
+	 */
+	std::size_t memory() const
+	{
+		std::size_t bytes = sizeof(* this);
+		for (auto & sh : _shards)
+		{
+			std::lock_guard<std::mutex> lock(sh.mutex);
+			bytes += sh.arena_bytes + sh.pages.capacity() * sizeof(array<char>);
+			bytes += sh.index.capacity() * (sizeof(std::pair<hashed, std::uint32_t>) + 1);
+			bytes += sh.strings.capacity() * sizeof(std::string_view);
+		}
+		return bytes;
+	}
+
+private:
+	// Key of the hash tables: the hash is computed once (it also selects the shard) and
+	// compared before the chars, so probing past other keys doesn't touch their chars.
+	struct hashed
+	{
+		std::string_view str;
+		std::size_t hash;
+
+		friend bool operator==(hashed const & a, hashed const & b) { return a.hash == b.hash && a.str == b.str; }
+	};
+
+	struct hashed_hash
+	{
+		std::size_t operator()(hashed const & k) const { return k.hash; }
+	};
+
+	struct shard
+	{
+		shard() : pages(), used(page_size), arena_bytes(0) {}
+
+		// Copies s into the current page, starts a new one if it doesn't fit.
+		// Strings longer than a page get a page of their own.
+		std::string_view store(std::string_view s)
+		{
+			if (s.empty())
+				return std::string_view();
+
+			if (used + s.size() > page_size)
+			{
+				array<char> page(std::max(page_size, s.size()));
+				std::size_t const n = pages.size();
+				pages.resize(n + 1); // might throw, nothing changed yet
+				pages[n] = std::move(page);
+				arena_bytes += pages[n].size();
+				used = 0;
+			}
+
+			char * dst = pages[pages.size() - 1].data() + used;
+			std::copy(s.begin(), s.end(), dst);
+			used += s.size();
+			return std::string_view(dst, s.size());
+		}
+
+		mutable std::mutex mutex;
+		vector<array<char>> pages;	// arena, chars never move (array's buffers are moved, not copied, on reallocation)
+		std::size_t used;		// chars used in the last page
+		std::size_t arena_bytes;
+		flat_hash_map<hashed, std::uint32_t, hashed_hash> index;
+		concurrent_vector<std::string_view> strings; // index within shard -> string, readable without locking
+	};
+
+	shard _shards[shards];
+	std::atomic<std::size_t> _size{0};
+};
+} // namespace my
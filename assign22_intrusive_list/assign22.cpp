@@ -0,0 +1,265 @@
+#include "myintrusive_list.h"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <vector>
+
+
+
+// The list of assignment 7 (see assign07_solution.cpp): one 'new'ed node per int
+class list
+{
+private:
+	struct node
+	{
+		node * next = nullptr;
+		int value = 0;
+	};
+
+	node * _head = new node;
+
+public:
+	~list()
+	{
+		while (_head)
+		{
+			node * tmp = _head;
+			_head = _head->next;
+			delete tmp;
+		}
+	}
+
+	int size() const
+	{
+		int result = 0;
+		for (node * tail = _head; tail->next != nullptr; tail = tail->next, result++);
+
+		return result;
+	}
+
+	void append(int x)
+	{
+		insert(size(), x);
+	}
+
+	void insert(int i, int x)
+	{
+		node * n = new node;
+		n->value = x;
+
+		node * pos = _head;
+		while (i-- > 0) pos = pos->next;
+
+		n->next = pos->next;
+		pos->next = n;
+	}
+
+	int at(int i)
+	{
+		node * pos = _head;
+		while (i-- >= 0) pos = pos->next;
+
+		return pos->value;
+	}
+};
+
+// An object living in a vector, linked into lists through its hooks
+struct item
+{
+	int value = 0;
+	my::list_hook hook;
+	my::list_hook other_hook;
+	my::slist_hook shook;
+};
+
+int main()
+{
+	using namespace my;
+	using item_list = intrusive_list<item, & item::hook>;
+
+	{// Test intrusive_list()
+		item_list l;
+
+		assert(l.size() == 0);
+		assert(l.empty());
+		assert(l.begin() == l.end());
+	}
+
+	{// Test push_back()/push_front()/insert()/iteration
+		std::vector<item> items(5);
+		for (int i = 0; i < 5; i++)
+			items[i].value = i;
+
+		item_list l;
+		l.push_back(items[1]);
+		l.push_back(items[2]);
+		l.push_front(items[0]);
+		l.insert(l.iterator_to(items[2]), items[3]);
+		l.insert(l.end(), items[4]);
+
+		assert(l.size() == 5);
+		int const expected[] = { 0, 1, 3, 2, 4 };
+		int k = 0;
+		for (item const & x : l)
+			assert(x.value == expected[k++]);
+		for (auto it = l.end(); it != l.begin();)
+			assert((--it)->value == expected[--k]);
+		assert(l.front().value == 0 && l.back().value == 4);
+		assert(items[3].hook.is_linked());
+	}
+
+	{// Test erase() by reference, pop_front()/pop_back(), destructor unlinks
+		std::vector<item> items(4);
+		{
+			item_list l;
+			for (auto & x : items)
+				l.push_back(x);
+
+			l.erase(items[2]); // O(1), no search
+			assert(l.size() == 3 && !items[2].hook.is_linked());
+			assert(std::next(l.iterator_to(items[1])) == l.iterator_to(items[3]));
+
+			l.pop_front();
+			l.pop_back();
+			assert(l.size() == 1 && & l.front() == & items[1]);
+		}
+		assert(!items[1].hook.is_linked());
+	}
+
+	{// Test splice(), one object in two lists
+		std::vector<item> items(6);
+		item_list a, b;
+		intrusive_list<item, & item::other_hook> all;
+		for (int i = 0; i < 6; i++)
+		{
+			items[i].value = i;
+			(i < 3 ? a : b).push_back(items[i]);
+			all.push_front(items[i]);
+		}
+
+		a.splice(a.iterator_to(items[1]), b);
+		assert(a.size() == 6 && b.empty());
+		int const expected[] = { 0, 3, 4, 5, 1, 2 };
+		int k = 0;
+		for (item const & x : a)
+			assert(x.value == expected[k++]);
+
+		a.splice(a.begin(), a, a.iterator_to(items[2]));
+		assert(a.front().value == 2 && a.back().value == 1 && a.size() == 6);
+
+		item_list c(std::move(a));
+		assert(c.size() == 6 && a.empty());
+
+		assert(all.size() == 6 && all.front().value == 5); // unaffected
+	}
+
+	{// Test intrusive_slist
+		std::vector<item> items(4);
+		intrusive_slist<item, & item::shook> l;
+		for (int i = 0; i < 4; i++)
+		{
+			items[i].value = i;
+			l.push_front(items[i]);
+		}
+
+		assert(l.size() == 4 && l.front().value == 3);
+		l.erase_after(l.iterator_to(items[3])); // items[2]
+		l.insert_after(l.iterator_to(items[0]), items[2]);
+
+		int const expected[] = { 3, 1, 0, 2 };
+		int k = 0;
+		for (item const & x : l)
+			assert(x.value == expected[k++]);
+
+		l.pop_front();
+		assert(l.size() == 3 && l.front().value == 1);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 10'000; // might need to adjust slightly for your machine
+
+	std::vector<item> items(ITER); // the objects live here, the intrusive lists only link them
+	for (int i = 0; i < ITER; i++)
+		items[i].value = i;
+
+	{// Append (at the end)
+		list l1;
+		std::list<int> l2;
+		item_list l3;
+		std::chrono::high_resolution_clock c;
+
+		auto t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			l1.append(i);
+		auto t2 = c.now();
+		std::cout << "tAppend (list): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			l2.push_back(i);
+		t2 = c.now();
+		std::cout << "tAppend (std::list): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			l3.push_back(items[i]);
+		t2 = c.now();
+		std::cout << "tAppend (intrusive_list): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us" << std::endl;
+		std::cout << "(checksum " << l1.at(ITER - 1) + l2.back() - 2 * l3.back().value << ", should be 0)" << std::endl;
+	}
+	std::cout << std::endl;
+	{// Prepend (at the front)
+		list l1;
+		std::list<int> l2;
+		item_list l3;
+		std::chrono::high_resolution_clock c;
+
+		auto t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			l1.insert(0, i);
+		auto t2 = c.now();
+		std::cout << "tPrepend (list): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			l2.push_front(i);
+		t2 = c.now();
+		std::cout << "tPrepend (std::list): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			l3.push_front(items[i]);
+		t2 = c.now();
+		std::cout << "tPrepend (intrusive_list): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us" << std::endl;
+		std::cout << "(checksum " << l1.at(0) + l2.front() - 2 * l3.front().value << ", should be 0)" << std::endl;
+	}
+	std::cout << std::endl;
+	{// Insert (in the middle)
+		list l1;
+		std::list<int> l2;
+		item_list l3;
+		std::chrono::high_resolution_clock c;
+
+		auto t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			l1.insert(i / 2, i);
+		auto t2 = c.now();
+		std::cout << "tInsert (list): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			l2.insert(std::next(l2.begin(), i / 2), i);
+		t2 = c.now();
+		std::cout << "tInsert (std::list): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			l3.insert(std::next(l3.begin(), i / 2), items[i]);
+		t2 = c.now();
+		std::cout << "tInsert (intrusive_list): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us" << std::endl;
+		std::cout << "(checksum " << l1.at(ITER / 2) + * std::next(l2.begin(), ITER / 2) - 2 * std::next(l3.begin(), ITER / 2)->value << ", should be 0)" << std::endl;
+	}
+}
@@ -0,0 +1,424 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace my {
+/**
+ * Link fields of an intrusive_list, to be embedded into the elements.
+ *
+ * Copying an element doesn't copy its links: the copy starts out unlinked,
+ * and assigning to a linked element leaves it in its list.
+ */
+struct list_hook
+{
+	list_hook() : prev(nullptr), next(nullptr) {}
+	list_hook(list_hook const &) : list_hook() {}
+	list_hook & operator=(list_hook const &) { return * this; }
+
+	/**
+	 * @return true if the element is in a list
+	 * @exception no-throw
+	 */
+	bool is_linked() const { return next != nullptr; }
+
+	list_hook * prev;
+	list_hook * next;
+};
+
+/**
+ * Link field of an intrusive_slist (singly-linked), see list_hook.
+ */
+struct slist_hook
+{
+	slist_hook() : next(nullptr) {}
+	slist_hook(slist_hook const &) : slist_hook() {}
+	slist_hook & operator=(slist_hook const &) { return * this; }
+
+	slist_hook * next;
+};
+
+namespace detail {
+// Offset of the member 'M' within T, computed from its pointer-to-member.
+// (offsetof() doesn't accept a pointer-to-member, and isn't guaranteed to work
+// for classes that aren't standard-layout either.)
+template <typename T, typename H, H T::* M>
+std::ptrdiff_t member_offset()
+{
+	alignas(T) static unsigned char const storage[sizeof(T)] = {};
+	T const * t = reinterpret_cast<T const *>(storage);
+	return reinterpret_cast<unsigned char const *>(& (t->*M)) - storage;
+}
+
+template <typename T, typename H, H T::* M>
+T & owner_of(H & hook)
+{
+	static std::ptrdiff_t const offset = member_offset<T, H, M>();
+	return * reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(& hook) - offset);
+}
+} // namespace detail
+
+
+
+/**
+ * Doubly-linked list of objects that live elsewhere (in a vector, a pool, on the stack):
+ * the links are fields of the objects themselves (a list_hook member, 'Hook').
+ *
+ * Unlike a regular list, an intrusive list never allocates: it neither owns nor copies
+ * its elements, it links them. Insertion can't fail, erasing an element given by
+ * reference takes O(1) without searching for it, and traversing the list touches just
+ * the elements themselves, with the links in the same cache line as their data.
+ *
+ * The elements must outlive their membership in the list, and an element can be in at
+ * most one list per hook (give it several hooks to put it into several lists at once).
+ *
+ * @invariant The list is circular through _root: the last element's next is & _root.
+ */
+template <typename T, list_hook T::* Hook>
+class intrusive_list
+{
+	template <bool Const>
+	class iterator_impl
+	{
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, T const *, T *>;
+		using reference = std::conditional_t<Const, T const &, T &>;
+
+		iterator_impl() : _h(nullptr) {}
+		template <bool C = Const, typename = std::enable_if_t<C>>
+		iterator_impl(iterator_impl<false> const & rhs) : _h(rhs._h) {}
+
+		reference operator*() const { return detail::owner_of<T, list_hook, Hook>(* _h); }
+		pointer operator->() const { return & ** this; }
+
+		iterator_impl & operator++() { _h = _h->next; return * this; }
+		iterator_impl & operator--() { _h = _h->prev; return * this; }
+		iterator_impl operator++(int) { auto tmp = * this; ++* this; return tmp; }
+		iterator_impl operator--(int) { auto tmp = * this; --* this; return tmp; }
+
+		friend bool operator==(iterator_impl a, iterator_impl b) { return a._h == b._h; }
+		friend bool operator!=(iterator_impl a, iterator_impl b) { return a._h != b._h; }
+
+	private:
+		friend class intrusive_list;
+		friend class iterator_impl<!Const>;
+		explicit iterator_impl(list_hook * h) : _h(h) {}
+
+		list_hook * _h;
+	};
+
+public:
+	using value_type = T;
+	using iterator = iterator_impl<false>;
+	using const_iterator = iterator_impl<true>;
+
+	/**
+	 * Constructor, creates an empty list.
+	 * @exception no-throw
+	 */
+	intrusive_list() : _size(0) { _root.prev = _root.next = & _root; }
+
+	/**
+	 * Move constructor, takes over the elements of 'other'.
+	 * @exception no-throw
+	 * @post other.empty()
+	 */
+	intrusive_list(intrusive_list && other) noexcept : intrusive_list() { splice(end(), other); }
+
+	// Elements can only be in one list (per hook)
+	intrusive_list(intrusive_list const &) = delete;
+	intrusive_list & operator=(intrusive_list const &) = delete;
+
+	/**
+	 * Destructor, unlinks all elements (it doesn't destroy them).
+	 * @exception no-throw
+	 */
+	~intrusive_list() { clear(); }
+
+	/**
+	 * @return Number of elements
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	iterator begin() { return iterator(_root.next); }
+	iterator end() { return iterator(& _root); }
+	const_iterator begin() const { return const_iterator(_root.next); }
+	const_iterator end() const { return const_iterator(const_cast<list_hook *>(& _root)); }
+
+	/**
+	 * @return First/last element
+	 * @pre !empty()
+	 * @exception no-throw
+	 */
+	T & front() { assert(!empty()); return * begin(); }
+	T & back() { assert(!empty()); return * --end(); }
+	T const & front() const { assert(!empty()); return * begin(); }
+	T const & back() const { assert(!empty()); return * --end(); }
+
+	/**
+	 * @return Iterator to x, O(1)
+	 * @pre x is in this list
+	 * @exception no-throw
+	 */
+	iterator iterator_to(T & x) { return iterator(& (x.*Hook)); }
+	const_iterator iterator_to(T const & x) const { return const_iterator(const_cast<list_hook *>(& (x.*Hook))); }
+
+	/**
+	 * Links x in front of pos.
+	 * @return Iterator to x
+	 * @pre x is not linked into any list (through Hook)
+	 * @exception no-throw
+	 */
+	iterator insert(iterator pos, T & x)
+	{
+		list_hook & h = x.*Hook;
+		assert(!h.is_linked());
+
+		h.next = pos._h;
+		h.prev = pos._h->prev;
+		h.prev->next = & h;
+		pos._h->prev = & h;
+		_size++;
+		return iterator(& h);
+	}
+
+	void push_front(T & x) { insert(begin(), x); }
+	void push_back(T & x) { insert(end(), x); }
+
+	/**
+	 * Unlinks the element at pos (doesn't destroy it).
+	 * @return Iterator to the next element
+	 * @pre pos != end()
+	 * @exception no-throw
+	 */
+	iterator erase(iterator pos)
+	{
+		assert(pos != end());
+		list_hook * h = pos._h;
+		list_hook * next = h->next;
+
+		h->prev->next = next;
+		next->prev = h->prev;
+		h->prev = h->next = nullptr;
+		_size--;
+		return iterator(next);
+	}
+
+	/**
+	 * Unlinks x, O(1).
+	 * @pre x is in this list
+	 * @exception no-throw
+	 */
+	void erase(T & x) { erase(iterator_to(x)); }
+
+	void pop_front() { erase(begin()); }
+	void pop_back() { erase(--end()); }
+
+	/**
+	 * Unlinks all elements, O(n) (every element's hook is reset).
+	 * @exception no-throw
+	 */
+	void clear()
+	{
+		while (!empty())
+			pop_front();
+	}
+
+	/**
+	 * Moves all elements of 'other' in front of pos, O(1).
+	 * @pre & other != this
+	 * @exception no-throw
+	 * @post other.empty()
+	 */
+	void splice(iterator pos, intrusive_list & other)
+	{
+		assert(& other != this);
+		if (other.empty())
+			return;
+
+		list_hook * first = other._root.next;
+		list_hook * last = other._root.prev;
+		other._root.prev = other._root.next = & other._root;
+
+		first->prev = pos._h->prev;
+		last->next = pos._h;
+		pos._h->prev->next = first;
+		pos._h->prev = last;
+
+		_size += other._size;
+		other._size = 0;
+	}
+
+	/**
+	 * Moves the element at it from 'other' (possibly this list) in front of pos, O(1).
+	 * @pre it is an iterator into 'other', it != other.end()
+	 * @exception no-throw
+	 */
+	void splice(iterator pos, intrusive_list & other, iterator it)
+	{
+		if (it == pos || it._h->next == pos._h)
+			return;
+
+		T & x = * it;
+		other.erase(it);
+		insert(pos, x);
+	}
+
+private:
+	list_hook _root;
+	std::size_t _size;
+};
+
+/**
+ * Singly-linked variant of intrusive_list: one pointer per element instead of two,
+ * at the price of only being able to insert/erase *after* a given position.
+ */
+template <typename T, slist_hook T::* Hook>
+class intrusive_slist
+{
+	template <bool Const>
+	class iterator_impl
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, T const *, T *>;
+		using reference = std::conditional_t<Const, T const &, T &>;
+
+		iterator_impl() : _h(nullptr) {}
+		template <bool C = Const, typename = std::enable_if_t<C>>
+		iterator_impl(iterator_impl<false> const & rhs) : _h(rhs._h) {}
+
+		reference operator*() const { return detail::owner_of<T, slist_hook, Hook>(* _h); }
+		pointer operator->() const { return & ** this; }
+
+		iterator_impl & operator++() { _h = _h->next; return * this; }
+		iterator_impl operator++(int) { auto tmp = * this; ++* this; return tmp; }
+
+		friend bool operator==(iterator_impl a, iterator_impl b) { return a._h == b._h; }
+		friend bool operator!=(iterator_impl a, iterator_impl b) { return a._h != b._h; }
+
+	private:
+		friend class intrusive_slist;
+		friend class iterator_impl<!Const>;
+		explicit iterator_impl(slist_hook * h) : _h(h) {}
+
+		slist_hook * _h;
+	};
+
+public:
+	using value_type = T;
+	using iterator = iterator_impl<false>;
+	using const_iterator = iterator_impl<true>;
+
+	/**
+	 * Constructor, creates an empty list.
+	 * @exception no-throw
+	 */
+	intrusive_slist() : _size(0) {}
+
+	intrusive_slist(intrusive_slist const &) = delete;
+	intrusive_slist & operator=(intrusive_slist const &) = delete;
+
+	/**
+	 * Destructor, unlinks all elements (it doesn't destroy them).
+	 * @exception no-throw
+	 */
+	~intrusive_slist() { clear(); }
+
+	/**
+	 * @return Number of elements
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * @return Iterator 'before' the first element, for insert_after()/erase_after()
+	 * @exception no-throw
+	 */
+	iterator before_begin() { return iterator(& _root); }
+	iterator begin() { return iterator(_root.next); }
+	iterator end() { return iterator(nullptr); }
+	const_iterator begin() const { return const_iterator(_root.next); }
+	const_iterator end() const { return const_iterator(nullptr); }
+
+	/**
+	 * @return Iterator to x, O(1)
+	 * @pre x is in this list
+	 * @exception no-throw
+	 */
+	iterator iterator_to(T & x) { return iterator(& (x.*Hook)); }
+
+	/**
+	 * @pre !empty()
+	 * @exception no-throw
+	 */
+	T & front() { assert(!empty()); return * begin(); }
+
+	/**
+	 * Links x behind pos.
+	 * @return Iterator to x
+	 * @pre pos != end(), x is not linked into any list (through Hook)
+	 * @exception no-throw
+	 */
+	iterator insert_after(iterator pos, T & x)
+	{
+		slist_hook & h = x.*Hook;
+		assert(pos != end() && !h.next);
+
+		h.next = pos._h->next;
+		pos._h->next = & h;
+		_size++;
+		return iterator(& h);
+	}
+
+	void push_front(T & x) { insert_after(before_begin(), x); }
+
+	/**
+	 * Unlinks the element behind pos (doesn't destroy it).
+	 * @return Iterator to the element behind the erased one
+	 * @pre pos and its successor != end()
+	 * @exception no-throw
+	 */
+	iterator erase_after(iterator pos)
+	{
+		slist_hook * h = pos._h->next;
+		assert(h);
+
+		pos._h->next = h->next;
+		h->next = nullptr;
+		_size--;
+		return iterator(pos._h->next);
+	}
+
+	void pop_front() { erase_after(before_begin()); }
+
+	/**
+	 * Unlinks all elements, O(n).
+	 * @exception no-throw
+	 */
+	void clear()
+	{
+		while (!empty())
+			pop_front();
+	}
+
+private:
+	// The last element's next is nullptr, so (unlike list_hook) is_linked()
+	// can't be told from the hook alone
+	slist_hook _root;
+	std::size_t _size;
+};
+} // namespace my
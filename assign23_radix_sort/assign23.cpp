@@ -0,0 +1,190 @@
+#include "myarray.h"
+#include "myradix_sort.h"
+#include "myvector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+
+// Random keys: full range integers, floats of both signs and various magnitudes
+template <typename T>
+static my::vector<T> random_keys(std::size_t n, unsigned seed)
+{
+	std::mt19937_64 rng(seed);
+	my::vector<T> v(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		if constexpr (std::is_floating_point<T>::value)
+			v[i] = static_cast<T>(std::ldexp(double(rng() % 2000000) - 1000000.0, int(rng() % 40) - 20));
+		else
+			v[i] = static_cast<T>(rng());
+	}
+	return v;
+}
+
+template <typename T>
+static bool equal(my::vector<T> const & a, my::vector<T> const & b)
+{
+	return a.size() == b.size() && std::equal(a.data(), a.data() + a.size(), b.data());
+}
+
+// Times std::sort, radix_sort() (1 and all threads) and radix_sort_inplace() on n keys
+template <typename T>
+static void benchmark(char const * type, std::size_t n)
+{
+	my::vector<T> const keys = random_keys<T>(n, 1);
+	my::vector<T> ref = keys, v;
+	my::array<T> scratch(n);
+	std::chrono::high_resolution_clock c;
+	std::size_t errors = 0;
+
+	auto t1 = c.now();
+	std::sort(ref.data(), ref.data() + n);
+	auto t2 = c.now();
+	std::cout << "tSort (" << type << ", " << n << ", std::sort): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+	v = keys;
+	t1 = c.now();
+	my::radix_sort(v, scratch);
+	t2 = c.now();
+	errors += !equal(v, ref);
+	std::cout << "tSort (" << type << ", " << n << ", radix_sort): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+	unsigned const threads = std::max(1u, std::thread::hardware_concurrency());
+	v = keys;
+	t1 = c.now();
+	my::radix_sort(v, scratch, my::detail::radix_identity(), threads);
+	t2 = c.now();
+	errors += !equal(v, ref);
+	std::cout << "tSort (" << type << ", " << n << ", radix_sort, " << threads << " threads): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+	v = keys;
+	t1 = c.now();
+	my::radix_sort_inplace(v);
+	t2 = c.now();
+	errors += !equal(v, ref);
+	std::cout << "tSort (" << type << ", " << n << ", radix_sort_inplace): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+	std::cout << "(checksum " << errors << ", should be 0)" << std::endl << std::endl;
+}
+
+int main()
+{
+	using namespace my;
+
+	{// Test radix_bits(): order preserving
+		assert(detail::radix_bits(-1) < detail::radix_bits(0));
+		assert(detail::radix_bits(std::numeric_limits<int>::min()) == 0u);
+		assert(detail::radix_bits(-2.5f) < detail::radix_bits(-1.0f));
+		assert(detail::radix_bits(-0.0f) < detail::radix_bits(0.0f));
+		assert(detail::radix_bits(0.0f) < detail::radix_bits(1e-30f));
+		assert(detail::radix_bits(1.0) < detail::radix_bits(std::numeric_limits<double>::infinity()));
+	}
+
+	{// Test radix_sort()/radix_sort_inplace() against std::sort, all key types
+		for (std::size_t n : { 0, 1, 2, 31, 32, 1000, 100'000 })
+		{
+			auto check = [n](auto tag) {
+				using T = decltype(tag);
+				vector<T> const keys = random_keys<T>(n, unsigned(n));
+				vector<T> ref = keys;
+				std::sort(ref.data(), ref.data() + n);
+
+				vector<T> a = keys, b = keys, c = keys;
+				radix_sort(a);
+				assert(equal(a, ref));
+
+				array<T> scratch;
+				radix_sort(b, scratch, detail::radix_identity(), 4);
+				assert(equal(b, ref) && scratch.size() >= n);
+
+				radix_sort_inplace(c);
+				assert(equal(c, ref));
+			};
+			check(std::uint64_t());
+			check(std::int32_t());
+			check(std::int16_t());
+			check(float());
+			check(double());
+		}
+	}
+
+	{// Test skipped passes: small numbers, all equal
+		vector<std::uint64_t> v;
+		for (int i = 0; i < 1000; i++)
+			v.push_back((i * 7919) % 256);
+		radix_sort(v);
+		assert(std::is_sorted(v.data(), v.data() + v.size()));
+
+		vector<int> w(500);
+		std::fill(w.data(), w.data() + 500, 42);
+		radix_sort(w);
+		radix_sort_inplace(w);
+		assert(std::count(w.data(), w.data() + 500, 42) == 500);
+	}
+
+	{// Test key + payload pairs, stability
+		std::mt19937 rng(3);
+		vector<std::pair<std::uint32_t, int>> v;
+		for (int i = 0; i < 10'000; i++)
+			v.push_back({ rng() % 100, i });
+
+		array<std::pair<std::uint32_t, int>> scratch;
+		radix_sort(v, scratch, [](auto const & p) { return p.first; });
+		for (std::size_t i = 1; i < v.size(); i++)
+			assert(v[i - 1].first < v[i].first || (v[i - 1].first == v[i].first && v[i - 1].second < v[i].second));
+
+		vector<std::pair<float, int>> w;
+		for (int i = 0; i < 10'000; i++)
+			w.push_back({ float(int(rng() % 1000) - 500) / 8, i });
+		radix_sort_inplace(w, [](auto const & p) { return p.first; });
+		for (std::size_t i = 1; i < w.size(); i++)
+			assert(w[i - 1].first <= w[i].first);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	std::size_t const MAX = 100'000'000; // might need to adjust slightly for your machine (1'000'000'000 needs 24 GB)
+
+	for (std::size_t n = 1'000'000; n <= MAX; n *= 10)
+	{
+		benchmark<std::uint64_t>("uint64_t", n);
+		benchmark<float>("float", n);
+	}
+
+	{// Key + payload pairs
+		std::size_t const n = MAX / 10;
+		std::mt19937_64 rng(2);
+		vector<std::pair<std::uint64_t, std::uint32_t>> keys(n), v;
+		for (std::size_t i = 0; i < n; i++)
+			keys[i] = { rng(), std::uint32_t(i) };
+		array<std::pair<std::uint64_t, std::uint32_t>> scratch;
+		auto const first = [](auto const & p) { return p.first; };
+		std::chrono::high_resolution_clock c;
+
+		v = keys;
+		auto t1 = c.now();
+		std::sort(v.data(), v.data() + n, [](auto const & a, auto const & b) { return a.first < b.first; });
+		auto t2 = c.now();
+		std::cout << "tSort (pairs, " << n << ", std::sort): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::uint64_t sum1 = v[n / 2].second;
+
+		v = keys;
+		t1 = c.now();
+		radix_sort(v, scratch, first);
+		t2 = c.now();
+		std::cout << "tSort (pairs, " << n << ", radix_sort): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << sum1 - v[n / 2].second << ", should be 0)" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,285 @@
+#pragma once
+
+#include "myarray.h"
+#include "myvector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace my {
+namespace detail {
+template <std::size_t Bytes> struct unsigned_of_size;
+template <> struct unsigned_of_size<1> { using type = std::uint8_t; };
+template <> struct unsigned_of_size<2> { using type = std::uint16_t; };
+template <> struct unsigned_of_size<4> { using type = std::uint32_t; };
+template <> struct unsigned_of_size<8> { using type = std::uint64_t; };
+
+/**
+ * Maps a key to an unsigned integer of the same size with the same order, so
+ * radix sort can treat all keys as plain bytes:
+ * - unsigned integers: unchanged
+ * - signed integers: flip the sign bit (negative numbers become the smaller ones)
+ * - floats/doubles (IEEE 754, sign and magnitude): flip the sign bit of positive
+ *   numbers, all bits of negative ones (the greater their magnitude, the smaller).
+ *   -0.0 sorts before 0.0, NaNs sort to the very front or back depending on their sign.
+ */
+template <typename K>
+auto radix_bits(K k)
+{
+	static_assert(std::is_arithmetic<K>::value, "radix sort requires integer or floating point keys");
+	using U = typename unsigned_of_size<sizeof(K)>::type;
+	U constexpr sign = U(1) << (8 * sizeof(K) - 1);
+
+	if constexpr (std::is_floating_point<K>::value)
+	{
+		U u;
+		std::memcpy(& u, & k, sizeof(k));
+		return static_cast<U>(u & sign ? ~u : u | sign);
+	}
+	else if constexpr (std::is_signed<K>::value)
+		return static_cast<U>(static_cast<U>(k) ^ sign);
+	else
+		return static_cast<U>(k);
+}
+
+struct radix_identity
+{
+	template <typename T>
+	T const & operator()(T const & x) const { return x; }
+};
+
+template <typename T, typename KeyOf>
+using radix_bits_t = decltype(radix_bits(std::declval<KeyOf>()(std::declval<T const &>())));
+
+template <typename U>
+unsigned digit(U bits, unsigned byte) { return static_cast<unsigned>(bits >> (8 * byte)) & 0xFF; }
+
+// Counts the occurrences of every byte value of every key byte in [first, last)
+template <typename T, typename KeyOf, typename U = radix_bits_t<T, KeyOf>>
+void histogram(T const * first, T const * last, KeyOf key, std::size_t (* counts)[256])
+{
+	for (; first != last; ++first)
+	{
+		U const bits = radix_bits(key(* first));
+		for (unsigned b = 0; b < sizeof(U); b++)
+			counts[b][digit(bits, b)]++;
+	}
+}
+
+template <typename T, typename KeyOf>
+void insertion_sort(T * first, T * last, KeyOf key)
+{
+	for (T * i = first + 1; i < last; ++i)
+	{
+		T x = std::move(* i);
+		auto const bits = radix_bits(key(x));
+		T * j = i;
+		for (; j > first && bits < radix_bits(key(* (j - 1))); --j)
+			* j = std::move(* (j - 1));
+		* j = std::move(x);
+	}
+}
+
+// American flag sort of [first, last) by key byte 'byte' and all less significant ones
+template <typename T, typename KeyOf>
+void american_flag_sort(T * first, T * last, KeyOf key, unsigned byte)
+{
+	for (;;)
+	{
+		std::size_t const n = last - first;
+		if (n < 32)
+		{
+			insertion_sort(first, last, key);
+			return;
+		}
+
+		std::size_t counts[256] = {};
+		for (T * p = first; p != last; ++p)
+			counts[digit(radix_bits(key(* p)), byte)]++;
+
+		// All keys share this byte: nothing to permute, go on with the next one
+		if (counts[digit(radix_bits(key(* first)), byte)] == n)
+		{
+			if (byte == 0)
+				return;
+			byte--;
+			continue;
+		}
+
+		// next[d]: next free slot of bucket d, end[d]: end of bucket d
+		std::size_t next[256], end[256];
+		std::size_t sum = 0;
+		for (unsigned d = 0; d < 256; d++)
+		{
+			next[d] = sum;
+			sum += counts[d];
+			end[d] = sum;
+		}
+
+		// Permute in place: take the first misplaced element of each bucket and keep
+		// swapping it into the bucket it belongs to until one that belongs here comes back.
+		for (unsigned d = 0; d < 256; d++)
+		{
+			while (next[d] < end[d])
+			{
+				T x = std::move(first[next[d]]);
+				unsigned dx = digit(radix_bits(key(x)), byte);
+				while (dx != d)
+				{
+					std::swap(x, first[next[dx]++]);
+					dx = digit(radix_bits(key(x)), byte);
+				}
+				first[next[d]++] = std::move(x);
+			}
+		}
+
+		if (byte == 0)
+			return;
+		for (std::size_t d = 0, begin = 0; d < 256; begin = end[d], d++)
+			if (end[d] - begin > 1)
+				american_flag_sort(first + begin, first + end[d], key, byte - 1);
+		return;
+	}
+}
+} // namespace detail
+
+
+
+/**
+ * Sorts [first, last) by key(element) with an LSD (least significant digit first)
+ * radix sort: one counting pass per key byte, from the lowest to the highest, each
+ * one stable, moving all elements between [first, last) and 'scratch'. O(n * sizeof(key))
+ * instead of O(n log n) comparisons, and all memory accesses are sequential reads and
+ * 256 sequential write streams.
+ *
+ * Keys are integers or floating point numbers (see detail::radix_bits()), key
+ * extracts the key of an element (e.g. sort key + payload pairs by .first).
+ * The histograms of all passes are computed upfront in a single pass, optionally
+ * split across 'threads' threads. Passes in which all keys share the same byte
+ * (e.g. the upper bytes of small numbers) are skipped.
+ *
+ * The sort is stable.
+ * @pre scratch has room for last - first elements
+ * @exception might throw if T's move assignment throws. If a thread can't be started,
+ * the calling thread computes its share of the histograms.
+ */
+template <typename T, typename KeyOf = detail::radix_identity>
+void radix_sort(T * first, T * last, T * scratch, KeyOf key = KeyOf(), unsigned threads = 1)
+{
+	using U = detail::radix_bits_t<T, KeyOf>;
+	std::size_t const n = last - first;
+	if (n < 2)
+		return;
+
+	std::size_t counts[sizeof(U)][256] = {};
+	threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, n / 65536)));
+	if (threads == 1)
+		detail::histogram(first, last, key, counts);
+	else
+	{
+		// one set of histograms per thread, summed up afterwards
+		std::size_t const size = sizeof(U) * 256;
+		array<std::size_t> local(threads * size);
+		std::fill(local.data(), local.data() + threads * size, 0);
+
+		auto part = [&](unsigned t) {
+			auto c = reinterpret_cast<std::size_t (*)[256]>(local.data() + t * size);
+			detail::histogram(first + n * t / threads, first + n * (t + 1) / threads, key, c);
+		};
+		array<std::thread> workers(threads);
+		for (unsigned t = 0; t < threads; t++)
+		{
+			try
+			{
+				workers[t] = std::thread(part, t);
+			}
+			catch (std::system_error const &)
+			{
+				part(t); // no thread available, do it here
+			}
+		}
+		for (unsigned t = 0; t < threads; t++)
+			if (workers[t].joinable())
+				workers[t].join();
+
+		for (unsigned t = 0; t < threads; t++)
+			for (std::size_t i = 0; i < size; i++)
+				counts[i / 256][i % 256] += local[t * size + i];
+	}
+
+	T * src = first, * dst = scratch;
+	for (unsigned b = 0; b < sizeof(U); b++)
+	{
+		std::size_t * c = counts[b];
+		if (c[detail::digit(detail::radix_bits(key(* src)), b)] == n)
+			continue;
+
+		// counts -> offsets of the buckets
+		std::size_t sum = 0;
+		for (unsigned d = 0; d < 256; d++)
+			sum += std::exchange(c[d], sum);
+
+		for (T * p = src; p != src + n; ++p)
+			dst[c[detail::digit(detail::radix_bits(key(* p)), b)]++] = std::move(* p);
+		std::swap(src, dst);
+	}
+
+	if (src != first)
+		std::move(src, src + n, first);
+}
+
+/**
+ * Sorts v, see above. 'scratch' is reused if it is large enough, so sorting many
+ * batches only allocates once.
+ * @exception might throw if not enough memory is available for scratch
+ * @post scratch.size() >= v.size()
+ */
+template <typename T, typename KeyOf = detail::radix_identity>
+void radix_sort(vector<T> & v, array<T> & scratch, KeyOf key = KeyOf(), unsigned threads = 1)
+{
+	if (scratch.size() < v.size())
+		scratch = array<T>(v.size());
+
+	radix_sort(v.data(), v.data() + v.size(), scratch.data(), key, threads);
+}
+
+template <typename T>
+void radix_sort(vector<T> & v)
+{
+	array<T> scratch;
+	radix_sort(v, scratch);
+}
+
+/**
+ * Sorts [first, last) in place by key(element) with an MSD (most significant digit
+ * first) radix sort, American flag sort: counts the elements per value of the highest
+ * key byte, permutes them into their buckets in place, then recurses into each bucket
+ * with the next byte. Small buckets are finished with insertion sort.
+ *
+ * Unlike radix_sort() it needs no scratch memory, but it is not stable, and its
+ * permutation is a random access pattern.
+ * @exception might throw if T's move assignment throws
+ */
+template <typename T, typename KeyOf = detail::radix_identity>
+void radix_sort_inplace(T * first, T * last, KeyOf key = KeyOf())
+{
+	using U = detail::radix_bits_t<T, KeyOf>;
+	if (last - first > 1)
+		detail::american_flag_sort(first, last, key, sizeof(U) - 1);
+}
+
+template <typename T, typename KeyOf = detail::radix_identity>
+void radix_sort_inplace(vector<T> & v, KeyOf key = KeyOf())
+{
+	radix_sort_inplace(v.data(), v.data() + v.size(), key);
+}
+} // namespace my
@@ -0,0 +1,151 @@
+#include "myarray.h"
+#include "myexternal_sort.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+
+// Writes v to 'path' as raw bytes
+template <typename T>
+static void write_file(char const * path, std::vector<T> const & v)
+{
+	my::detail::file f(path, "wb");
+	my::detail::buffered_writer<T>::write_all(f.get(), v.data(), v.size());
+}
+
+template <typename T>
+static std::vector<T> read_file(char const * path)
+{
+	my::detail::file f(path, "rb");
+	my::detail::buffered_reader<T> r(f, 1024);
+	std::vector<T> v;
+	for (T x; r.next(x);)
+		v.push_back(x);
+	return v;
+}
+
+struct record
+{
+	std::uint32_t key;
+	std::uint32_t payload;
+};
+
+int main()
+{
+	using namespace my;
+	char const * in = "assign24_in.bin";
+	char const * out = "assign24_out.bin";
+
+	{// Test loser_tree
+		int const heads[] = { 5, 3, 9, 1, 7 };
+		detail::loser_tree<int, std::less<>> tree(5, std::less<>());
+		for (int s = 0; s < 5; s++)
+			tree.set(s, heads[s]);
+		tree.init();
+		assert(tree.top() == 1 && tree.winner() == 3);
+
+		tree.exhaust(3);
+		tree.replay(3);
+		assert(tree.top() == 3 && tree.winner() == 1);
+
+		tree.set(1, 6);
+		tree.replay(1);
+		assert(tree.top() == 5 && tree.winner() == 0);
+	}
+
+	{// Test external_sort() against std::sort: empty, single run, one and several merge passes
+		std::mt19937_64 rng(42);
+		for (std::size_t n : { 0, 1, 1000, 100'000 })
+			for (std::size_t memory : { 1'000'000, 64'000, 800, 8 })
+			{
+				std::vector<std::uint64_t> v(n);
+				for (auto & x : v)
+					x = rng() % 1000;
+				write_file(in, v);
+
+				auto const stats = external_sort<std::uint64_t>(in, out, memory);
+				std::sort(v.begin(), v.end());
+				assert(read_file<std::uint64_t>(out) == v);
+				assert(stats.elements == n);
+				assert(stats.runs == (n * 8 <= memory ? 0 : (n * 8 + memory - 1) / memory));
+				assert((stats.merge_passes == 0) == (stats.runs == 0));
+			}
+	}
+
+	{// Test custom comparison
+		std::vector<record> v;
+		for (std::uint32_t i = 0; i < 10'000; i++)
+			v.push_back({ (i * 7919) % 1000, i });
+		write_file(in, v);
+
+		auto const by_key_desc = [](record const & a, record const & b) { return a.key > b.key; };
+		auto const stats = external_sort<record>(in, out, 4096, by_key_desc);
+		assert(stats.runs == 20 && stats.merge_passes == 5); // fan-in 2: 20 -> 10 -> 5 -> 3 -> 2 -> 1
+
+		auto const sorted = read_file<record>(out);
+		assert(sorted.size() == v.size());
+		assert(std::is_sorted(sorted.begin(), sorted.end(), by_key_desc));
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	std::size_t const MEMORY = 256 * 1024 * 1024; // memory budget, might need to adjust slightly for your machine
+	std::size_t const N = 4 * MEMORY / sizeof(std::uint64_t); // file 4x the size of the budget
+
+	{// Write the input in blocks
+		std::mt19937_64 rng(1);
+		detail::file f(in, "wb");
+		detail::buffered_writer<std::uint64_t> w(f.get(), 1024 * 1024);
+		for (std::size_t i = 0; i < N; i++)
+			w.write(rng());
+		w.flush();
+	}
+
+	std::chrono::high_resolution_clock c;
+	double const mb = double(N * sizeof(std::uint64_t)) / (1024 * 1024);
+
+	{// Raw bandwidth: copy the file (read + write everything once)
+		auto t1 = c.now();
+		{
+			detail::file src(in, "rb"), dst(out, "wb");
+			array<char> buf(16 * 1024 * 1024);
+			for (std::size_t n; (n = std::fread(buf.data(), 1, buf.size(), src.get())) > 0;)
+				detail::buffered_writer<char>::write_all(dst.get(), buf.data(), n);
+			std::fflush(dst.get());
+		}
+		auto t2 = c.now();
+		auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+		std::cout << "tCopy (" << mb << "MB): " << ms << "ms, " << mb / (ms + 1) * 1000 << "MB/s" << std::endl;
+	}
+
+	{// Sort
+		auto t1 = c.now();
+		auto const stats = external_sort<std::uint64_t>(in, out, MEMORY);
+		auto t2 = c.now();
+		auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+		std::cout << "tExternalSort (" << mb << "MB, " << MEMORY / (1024 * 1024) << "MB memory): " << ms << "ms, "
+			<< mb / (ms + 1) * 1000 << "MB/s, " << stats.runs << " runs, " << stats.merge_passes << " merge pass(es)" << std::endl;
+
+		// verify
+		detail::file f(out, "rb");
+		detail::buffered_reader<std::uint64_t> r(f, 1024 * 1024);
+		std::size_t n = 0, unsorted = 0;
+		std::uint64_t prev = 0;
+		for (std::uint64_t x; r.next(x); prev = x, n++)
+			unsorted += x < prev;
+		std::cout << "(checksum " << unsorted + (n != N) << ", should be 0)" << std::endl;
+	}
+
+	std::remove(in);
+	std::remove(out);
+
+	return 0;
+}
@@ -0,0 +1,396 @@
+#pragma once
+
+#include "myarray.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <sys/types.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+
+namespace my {
+namespace detail {
+/**
+ * RAII wrapper of a C stream. Unbuffered: we always read and write large blocks
+ * ourselves, another copy through the stream's buffer would only cost time.
+ */
+class file
+{
+public:
+	file() : _f(nullptr) {}
+
+	/**
+	 * Opens 'path' with fopen() 'mode'.
+	 * @exception std::runtime_error if the file can't be opened
+	 */
+	file(char const * path, char const * mode) : _f(std::fopen(path, mode))
+	{
+		if (!_f)
+			throw std::runtime_error(std::string("external_sort: can't open ") + path);
+		std::setvbuf(_f, nullptr, _IONBF, 0);
+	}
+
+	/**
+	 * @return A new temporary file, removed automatically when it is closed
+	 * (or the program terminates)
+	 * @exception std::runtime_error if the file can't be created
+	 */
+	static file temporary()
+	{
+		file f;
+		f._f = std::tmpfile();
+		if (!f._f)
+			throw std::runtime_error("external_sort: can't create temporary file");
+		std::setvbuf(f._f, nullptr, _IONBF, 0);
+		return f;
+	}
+
+	file(file && other) noexcept : _f(std::exchange(other._f, nullptr)) {}
+	file & operator=(file && rhs) noexcept
+	{
+		std::swap(_f, rhs._f);
+		return * this;
+	}
+	~file()
+	{
+		if (_f)
+			std::fclose(_f);
+	}
+
+	std::FILE * get() const { return _f; }
+
+	/**
+	 * Moves the read/write position to byte 'offset' (64 bit, even on Windows).
+	 * @exception std::runtime_error on failure
+	 */
+	void seek(std::uint64_t offset) const
+	{
+#ifdef _WIN32
+		int const r = _fseeki64(_f, static_cast<__int64>(offset), SEEK_SET);
+#else
+		int const r = fseeko(_f, static_cast<off_t>(offset), SEEK_SET);
+#endif
+		if (r != 0)
+			throw std::runtime_error("external_sort: seek error");
+	}
+
+	// @return true if there's nothing left to read (even if the last read didn't hit the end yet)
+	bool at_end() const
+	{
+		int const c = std::fgetc(_f);
+		return c == EOF || std::ungetc(c, _f) == EOF;
+	}
+
+private:
+	std::FILE * _f;
+};
+
+// Reads a file of T in blocks of 'n' elements: the whole file, or 'count' elements
+// starting at element 'first'. Several readers can share a file, each one seeks to
+// its position before reading a block.
+template <typename T>
+class buffered_reader
+{
+public:
+	buffered_reader(file const & f, std::size_t n) :
+		_f(& f), _buf(n), _pos(0), _end(0), _next(0), _remaining(static_cast<std::uint64_t>(-1)), _shared(false) {}
+	buffered_reader(file const & f, std::size_t n, std::uint64_t first, std::uint64_t count) :
+		_f(& f), _buf(n), _pos(0), _end(0), _next(first), _remaining(count), _shared(true) {}
+
+	/**
+	 * @return false at the end of the file/range, otherwise the next element in x
+	 * @exception std::runtime_error on read errors
+	 */
+	bool next(T & x)
+	{
+		if (_pos == _end && !refill())
+			return false;
+
+		x = _buf[_pos++];
+		return true;
+	}
+
+private:
+	bool refill()
+	{
+		if (_remaining == 0)
+			return false;
+		if (_shared)
+			_f->seek(_next * sizeof(T));
+
+		std::size_t const n = static_cast<std::size_t>(std::min<std::uint64_t>(_buf.size(), _remaining));
+		_pos = 0;
+		_end = std::fread(_buf.data(), sizeof(T), n, _f->get());
+		if (_end < n && (_shared || std::ferror(_f->get())))
+			throw std::runtime_error("external_sort: read error");
+
+		_next += _end;
+		_remaining -= _end;
+		return _end > 0;
+	}
+
+	file const * _f;
+	array<T> _buf;
+	std::size_t _pos, _end;
+	std::uint64_t _next, _remaining;	// position/number of elements left to read of the range
+	bool _shared;
+};
+
+// Writes a file of T in blocks of 'n' elements
+template <typename T>
+class buffered_writer
+{
+public:
+	buffered_writer(std::FILE * f, std::size_t n) : _f(f), _buf(n), _pos(0) {}
+
+	/**
+	 * @exception std::runtime_error on write errors (e.g. disk full)
+	 */
+	void write(T const & x)
+	{
+		if (_pos == _buf.size())
+			flush();
+		_buf[_pos++] = x;
+	}
+
+	// Must be called after the last write(), the destructor can't report errors
+	void flush()
+	{
+		write_all(_f, _buf.data(), _pos);
+		_pos = 0;
+	}
+
+	static void write_all(std::FILE * f, T const * data, std::size_t n)
+	{
+		if (n > 0 && std::fwrite(data, sizeof(T), n, f) != n)
+			throw std::runtime_error("external_sort: write error");
+	}
+
+private:
+	std::FILE * _f;
+	array<T> _buf;
+	std::size_t _pos;
+};
+
+/**
+ * Tournament tree selecting the smallest of the current elements of k sorted sources.
+ *
+ * Every inner node stores the *loser* of the match played there, the overall winner is
+ * kept separately. After the winner's source advanced, only the matches on the path
+ * from its leaf to the root are replayed, against the losers stored along that path:
+ * log2(k) comparisons and no branching on which child won (unlike a binary heap,
+ * which compares against both children on every level).
+ */
+template <typename T, typename Less>
+class loser_tree
+{
+public:
+	loser_tree(std::size_t k, Less less) :
+		_k(k), _losers(k), _heads(k), _done(k), _winner(0), _less(less) {}
+
+	/**
+	 * Sets the current element of source s / marks s as exhausted.
+	 * Call init() after setting all sources, replay(s) after changing the winner's.
+	 */
+	void set(std::size_t s, T const & x) { _heads[s] = x; _done[s] = false; }
+	void exhaust(std::size_t s) { _done[s] = true; }
+
+	// Plays all matches
+	void init()
+	{
+		array<std::size_t> win(2 * _k);
+		for (std::size_t s = 0; s < _k; s++)
+			win[_k + s] = s;
+		for (std::size_t j = _k - 1; j >= 1; j--)
+		{
+			std::size_t const a = win[2 * j], b = win[2 * j + 1];
+			bool const a_wins = beats(a, b);
+			win[j] = a_wins ? a : b;
+			_losers[j] = a_wins ? b : a;
+		}
+		_winner = _k == 1 ? 0 : win[1];
+	}
+
+	// Replays the matches of source s, the previous winner
+	void replay(std::size_t s)
+	{
+		assert(s == _winner);
+		for (std::size_t j = (s + _k) / 2; j >= 1; j /= 2)
+			if (beats(_losers[j], s))
+				std::swap(_losers[j], s);
+		_winner = s;
+	}
+
+	/**
+	 * @return Source of the smallest current element
+	 */
+	std::size_t winner() const { return _winner; }
+	T const & top() const { return _heads[_winner]; }
+	bool empty() const { return _done[_winner]; }
+
+private:
+	// Exhausted sources lose every match, ties go to the lower source
+	bool beats(std::size_t a, std::size_t b) const
+	{
+		if (_done[a] || _done[b])
+			return !_done[a] && (_done[b] || a < b);
+		return _less(_heads[a], _heads[b]) || (!_less(_heads[b], _heads[a]) && a < b);
+	}
+
+	std::size_t _k;
+	array<std::size_t> _losers; // [1, k)
+	array<T> _heads;
+	array<bool> _done;
+	std::size_t _winner;
+	Less _less;
+};
+} // namespace detail
+
+/**
+ * Statistics of an external_sort() run
+ */
+struct external_sort_stats
+{
+	std::size_t elements;		// number of sorted elements
+	std::size_t runs;		// sorted runs written in the first phase
+	std::size_t merge_passes;	// 0 if the input fit into memory
+};
+
+/**
+ * Sorts a binary file of T (which may be much larger than the available memory)
+ * into another file, using at most about 'memory' bytes of RAM:
+ *
+ * 1. Run formation: reads as many elements as fit into 'memory', sorts them with
+ *    std::sort and appends them to a temporary file (a 'run'), until the input ends.
+ *    If the input fits into a single run, it is written to 'output' right away.
+ * 2. Merging: merges up to 'fan-in' runs at a time with a loser tree. Every run
+ *    gets a read buffer of an equal share of 'memory'. If there are more runs
+ *    than buffers of at least 'merge_block' bytes fit into memory, the runs are
+ *    merged into longer runs first (another pass over the data).
+ *
+ * All I/O happens in large sequential blocks. All runs of a pass share one temporary
+ * file (so the number of runs isn't limited by the number of open files), created
+ * with std::tmpfile() in the system's temporary directory and removed automatically.
+ *
+ * Like std::sort, the sort is not stable. T must be trivially copyable, 'less' a
+ * strict weak ordering.
+ * @pre output != input
+ * @exception std::runtime_error on I/O errors, might throw if 'memory' can't be
+ * allocated. 'output' is left incomplete in either case.
+ */
+template <typename T, typename Less = std::less<>>
+external_sort_stats external_sort(char const * input, char const * output, std::size_t memory, Less less = Less())
+{
+	static_assert(std::is_trivially_copyable<T>::value, "external_sort writes T as raw bytes");
+	std::size_t constexpr merge_block = 64 * 1024;
+
+	struct run
+	{
+		std::uint64_t first, size; // in elements
+	};
+
+	external_sort_stats stats = { 0, 0, 0 };
+	std::size_t const run_size = std::max<std::size_t>(1, memory / sizeof(T));
+	std::vector<run> runs;
+	detail::file runs_file = detail::file::temporary(); // all runs back to back
+
+	{// 1. Run formation
+		detail::file in(input, "rb");
+		array<T> buf(run_size);
+		for (std::uint64_t pos = 0;;)
+		{
+			std::size_t const n = std::fread(buf.data(), sizeof(T), run_size, in.get());
+			if (n < run_size && std::ferror(in.get()))
+				throw std::runtime_error("external_sort: read error");
+			bool const at_end = n < run_size || in.at_end();
+
+			std::sort(buf.data(), buf.data() + n, less);
+			stats.elements += n;
+
+			if (runs.empty() && at_end) // everything fit into memory
+			{
+				detail::file out(output, "wb");
+				detail::buffered_writer<T>::write_all(out.get(), buf.data(), n);
+				return stats;
+			}
+
+			if (n > 0)
+			{
+				detail::buffered_writer<T>::write_all(runs_file.get(), buf.data(), n);
+				runs.push_back({ pos, n });
+				pos += n;
+			}
+			if (at_end)
+				break;
+		}
+		stats.runs = runs.size();
+	}
+
+	// 2. Merge passes
+	std::size_t const fan_in = std::max<std::size_t>(3, memory / merge_block) - 1; // one block for the output
+	for (;;)
+	{
+		stats.merge_passes++;
+		bool const last = runs.size() <= fan_in;
+		detail::file out = last ? detail::file(output, "wb") : detail::file::temporary();
+		std::vector<run> merged;
+
+		for (std::size_t first = 0; first < runs.size(); first += fan_in)
+		{
+			std::size_t const k = std::min(fan_in, runs.size() - first);
+			std::size_t const block = std::max<std::size_t>(1, memory / (k + 1) / sizeof(T));
+			detail::buffered_writer<T> writer(out.get(), block);
+
+			std::vector<detail::buffered_reader<T>> readers;
+			readers.reserve(k);
+			detail::loser_tree<T, Less> tree(k, less);
+			std::uint64_t size = 0;
+			for (std::size_t s = 0; s < k; s++)
+			{
+				run const & r = runs[first + s];
+				readers.emplace_back(runs_file, block, r.first, r.size);
+				size += r.size;
+
+				T x;
+				if (readers[s].next(x))
+					tree.set(s, x);
+				else
+					tree.exhaust(s);
+			}
+			tree.init();
+
+			while (!tree.empty())
+			{
+				std::size_t const s = tree.winner();
+				writer.write(tree.top());
+
+				T x;
+				if (readers[s].next(x))
+					tree.set(s, x);
+				else
+					tree.exhaust(s);
+				tree.replay(s);
+			}
+			writer.flush();
+
+			merged.push_back({ merged.empty() ? 0 : merged.back().first + merged.back().size, size });
+		}
+
+		if (last)
+			break;
+		runs = std::move(merged);
+		runs_file = std::move(out); // closes (and removes) the previous runs
+	}
+
+	return stats;
+}
+} // namespace my
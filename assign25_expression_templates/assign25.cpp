@@ -0,0 +1,181 @@
+#include "myarray.h"
+#include "myexpr.h"
+#include "myvector.h"
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+
+
+// The style we want to replace: every operation returns a new array, built with the copy constructor
+static my::array<double> mul(my::array<double> const & a, my::array<double> const & b)
+{
+	my::array<double> result(a);
+	for (std::size_t i = 0; i < result.size(); i++)
+		result[i] *= b[i];
+	return result;
+}
+
+static my::array<double> add(my::array<double> const & a, my::array<double> const & b)
+{
+	my::array<double> result(a);
+	for (std::size_t i = 0; i < result.size(); i++)
+		result[i] += b[i];
+	return result;
+}
+
+static my::array<double> random_array(std::size_t n, unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	my::array<double> a(n);
+	for (std::size_t i = 0; i < n; i++)
+		a[i] = dist(rng);
+	return a;
+}
+
+// Times c = a * b + d with temporaries, a hand-written loop and an expression template
+static void benchmark(std::size_t n, int iter)
+{
+	my::array<double> const a = random_array(n, 1), b = random_array(n, 2), d = random_array(n, 3);
+	my::array<double> c1, c2(n), c3(n);
+	std::chrono::high_resolution_clock c;
+
+	// bytes read + written per evaluation: two ops, each copying one array and reading
+	// two/writing one in its loop, vs. reading three and writing one
+	double const mb = double(n * sizeof(double)) / (1024 * 1024) * iter;
+	double const mb_temporaries = 2 * 5 * mb, mb_fused = 4 * mb;
+
+	auto t1 = c.now();
+	for (int i = 0; i < iter; i++)
+		c1 = add(mul(a, b), d);
+	auto t2 = c.now();
+	auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+	std::cout << "tEval (" << n << ", temporaries): " << ms << "ms, " << mb_temporaries << "MB moved, " << mb_temporaries / (ms + 1) * 1000 << "MB/s" << std::endl;
+
+	t1 = c.now();
+	for (int i = 0; i < iter; i++)
+		for (std::size_t j = 0; j < n; j++)
+			c2[j] = a[j] * b[j] + d[j];
+	t2 = c.now();
+	ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+	std::cout << "tEval (" << n << ", hand-written loop): " << ms << "ms, " << mb_fused << "MB moved, " << mb_fused / (ms + 1) * 1000 << "MB/s" << std::endl;
+
+	t1 = c.now();
+	for (int i = 0; i < iter; i++)
+		c3 = a * b + d;
+	t2 = c.now();
+	ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+	std::cout << "tEval (" << n << ", expression template): " << ms << "ms, " << mb_fused << "MB moved, " << mb_fused / (ms + 1) * 1000 << "MB/s" << std::endl;
+
+	double const checksum = my::sum(my::abs(c1 - c2)) + my::sum(my::abs(c2 - c3));
+	std::cout << "(checksum " << checksum << ", should be 0)" << std::endl << std::endl;
+}
+
+int main()
+{
+	using namespace my;
+
+	{// Test elementwise arithmetic with scalars, evaluation into array and vector
+		array<double> a(4), b(4);
+		for (int i = 0; i < 4; i++)
+		{
+			a[i] = i;
+			b[i] = 10 * i;
+		}
+
+		array<double> c = a * b + 1;
+		assert(c.size() == 4);
+		for (int i = 0; i < 4; i++)
+			assert(c[i] == 10 * i * i + 1);
+
+		vector<double> v = (b - a) / 3.0;
+		assert(v.size() == 4 && v[3] == 9);
+		v = -v * 2 + a; // same size: no allocation, refers to itself
+		assert(v.size() == 4 && v[3] == -15);
+
+		vector<double> w;
+		w.push_back(1);
+		w = a + a; // grows
+		assert(w.size() == 4 && w[3] == 6);
+		w.reserve(10);
+		double const * data = w.data();
+		w = sqrt(a * a);
+		assert(w.size() == 4 && w.data() == data && w[2] == 2);
+
+		array<int> i3(3);
+		i3[0] = -1; i3[1] = 2; i3[2] = -3;
+		array<int> const i4 = abs(i3) * 2;
+		assert(i4[0] == 2 && i4[2] == 6);
+	}
+
+	{// Test assignment resizes arrays
+		array<double> a(3), b;
+		a[0] = 1; a[1] = 2; a[2] = 3;
+		b = a * 2;
+		assert(b.size() == 3 && b[2] == 6);
+		double const * data = b.data();
+		b = b + a;
+		assert(b.data() == data && b[2] == 9);
+	}
+
+	{// Test comparisons and reductions
+		vector<int> v;
+		for (int i = -5; i < 5; i++)
+			v.push_back(i);
+
+		assert(sum(v) == -5);
+		assert(sum(v < 0) == 5);
+		assert(sum(v * v) == 85);
+		assert(min(v) == -5 && max(v * 2) == 8);
+		assert(any(v == 3) && !any(v > 4));
+		assert(all(v >= -5) && !all(v != 0));
+		assert(all(v + 1 == 1 + v));
+
+		array<bool> const mask = v > 2;
+		assert(mask.size() == 10 && mask[9] && !mask[5]);
+
+		array<double> empty;
+		assert(sum(empty) == 0 && all(empty) && !any(empty));
+	}
+
+	{// Test expressions are lazy: nothing is computed before assignment
+		array<double> a(2);
+		a[0] = 1; a[1] = 2;
+		auto const e = a * 10;
+		a[1] = 3;
+		array<double> const b = e;
+		assert(b[1] == 30);
+		assert(e.size() == 2 && e[0] == 10);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	std::size_t const N = 10'000'000; // might need to adjust slightly for your machine
+
+	benchmark(N, 10);
+	benchmark(1000, 100'000); // fits into the cache: allocations dominate
+
+	{// Reduction: dot product
+		array<double> const a = random_array(N, 4), b = random_array(N, 5);
+		std::chrono::high_resolution_clock c;
+
+		auto t1 = c.now();
+		array<double> const tmp = mul(a, b);
+		double const dot1 = std::accumulate(tmp.data(), tmp.data() + N, 0.0);
+		auto t2 = c.now();
+		std::cout << "tDot (" << N << ", temporaries): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		double const dot2 = sum(a * b);
+		t2 = c.now();
+		std::cout << "tDot (" << N << ", expression template): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << std::abs(dot1 - dot2) << ", should be 0)" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,301 @@
+#pragma once
+
+#include "myarray.h"
+#include "myvector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace my {
+/**
+ * Base of all elementwise array expressions (curiously recurring template pattern):
+ * E is the concrete expression type, providing size() and operator[](i).
+ *
+ * a * b + d doesn't compute anything, it returns a small object describing the
+ * computation (a tree of the operations, referencing a, b and d). Only assigning
+ * it to an array/vector (or reducing it with sum() etc.) evaluates it, in a single
+ * loop over all elements, without any temporary arrays:
+ *
+ *	for (i = 0; i < n; i++) c[i] = a[i] * b[i] + d[i];
+ *
+ * Expressions reference their array operands (like a span), they must be evaluated
+ * before the operands are destroyed or resized. Don't store them in 'auto' variables
+ * unless all operands outlive them.
+ */
+template <typename E>
+class expr
+{
+public:
+	E const & self() const { return static_cast<E const &>(* this); }
+
+	std::size_t size() const { return self().size(); }
+	decltype(auto) operator[](std::size_t i) const { return self()[i]; }
+
+	/**
+	 * Evaluates all elements into dst.
+	 * @pre dst has room for size() elements
+	 * @exception might throw if T's assignment operator throws
+	 */
+	template <typename T>
+	void eval_to(T * dst) const
+	{
+		E const & e = self();
+		std::size_t const n = e.size();
+		for (std::size_t i = 0; i < n; i++)
+			dst[i] = e[i];
+	}
+};
+
+namespace detail {
+// Leaf: the elements of an array or vector
+template <typename T>
+class terminal : public expr<terminal<T>>
+{
+public:
+	static bool constexpr sized = true;
+
+	terminal(T const * data, std::size_t size) : _data(data), _size(size) {}
+
+	std::size_t size() const { return _size; }
+	T const & operator[](std::size_t i) const
+	{
+		assert(i < _size);
+		return _data[i];
+	}
+
+private:
+	T const * _data;
+	std::size_t _size;
+};
+
+// Leaf: a number, the same for all elements (a * 2)
+template <typename T>
+class scalar : public expr<scalar<T>>
+{
+public:
+	static bool constexpr sized = false;
+
+	explicit scalar(T value) : _value(value) {}
+
+	std::size_t size() const { return 0; }
+	T operator[](std::size_t) const { return _value; }
+
+private:
+	T _value;
+};
+
+template <typename Op, typename E>
+class unary : public expr<unary<Op, E>>
+{
+public:
+	static bool constexpr sized = true;
+
+	explicit unary(E const & e) : _e(e) {}
+
+	std::size_t size() const { return _e.size(); }
+	auto operator[](std::size_t i) const { return Op()(_e[i]); }
+
+private:
+	E _e; // subexpressions are stored by value, they are small
+};
+
+template <typename Op, typename L, typename R>
+class binary : public expr<binary<Op, L, R>>
+{
+public:
+	static bool constexpr sized = true;
+
+	/**
+	 * @pre l.size() == r.size() unless one of them is a scalar
+	 */
+	binary(L const & l, R const & r) : _l(l), _r(r), _size(L::sized ? l.size() : r.size())
+	{
+		assert(!L::sized || !R::sized || l.size() == r.size());
+	}
+
+	std::size_t size() const { return _size; }
+	auto operator[](std::size_t i) const { return Op()(_l[i], _r[i]); }
+
+private:
+	L _l;
+	R _r;
+	std::size_t _size;
+};
+
+template <typename X> struct is_container : std::false_type {};
+template <typename T> struct is_container<array<T>> : std::true_type {};
+template <typename T> struct is_container<vector<T>> : std::true_type {};
+
+template <typename E>
+std::true_type is_expr_test(expr<E> const *);
+std::false_type is_expr_test(...);
+
+// Arrays, vectors and expressions take part in elementwise operations ..
+template <typename X>
+bool constexpr is_operand = decltype(is_expr_test(std::declval<X *>()))::value || is_container<X>::value;
+
+// .. mixed with numbers, but at least one side must be an array operand
+// (so a + b of two ints remains the built-in operator)
+template <typename L, typename R>
+using enable_binary = std::enable_if_t<(is_operand<L> || is_operand<R>) &&
+	(is_operand<L> || std::is_arithmetic<L>::value) &&
+	(is_operand<R> || std::is_arithmetic<R>::value)>;
+
+template <typename X>
+using enable_unary = std::enable_if_t<is_operand<X>>;
+
+template <typename E>
+E const & as_expr(expr<E> const & e) { return e.self(); }
+template <typename T>
+terminal<T> as_expr(array<T> const & a) { return terminal<T>(a.data(), a.size()); }
+template <typename T>
+terminal<T> as_expr(vector<T> const & v) { return terminal<T>(v.data(), v.size()); }
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+scalar<T> as_expr(T x) { return scalar<T>(x); }
+
+template <typename X>
+using expr_of = std::decay_t<decltype(as_expr(std::declval<X const &>()))>;
+
+template <typename Op, typename L, typename R>
+binary<Op, expr_of<L>, expr_of<R>> make_binary(L const & l, R const & r)
+{
+	return binary<Op, expr_of<L>, expr_of<R>>(as_expr(l), as_expr(r));
+}
+
+template <typename Op, typename X>
+unary<Op, expr_of<X>> make_unary(X const & x)
+{
+	return unary<Op, expr_of<X>>(as_expr(x));
+}
+
+struct sqrt_op
+{
+	template <typename T>
+	auto operator()(T const & x) const { using std::sqrt; return sqrt(x); }
+};
+
+struct abs_op
+{
+	template <typename T>
+	auto operator()(T const & x) const { using std::abs; return abs(x); }
+};
+} // namespace detail
+
+
+
+/**
+ * Elementwise arithmetic of arrays, vectors, expressions and numbers (a * b + 1),
+ * see expr above.
+ * @pre Array operands have the same size
+ * @exception no-throw (builds the expression, evaluating it may throw)
+ */
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+auto operator+(L const & l, R const & r) { return detail::make_binary<std::plus<>>(l, r); }
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+auto operator-(L const & l, R const & r) { return detail::make_binary<std::minus<>>(l, r); }
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+auto operator*(L const & l, R const & r) { return detail::make_binary<std::multiplies<>>(l, r); }
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+auto operator/(L const & l, R const & r) { return detail::make_binary<std::divides<>>(l, r); }
+
+template <typename X, typename = detail::enable_unary<X>>
+auto operator-(X const & x) { return detail::make_unary<std::negate<>>(x); }
+template <typename X, typename = detail::enable_unary<X>>
+auto sqrt(X const & x) { return detail::make_unary<detail::sqrt_op>(x); }
+template <typename X, typename = detail::enable_unary<X>>
+auto abs(X const & x) { return detail::make_unary<detail::abs_op>(x); }
+
+/**
+ * Elementwise comparisons, expressions of bool (like std::valarray, a == b does
+ * not compare whole arrays, use all(a == b) for that).
+ * @pre Array operands have the same size
+ * @exception no-throw
+ */
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+auto operator==(L const & l, R const & r) { return detail::make_binary<std::equal_to<>>(l, r); }
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+auto operator!=(L const & l, R const & r) { return detail::make_binary<std::not_equal_to<>>(l, r); }
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+auto operator<(L const & l, R const & r) { return detail::make_binary<std::less<>>(l, r); }
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+auto operator<=(L const & l, R const & r) { return detail::make_binary<std::less_equal<>>(l, r); }
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+auto operator>(L const & l, R const & r) { return detail::make_binary<std::greater<>>(l, r); }
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+auto operator>=(L const & l, R const & r) { return detail::make_binary<std::greater_equal<>>(l, r); }
+
+/**
+ * Reductions, evaluate an expression (or array) in a single loop without storing it.
+ * sum() of a comparison counts the matching elements: sum(a < 0).
+ * @return Sum of all elements, 0 if empty
+ * @exception no-throw
+ */
+template <typename X, typename = detail::enable_unary<X>>
+auto sum(X const & x)
+{
+	auto const & e = detail::as_expr(x);
+	using R = decltype(e[0] + e[0]); // bool + bool is int
+	R result = R();
+	for (std::size_t i = 0; i < e.size(); i++)
+		result += e[i];
+	return result;
+}
+
+/**
+ * @return Smallest/largest element
+ * @pre x.size() > 0
+ * @exception no-throw
+ */
+template <typename X, typename = detail::enable_unary<X>>
+auto min(X const & x)
+{
+	auto const & e = detail::as_expr(x);
+	assert(e.size() > 0);
+	auto result = e[0];
+	for (std::size_t i = 1; i < e.size(); i++)
+		result = std::min(result, e[i]);
+	return result;
+}
+
+template <typename X, typename = detail::enable_unary<X>>
+auto max(X const & x)
+{
+	auto const & e = detail::as_expr(x);
+	assert(e.size() > 0);
+	auto result = e[0];
+	for (std::size_t i = 1; i < e.size(); i++)
+		result = std::max(result, e[i]);
+	return result;
+}
+
+/**
+ * @return true if any/all elements are true (stop at the first one deciding it)
+ * @exception no-throw
+ */
+template <typename X, typename = detail::enable_unary<X>>
+bool any(X const & x)
+{
+	auto const & e = detail::as_expr(x);
+	for (std::size_t i = 0; i < e.size(); i++)
+		if (e[i])
+			return true;
+	return false;
+}
+
+template <typename X, typename = detail::enable_unary<X>>
+bool all(X const & x)
+{
+	auto const & e = detail::as_expr(x);
+	for (std::size_t i = 0; i < e.size(); i++)
+		if (!e[i])
+			return false;
+	return true;
+}
+} // namespace my
@@ -0,0 +1,222 @@
+#include "myarray.h"
+#include "mystatic_vector.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+
+// A table-driven component: CRC-32 (as used by zip, PNG, Ethernet), "slicing by 8".
+// Table s * 256 + b holds the CRC of byte b followed by s zero bytes, so the
+// checksum advances 8 bytes per step with 8 independent table lookups.
+template <typename Table>
+constexpr void fill_crc_table(Table & t)
+{
+	for (std::uint32_t b = 0; b < 256; b++)
+	{
+		std::uint32_t c = b;
+		for (int k = 0; k < 8; k++)
+			c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+		t[b] = c;
+	}
+	for (std::size_t s = 1; s < 8; s++)
+		for (std::size_t b = 0; b < 256; b++)
+		{
+			std::uint32_t const prev = t[(s - 1) * 256 + b];
+			t[s * 256 + b] = (prev >> 8) ^ t[prev & 0xFF];
+		}
+}
+
+template <typename Table>
+constexpr std::uint32_t crc32(Table const & t, char const * data, std::size_t n)
+{
+	auto byte = [data](std::size_t i) { return static_cast<std::uint32_t>(static_cast<unsigned char>(data[i])); };
+
+	std::uint32_t c = 0xFFFFFFFF;
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8)
+	{
+		std::uint32_t const lo = c ^ (byte(i) | byte(i + 1) << 8 | byte(i + 2) << 16 | byte(i + 3) << 24);
+		c = t[7 * 256 + (lo & 0xFF)] ^ t[6 * 256 + (lo >> 8 & 0xFF)] ^ t[5 * 256 + (lo >> 16 & 0xFF)] ^ t[4 * 256 + (lo >> 24)] ^
+			t[3 * 256 + byte(i + 4)] ^ t[2 * 256 + byte(i + 5)] ^ t[256 + byte(i + 6)] ^ t[byte(i + 7)];
+	}
+	for (; i < n; i++)
+		c = t[(c ^ byte(i)) & 0xFF] ^ (c >> 8);
+	return ~c;
+}
+
+constexpr my::static_array<std::uint32_t, 8 * 256> make_crc_table()
+{
+	my::static_array<std::uint32_t, 8 * 256> t;
+	fill_crc_table(t);
+	return t;
+}
+
+// Computed by the compiler, stored in .rodata
+static constexpr my::static_array<std::uint32_t, 8 * 256> crc_table = make_crc_table();
+
+static std::uint32_t crc32_constexpr(char const * data, std::size_t n)
+{
+	return crc32(crc_table, data, n);
+}
+
+// The same table built at run time, on first use
+static std::uint32_t crc32_lazy(char const * data, std::size_t n)
+{
+	static my::array<std::uint32_t> const table = []() {
+		my::array<std::uint32_t> t(8 * 256);
+		fill_crc_table(t);
+		return t;
+	}();
+	return crc32(table, data, n);
+}
+
+static_assert(crc32(crc_table, "123456789", 9) == 0xCBF43926, "CRC-32 check value");
+static_assert(crc32(crc_table, "", 0) == 0, "CRC-32 of nothing");
+
+// All primes below n, computed at compile time, size unknown upfront
+template <std::size_t Capacity, std::size_t N>
+constexpr my::static_vector<int, Capacity> primes_below()
+{
+	my::static_array<bool, N> composite;
+	my::static_vector<int, Capacity> result;
+	for (std::size_t i = 2; i < N; i++)
+		if (!composite[i])
+		{
+			result.push_back(static_cast<int>(i));
+			for (std::size_t j = i * i; j < N; j += i)
+				composite[j] = true;
+		}
+	return result;
+}
+
+int main()
+{
+	using namespace my;
+
+	{// Test static_array
+		static_array<int, 4> a;
+		assert(a.size() == 4 && a[0] == 0 && a[3] == 0);
+
+		static_array<int, 4> b = { 1, 2, 3 };
+		assert(b[2] == 3 && b[3] == 0);
+		b.fill(7);
+		assert(b[0] == 7 && b[3] == 7);
+
+		a = b; // copies the elements
+		assert(a == b);
+		a[1] = 0;
+		assert(a != b && b[1] == 7);
+
+		static_assert(sizeof(static_array<int, 4>) == 4 * sizeof(int), "no overhead");
+	}
+
+	{// Test static_vector
+		static_vector<std::vector<int>, 3> v;
+		assert(v.empty() && v.capacity() == 3);
+
+		v.push_back({ 1, 2 });
+		v.push_back({ 3 });
+		v.push_back({});
+		assert(v.size() == 3 && v.full() && v[0].size() == 2 && v.back().empty());
+
+		bool thrown = false;
+		try
+		{
+			v.push_back({ 4 });
+		}
+		catch (std::length_error const &)
+		{
+			thrown = true;
+		}
+		assert(thrown && v.size() == 3);
+
+		v.pop_back();
+		v.pop_back();
+		assert(v.size() == 1 && v.data()[1].empty()); // releases the popped element
+		v.resize(2);
+		assert(v.size() == 2 && v[1].empty());
+		v.clear();
+		assert(v.empty());
+
+		static_vector<int, 8> a = { 1, 2, 3 }, b;
+		for (int x : a)
+			b.push_back(x);
+		assert(a == b);
+		b.pop_back();
+		assert(a != b);
+	}
+
+	{// Test constexpr: tables computed at compile time
+		constexpr auto primes = primes_below<200, 1000>();
+		static_assert(primes.size() == 168, "168 primes below 1000");
+		static_assert(primes[0] == 2 && primes.back() == 997, "");
+
+		constexpr static_vector<int, 4> v = { 3, 1, 4 };
+		static_assert(v.size() == 3 && v[2] == 4, "");
+
+		static_assert(crc32(crc_table, "The quick brown fox jumps over the lazy dog", 43) == 0x414FA339, "");
+
+		// same results at run time (leaving crc32_lazy()/crc_table untouched for the benchmark)
+		array<std::uint32_t> t(8 * 256);
+		fill_crc_table(t);
+		char const text[] = "The quick brown fox jumps over the lazy dog";
+		assert(crc32(t, text, 43) == 0x414FA339 && crc32(t, "123456789", 9) == 0xCBF43926);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	std::size_t const N = 64 * 1024 * 1024; // might need to adjust slightly for your machine
+	std::chrono::high_resolution_clock c;
+
+	{// Startup: building the table at run time (the work a global table adds before main())
+		auto t1 = c.now();
+		my::array<std::uint32_t> t(8 * 256);
+		fill_crc_table(t);
+		auto t2 = c.now();
+		std::cout << "tStartup (run-time table): " << std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() << "ns" << std::endl;
+		std::cout << "tStartup (constexpr table): 0ns (nothing to run, " << sizeof(crc_table) << " bytes of .rodata)" << std::endl;
+		std::cout << "(checksum " << (t[8 * 256 - 1] != crc_table[8 * 256 - 1]) << ", should be 0)" << std::endl;
+	}
+
+	std::vector<char> data(N);
+	std::mt19937 rng(1);
+	for (auto & x : data)
+		x = static_cast<char>(rng());
+
+	{// First call latency: the lazy table is built now, the constexpr one is only
+	 // paged in (the tests above didn't touch either)
+		char const msg[] = "a short message of 32 bytes.....";
+
+		auto t1 = c.now();
+		std::uint32_t const crc1 = crc32_constexpr(msg, 32);
+		auto t2 = c.now();
+		std::cout << "tFirstCall (constexpr table): " << std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() << "ns" << std::endl;
+
+		t1 = c.now();
+		std::uint32_t const crc2 = crc32_lazy(msg, 32);
+		t2 = c.now();
+		std::cout << "tFirstCall (lazy run-time table): " << std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() << "ns" << std::endl;
+		std::cout << "(checksum " << (crc1 ^ crc2) << ", should be 0)" << std::endl;
+	}
+
+	{// Steady state: same table, same code
+		auto t1 = c.now();
+		std::uint32_t const crc1 = crc32_constexpr(data.data(), N);
+		auto t2 = c.now();
+		std::cout << "tCrc (" << N / (1024 * 1024) << "MB, constexpr table): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		std::uint32_t const crc2 = crc32_lazy(data.data(), N);
+		t2 = c.now();
+		std::cout << "tCrc (" << N / (1024 * 1024) << "MB, lazy run-time table): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << (crc1 ^ crc2) << ", should be 0)" << std::endl;
+	}
+
+	return 0;
+}
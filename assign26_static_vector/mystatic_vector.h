@@ -0,0 +1,269 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+
+
+
+namespace my {
+/**
+ * Fixed size array of N elements stored inline (simplified version of std::array):
+ * no heap allocation, and all operations are constexpr, so a static_array can be
+ * computed at compile time. A constexpr static_array variable is a plain constant:
+ * the compiler puts it into the read-only data of the executable (.rodata), it
+ * needs no initialization at run time at all.
+ *
+ * Unlike my::array, the size is part of the type and copies are element by element
+ * (there's no pointer to steal, so moving is copying).
+ * @pre T is default constructible (and a literal type for constexpr use)
+ */
+template <typename T, std::size_t N>
+class static_array
+{
+public:
+	/**
+	 * Constructor, value-initializes all elements (0 for numbers).
+	 * @exception might throw if T's constructor throws
+	 */
+	constexpr static_array() : _data{} {}
+
+	/**
+	 * Constructor, copies the values of 'init', the remaining elements are value-initialized.
+	 * @pre init.size() <= N
+	 * @exception might throw if T's copy assignment operator throws
+	 */
+	constexpr static_array(std::initializer_list<T> init) : _data{}
+	{
+		assert(init.size() <= N);
+		std::size_t i = 0;
+		for (T const & x : init)
+			_data[i++] = x;
+	}
+
+	/**
+	 * @return N
+	 * @exception no-throw
+	 */
+	static constexpr std::size_t size() { return N; }
+
+	/**
+	 * @return Raw pointer to the data
+	 * @exception no-throw
+	 */
+	constexpr T * data() { return _data; }
+	constexpr T const * data() const { return _data; }
+
+	/**
+	 * @return Iterators (raw pointers) to the first and one past the last element
+	 * @exception no-throw
+	 */
+	constexpr T * begin() { return _data; }
+	constexpr T * end() { return _data + N; }
+	constexpr T const * begin() const { return _data; }
+	constexpr T const * end() const { return _data + N; }
+
+	/**
+	 * @return (Reference to) element at index i
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	constexpr T & operator[](std::size_t i)
+	{
+		assert(i < N);
+		return _data[i];
+	}
+	constexpr T const & operator[](std::size_t i) const
+	{
+		assert(i < N);
+		return _data[i];
+	}
+
+	/**
+	 * Assigns 'value' to all elements.
+	 * @exception might throw if T's copy assignment operator throws
+	 */
+	constexpr void fill(T const & value)
+	{
+		for (std::size_t i = 0; i < N; i++)
+			_data[i] = value;
+	}
+
+private:
+	T _data[N > 0 ? N : 1];
+};
+
+template <typename T, std::size_t N>
+constexpr bool operator==(static_array<T, N> const & a, static_array<T, N> const & b)
+{
+	for (std::size_t i = 0; i < N; i++)
+		if (!(a[i] == b[i]))
+			return false;
+	return true;
+}
+
+template <typename T, std::size_t N>
+constexpr bool operator!=(static_array<T, N> const & a, static_array<T, N> const & b) { return !(a == b); }
+
+
+
+/**
+ * Growable sequence of up to N elements stored inline (like C++26's std::inplace_vector):
+ * the interface of my::vector, but it never allocates, its capacity is fixed, and
+ * all operations are constexpr. Use it for small sequences whose maximum size is
+ * known, and for tables computed at compile time whose size isn't known upfront
+ * (e.g. "all primes below 1000").
+ *
+ * C++17 can't construct objects in raw storage during constant evaluation (that
+ * requires std::construct_at, C++20). So the storage is a T[N], all N elements
+ * exist at all times, and the ones at positions >= size() are value-initialized
+ * placeholders: T must be default constructible, and T's destructor only runs
+ * with the static_vector's.
+ * @invariant size() <= capacity() == N
+ */
+template <typename T, std::size_t N>
+class static_vector
+{
+public:
+	/**
+	 * Constructor, creates an empty vector.
+	 * @exception might throw if T's constructor throws
+	 * @post size() == 0, capacity() == N
+	 */
+	constexpr static_vector() : _data{}, _size(0) {}
+
+	/**
+	 * Constructor, copies the values of 'init'.
+	 * @exception std::length_error if init.size() > N
+	 */
+	constexpr static_vector(std::initializer_list<T> init) : _data{}, _size(0)
+	{
+		for (T const & x : init)
+			push_back(x);
+	}
+
+	/**
+	 * @return number of elements currently stored in the vector
+	 * @exception no-throw
+	 */
+	constexpr std::size_t size() const { return _size; }
+	static constexpr std::size_t capacity() { return N; }
+	constexpr bool empty() const { return _size == 0; }
+	constexpr bool full() const { return _size == N; }
+
+	/**
+	 * @return raw pointer to underlying data
+	 * @exception no-throw
+	 */
+	constexpr T * data() { return _data; }
+	constexpr T const * data() const { return _data; }
+
+	/**
+	 * @return Iterators (raw pointers) to the first and one past the last element
+	 * @exception no-throw
+	 */
+	constexpr T * begin() { return _data; }
+	constexpr T * end() { return _data + _size; }
+	constexpr T const * begin() const { return _data; }
+	constexpr T const * end() const { return _data + _size; }
+
+	/**
+	 * @return Element at index i
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	constexpr T & operator[](std::size_t i)
+	{
+		assert(i < _size);
+		return _data[i];
+	}
+	constexpr T const & operator[](std::size_t i) const
+	{
+		assert(i < _size);
+		return _data[i];
+	}
+
+	constexpr T & back()
+	{
+		assert(_size > 0);
+		return _data[_size - 1];
+	}
+	constexpr T const & back() const
+	{
+		assert(_size > 0);
+		return _data[_size - 1];
+	}
+
+	/**
+	 * Appends the element 'val' to the end of this vector.
+	 * @exception std::length_error if the vector is full (during constant evaluation:
+	 * a compile error), or if T's copy assignment operator throws.
+	 * Provides strong exception safety.
+	 * @post size() grows by 1
+	 */
+	constexpr void push_back(T const & val)
+	{
+		if (_size == N)
+			throw std::length_error("static_vector: capacity exceeded");
+
+		_data[_size] = val;
+		_size++;
+	}
+
+	/**
+	 * Removes the last element (assigns a value-initialized T to its slot, so it
+	 * releases what it holds).
+	 * @pre size() > 0
+	 * @exception might throw if T's move assignment operator throws
+	 * @post size() shrinks by 1
+	 */
+	constexpr void pop_back()
+	{
+		assert(_size > 0);
+		_size--;
+		_data[_size] = T();
+	}
+
+	/**
+	 * Changes the number of elements to n, appending value-initialized elements
+	 * or dropping elements at the end.
+	 * @exception std::length_error if n > capacity()
+	 * @post size() == n
+	 */
+	constexpr void resize(std::size_t n)
+	{
+		if (n > N)
+			throw std::length_error("static_vector: capacity exceeded");
+
+		for (std::size_t i = n; i < _size; i++)
+			_data[i] = T();
+		_size = n;
+	}
+
+	/**
+	 * Removes all elements.
+	 * @exception might throw if T's move assignment operator throws
+	 * @post size() == 0
+	 */
+	constexpr void clear() { resize(0); }
+
+private:
+	T _data[N > 0 ? N : 1];
+	std::size_t _size;
+};
+
+template <typename T, std::size_t N>
+constexpr bool operator==(static_vector<T, N> const & a, static_vector<T, N> const & b)
+{
+	if (a.size() != b.size())
+		return false;
+	for (std::size_t i = 0; i < a.size(); i++)
+		if (!(a[i] == b[i]))
+			return false;
+	return true;
+}
+
+template <typename T, std::size_t N>
+constexpr bool operator!=(static_vector<T, N> const & a, static_vector<T, N> const & b) { return !(a == b); }
+} // namespace my
@@ -0,0 +1,212 @@
+#include "myslot_map.h"
+#include "myvector.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+
+
+struct particle
+{
+	float x = 0, y = 0, vx = 0, vy = 0;
+};
+
+int main()
+{
+	using namespace my;
+	using handle = slot_map<std::string>::handle;
+
+	{// Test slot_map()
+		slot_map<std::string> m;
+
+		assert(m.size() == 0);
+		assert(m.empty());
+		assert(m.begin() == m.end());
+		assert(!m.contains({ 0, 0 }) && m.find({ 0, 0 }) == nullptr);
+	}
+
+	{// Test insert()/operator[]/find()/iteration
+		slot_map<std::string> m;
+		handle const a = m.insert("a"), b = m.insert("b"), c = m.insert("c");
+
+		assert(m.size() == 3 && a != b);
+		assert(m[a] == "a" && m[b] == "b" && * m.find(c) == "c");
+		m[b] += "b";
+
+		std::string all;
+		for (std::string const & s : m)
+			all += s;
+		assert(all == "abbc");
+		for (std::size_t i = 0; i < m.size(); i++)
+			assert(m[m.handle_at(i)] == m.data()[i]);
+	}
+
+	{// Test erase(): swap-and-pop, handles stay valid, stale handles are detected
+		slot_map<std::string> m;
+		handle h[5];
+		for (int i = 0; i < 5; i++)
+			h[i] = m.insert(std::to_string(i));
+
+		assert(m.erase(h[1]) == 1);
+		assert(m.size() == 4 && !m.contains(h[1]) && m.find(h[1]) == nullptr);
+		assert(m.data()[1] == "4"); // the last value moved into the hole
+		assert(m.erase(h[1]) == 0);
+		handle const forged = { h[1].index, h[1].generation + 1 }; // free slot, current generation
+		assert(!m.contains(forged) && m.find(forged) == nullptr && m.erase(forged) == 0);
+		for (int i : { 0, 2, 3, 4 })
+			assert(m[h[i]] == std::to_string(i));
+
+		handle const x = m.insert("x"); // reuses the slot of h[1], with a new generation
+		assert(x.index == h[1].index && x.generation != h[1].generation);
+		assert(!m.contains(h[1]) && m[x] == "x");
+
+		assert(m.erase(h[4]) == 1 && m.erase(h[0]) == 1);
+		assert(m.size() == 3 && m[h[2]] == "2" && m[h[3]] == "3" && m[x] == "x");
+	}
+
+	{// Test clear(): all handles become stale, slots are reused
+		slot_map<int> m;
+		auto const a = m.insert(1), b = m.insert(2);
+		m.clear();
+		assert(m.empty() && !m.contains(a) && !m.contains(b));
+
+		auto const c = m.insert(3);
+		assert(c.index < 2 && m.size() == 1 && m[c] == 3 && !m.contains(a) && !m.contains(b));
+	}
+
+	{// Test many inserts and erases against a reference
+		slot_map<int> m;
+		std::unordered_map<std::uint64_t, int> ref; // handle -> value
+		vector<slot_map<int>::handle> live;
+		std::mt19937 rng(7);
+		auto key = [](slot_map<int>::handle h) { return std::uint64_t(h.index) << 32 | h.generation; };
+
+		for (int i = 0; i < 100'000; i++)
+		{
+			if (live.empty() || rng() % 3 != 0)
+			{
+				auto const h = m.insert(i);
+				live.push_back(h);
+				ref[key(h)] = i;
+			}
+			else
+			{
+				std::size_t const j = rng() % live.size();
+				assert(m.erase(live[j]) == 1);
+				ref.erase(key(live[j]));
+				live[j] = live[live.size() - 1];
+				live.pop_back();
+			}
+		}
+		assert(m.size() == ref.size());
+		for (std::size_t i = 0; i < live.size(); i++)
+			assert(m[live[i]] == ref[key(live[i])]);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 100; // might need to adjust slightly for your machine
+	std::size_t const N = 100'000; // live particles
+	std::size_t const CHURN = N / 10; // destroyed and created per round
+
+	std::chrono::high_resolution_clock c;
+	double checksum[3] = {};
+
+	{// std::list, handle: iterator
+		std::mt19937 rng(1);
+		std::list<particle> l;
+		vector<std::list<particle>::iterator> handles;
+		for (std::size_t i = 0; i < N; i++)
+			handles.push_back(l.insert(l.end(), particle{ float(i), 0, 1, 1 }));
+
+		auto t1 = c.now();
+		for (int it = 0; it < ITER; it++)
+		{
+			for (std::size_t i = 0; i < CHURN; i++)
+			{
+				std::size_t const j = rng() % N;
+				l.erase(handles[j]);
+				handles[j] = l.insert(l.end(), particle{ float(j), 0, 1, 1 });
+			}
+			for (particle & p : l)
+			{
+				p.x += p.vx;
+				p.y += p.vy;
+			}
+		}
+		auto t2 = c.now();
+		for (particle const & p : l)
+			checksum[0] += p.x;
+		std::cout << "tChurnIterate (std::list): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+	}
+
+	{// std::unordered_map, handle: key
+		std::mt19937 rng(1);
+		std::unordered_map<std::uint64_t, particle> m;
+		vector<std::uint64_t> handles;
+		std::uint64_t next_key = 0;
+		for (std::size_t i = 0; i < N; i++)
+		{
+			m[next_key] = particle{ float(i), 0, 1, 1 };
+			handles.push_back(next_key++);
+		}
+
+		auto t1 = c.now();
+		for (int it = 0; it < ITER; it++)
+		{
+			for (std::size_t i = 0; i < CHURN; i++)
+			{
+				std::size_t const j = rng() % N;
+				m.erase(handles[j]);
+				m[next_key] = particle{ float(j), 0, 1, 1 };
+				handles[j] = next_key++;
+			}
+			for (auto & kv : m)
+			{
+				kv.second.x += kv.second.vx;
+				kv.second.y += kv.second.vy;
+			}
+		}
+		auto t2 = c.now();
+		for (auto const & kv : m)
+			checksum[1] += kv.second.x;
+		std::cout << "tChurnIterate (std::unordered_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+	}
+
+	{// slot_map, handle: handle
+		std::mt19937 rng(1);
+		slot_map<particle> m;
+		vector<slot_map<particle>::handle> handles;
+		for (std::size_t i = 0; i < N; i++)
+			handles.push_back(m.insert(particle{ float(i), 0, 1, 1 }));
+
+		auto t1 = c.now();
+		for (int it = 0; it < ITER; it++)
+		{
+			for (std::size_t i = 0; i < CHURN; i++)
+			{
+				std::size_t const j = rng() % N;
+				m.erase(handles[j]);
+				handles[j] = m.insert(particle{ float(j), 0, 1, 1 });
+			}
+			for (particle & p : m)
+			{
+				p.x += p.vx;
+				p.y += p.vy;
+			}
+		}
+		auto t2 = c.now();
+		for (particle const & p : m)
+			checksum[2] += p.x;
+		std::cout << "tChurnIterate (slot_map): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+	}
+	std::cout << "(checksum " << (checksum[0] != checksum[1]) + (checksum[1] != checksum[2]) << ", should be 0)" << std::endl;
+
+	return 0;
+}
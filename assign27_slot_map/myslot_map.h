@@ -0,0 +1,232 @@
+#pragma once
+
+#include "myvector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+
+
+namespace my {
+/**
+ * Container handing out stable handles to its elements, with O(1) insert, erase
+ * and lookup, and iteration over a dense array.
+ *
+ * - The values live in a dense vector without holes: iterating is as fast as
+ *   iterating a my::vector. Erasing moves the last value into the hole
+ *   (swap-and-pop), so the order of the values changes, and so do their addresses.
+ * - A handle is the index of a *slot* in a sparse indirection table, which stores
+ *   where in the dense vector its value currently is. Slots never move.
+ * - Every slot has a generation counter, incremented whenever its value is erased.
+ *   A handle carries the generation it was issued with, so a handle to an erased
+ *   value (a 'stale' handle) no longer matches, even after the slot was reused.
+ *   Free slots form a linked list through their index field.
+ *
+ * Generations are 32 bit: a handle could wrongly match again after its slot was
+ * reused 2^32 times.
+ * @invariant _slots[_owner[i]].index == i for all i < size()
+ */
+template <typename T>
+class slot_map
+{
+public:
+	struct handle
+	{
+		std::uint32_t index;		// of the slot
+		std::uint32_t generation;	// of the slot when the value was inserted
+
+		friend bool operator==(handle a, handle b) { return a.index == b.index && a.generation == b.generation; }
+		friend bool operator!=(handle a, handle b) { return !(a == b); }
+	};
+
+	/**
+	 * Constructor, creates an empty map. Does not allocate.
+	 * @exception no-throw
+	 * @post size() == 0
+	 */
+	slot_map() : _free(npos) {}
+
+	/**
+	 * @return Number of values in the map
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _values.size(); }
+	bool empty() const { return _values.empty(); }
+
+	/**
+	 * @return The dense array of values, in no particular order. Inserting and
+	 * erasing invalidate pointers and iterators (but not handles).
+	 * @exception no-throw
+	 */
+	T * data() { return _values.data(); }
+	T const * data() const { return _values.data(); }
+
+	T * begin() { return _values.begin(); }
+	T * end() { return _values.end(); }
+	T const * begin() const { return _values.begin(); }
+	T const * end() const { return _values.end(); }
+
+	/**
+	 * @return Handle of the value at data()[i], e.g. to erase values found while iterating
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	handle handle_at(std::size_t i) const
+	{
+		assert(i < size());
+		std::uint32_t const s = _owner[i];
+		return { s, _slots[s].generation };
+	}
+
+	/**
+	 * Inserts 'val', reusing a free slot if there is one.
+	 * @return The handle of the new value
+	 * @exception might throw if not enough memory is available, or std::length_error
+	 * if the map would have more than 2^32 - 1 slots. Provides strong exception safety.
+	 * @post contains(result) && size() grows by 1
+	 */
+	handle insert(T const & val)
+	{
+		if (_free == npos && _slots.size() == npos)
+			throw std::length_error("slot_map: too many slots");
+
+		// grow everything upfront, so nothing below can fail halfway
+		if (_free == npos)
+			reserve_one(_slots);
+		reserve_one(_owner);
+		_values.push_back(val);
+
+		std::uint32_t s = _free;
+		if (s == npos)
+		{
+			s = static_cast<std::uint32_t>(_slots.size());
+			_slots.push_back({ 0, 0 });
+		}
+		else
+			_free = _slots[s].index;
+
+		_slots[s].index = static_cast<std::uint32_t>(_values.size() - 1);
+		_owner.push_back(s);
+		return { s, _slots[s].generation };
+	}
+
+	/**
+	 * @return true if h refers to a value in this map (it wasn't erased). Also false
+	 * for handles of other maps or made up ones that point to a free slot.
+	 * @exception no-throw
+	 */
+	bool contains(handle h) const
+	{
+		if (h.index >= _slots.size())
+			return false;
+		slot const & sl = _slots[h.index];
+		return sl.generation == h.generation && sl.index < size() && _owner[sl.index] == h.index;
+	}
+
+	/**
+	 * @return Pointer to the value of h, nullptr if it was erased. Valid until the
+	 * next insert or erase.
+	 * @exception no-throw
+	 */
+	T * find(handle h) { return contains(h) ? & _values[_slots[h.index].index] : nullptr; }
+	T const * find(handle h) const { return contains(h) ? & _values[_slots[h.index].index] : nullptr; }
+
+	/**
+	 * @return Value of h
+	 * @pre contains(h)
+	 * @exception no-throw
+	 */
+	T & operator[](handle h)
+	{
+		assert(contains(h));
+		return _values[_slots[h.index].index];
+	}
+	T const & operator[](handle h) const
+	{
+		assert(contains(h));
+		return _values[_slots[h.index].index];
+	}
+
+	/**
+	 * Erases the value of h: moves the last value into its place and frees its slot.
+	 * @return Number of values erased (0 if h is stale)
+	 * @exception might throw if T's move assignment throws
+	 * @post !contains(h)
+	 */
+	std::size_t erase(handle h)
+	{
+		if (!contains(h))
+			return 0;
+
+		slot & sl = _slots[h.index];
+		std::size_t const i = sl.index, last = _values.size() - 1;
+		if (i != last)
+		{
+			_values[i] = std::move(_values[last]);
+			_owner[i] = _owner[last];
+			_slots[_owner[i]].index = static_cast<std::uint32_t>(i);
+		}
+		_values.pop_back();
+		_owner.pop_back();
+
+		sl.generation++;
+		sl.index = _free;
+		_free = h.index;
+		return 1;
+	}
+
+	/**
+	 * Erases all values, all handles become stale. Keeps the capacity.
+	 * @exception no-throw
+	 * @post size() == 0
+	 */
+	void clear()
+	{
+		for (std::size_t i = 0; i < _owner.size(); i++)
+		{
+			std::uint32_t const s = _owner[i];
+			_slots[s].generation++;
+			_slots[s].index = _free;
+			_free = s;
+		}
+		_values.clear();
+		_owner.clear();
+	}
+
+	/**
+	 * Grows the capacity to n values without reallocating.
+	 * @exception might throw if not enough memory is available
+	 */
+	void reserve(std::size_t n)
+	{
+		_values.reserve(n);
+		_owner.reserve(n);
+		_slots.reserve(n);
+	}
+
+private:
+	static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+	// Makes room for one more element, growing by 1.5x like push_back()
+	template <typename U>
+	static void reserve_one(vector<U> & v)
+	{
+		if (v.size() == v.capacity())
+			v.reserve(v.capacity() + v.capacity() / 2 + 1);
+	}
+
+	struct slot
+	{
+		std::uint32_t index;		// in _values if in use, else the next free slot
+		std::uint32_t generation;
+	};
+
+	vector<T> _values;		// dense
+	vector<std::uint32_t> _owner;	// slot of _values[i]
+	vector<slot> _slots;		// sparse, indexed by handle::index
+	std::uint32_t _free;		// head of the free slot list, npos if empty
+};
+} // namespace my
@@ -0,0 +1,218 @@
+#include "myhive.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+
+
+// Erase pattern: about 'percent'% of the values, scattered
+static bool doomed(int x, int percent) { return (x * 7919u) % 100 < unsigned(percent); }
+
+int main()
+{
+	using namespace my;
+
+	{// Test hive()
+		hive<int> h;
+
+		assert(h.size() == 0 && h.capacity() == 0);
+		assert(h.empty());
+		assert(h.begin() == h.end());
+	}
+
+	{// Test insert()/iteration, blocks grow geometrically, pointers are stable
+		hive<int> h;
+		std::vector<int *> ptrs;
+		for (int i = 0; i < 100; i++)
+			ptrs.push_back(& * h.insert(i));
+
+		assert(h.size() == 100);
+		assert(h.capacity() == 128); // 8 + 8 + 16 + 32 + 64
+		std::multiset<int> seen(h.begin(), h.end());
+		assert(seen.size() == 100 && * seen.begin() == 0 && * seen.rbegin() == 99);
+		for (int i = 0; i < 100; i++)
+			assert(* ptrs[i] == i);
+	}
+
+	{// Test erase(): returns the next element, skips runs of erased elements
+		hive<std::string> h;
+		std::vector<hive<std::string>::iterator> its;
+		for (int i = 0; i < 8; i++)
+			its.push_back(h.insert(std::to_string(i))); // one block, in order
+
+		auto it = h.erase(its[3]);
+		assert(* it == "4" && h.size() == 7);
+		it = h.erase(its[5]);
+		assert(* it == "6");
+		it = h.erase(its[4]); // merges 3, 4, 5 into one run
+		assert(* it == "6");
+		h.erase(its[0]);
+		h.erase(its[7]);
+
+		std::string all;
+		for (std::string const & s : h)
+			all += s;
+		assert(all == "126");
+
+		// holes are reused, the rest stays where it was
+		std::string const * p6 = & * its[6];
+		for (int i = 0; i < 5; i++)
+			h.insert("x");
+		assert(h.size() == 8 && h.capacity() == 8 && & * its[6] == p6 && * p6 == "6");
+	}
+
+	{// Test erase everything, empty blocks are skipped and reused
+		hive<int> h;
+		for (int i = 0; i < 1000; i++)
+			h.insert(i);
+		std::size_t const cap = h.capacity();
+
+		for (auto it = h.begin(); it != h.end();)
+			it = * it % 2 ? h.erase(it) : std::next(it);
+		assert(h.size() == 500);
+		for (int x : h)
+			assert(x % 2 == 0);
+
+		for (auto it = h.begin(); it != h.end();)
+			it = h.erase(it);
+		assert(h.empty() && h.begin() == h.end() && h.capacity() == cap);
+
+		for (int i = 0; i < 1000; i++)
+			h.insert(i);
+		assert(h.size() == 1000 && h.capacity() == cap);
+
+		h.clear();
+		assert(h.empty() && h.capacity() == 0 && h.begin() == h.end());
+	}
+
+	{// Test random inserts and erases against a reference
+		hive<int> h;
+		std::vector<hive<int>::iterator> live;
+		std::multiset<int> ref;
+		std::mt19937 rng(5);
+		for (int i = 0; i < 20'000; i++)
+		{
+			if (live.empty() || rng() % 5 < 3)
+			{
+				live.push_back(h.insert(i));
+				ref.insert(i);
+			}
+			else
+			{
+				std::size_t const j = rng() % live.size();
+				ref.erase(ref.find(* live[j]));
+				h.erase(live[j]);
+				live[j] = live.back();
+				live.pop_back();
+			}
+		}
+		assert(h.size() == ref.size() && std::multiset<int>(h.begin(), h.end()) == ref);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 1'000'000; // might need to adjust slightly for your machine
+
+	std::vector<int> v;
+	std::list<int> l;
+	hive<int> h;
+	{// Insert
+		std::chrono::high_resolution_clock c;
+
+		auto t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			v.push_back(i);
+		auto t2 = c.now();
+		std::cout << "tInsert (vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			l.push_back(i);
+		t2 = c.now();
+		std::cout << "tInsert (list): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int i = 0; i < ITER; i++)
+			h.insert(i);
+		t2 = c.now();
+		std::cout << "tInsert (hive): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+	}
+
+	// Erase a growing share of the original elements, then traverse what remains.
+	// (vector erases with remove_if: fast, but all remaining elements move.)
+	for (int percent : { 0, 25, 50, 90 })
+	{
+		std::cout << std::endl;
+		std::chrono::high_resolution_clock c;
+
+		auto t1 = c.now();
+		v.erase(std::remove_if(v.begin(), v.end(), [percent](int x) { return doomed(x, percent); }), v.end());
+		auto t2 = c.now();
+		std::cout << "tErase (vector, " << percent << "%): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (auto it = l.begin(); it != l.end();)
+			it = doomed(* it, percent) ? l.erase(it) : std::next(it);
+		t2 = c.now();
+		std::cout << "tErase (list, " << percent << "%): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (auto it = h.begin(); it != h.end();)
+			it = doomed(* it, percent) ? h.erase(it) : std::next(it);
+		t2 = c.now();
+		std::cout << "tErase (hive, " << percent << "%): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		long long sum[3] = {};
+		t1 = c.now();
+		for (int k = 0; k < 100; k++)
+			for (int x : v)
+				sum[0] += x;
+		t2 = c.now();
+		std::cout << "tTraverse (vector, " << percent << "%): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int k = 0; k < 100; k++)
+			for (int x : l)
+				sum[1] += x;
+		t2 = c.now();
+		std::cout << "tTraverse (list, " << percent << "%): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int k = 0; k < 100; k++)
+			for (int x : h)
+				sum[2] += x;
+		t2 = c.now();
+		std::cout << "tTraverse (hive, " << percent << "%): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << (sum[0] != sum[1]) + (sum[1] != sum[2]) << ", should be 0)" << std::endl;
+	}
+
+	{// Refill: the hive reuses the holes, no allocations
+		std::cout << std::endl;
+		std::size_t const n = ITER - h.size();
+		std::chrono::high_resolution_clock c;
+
+		auto t1 = c.now();
+		for (std::size_t i = 0; i < n; i++)
+			l.push_back(int(i));
+		auto t2 = c.now();
+		std::cout << "tRefill (list): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		std::size_t const cap = h.capacity();
+		t1 = c.now();
+		for (std::size_t i = 0; i < n; i++)
+			h.insert(int(i));
+		t2 = c.now();
+		std::cout << "tRefill (hive): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		std::cout << "(checksum " << (h.capacity() != cap) + (h.size() != l.size()) << ", should be 0)" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include "myarray.h"
+#include "myvector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+
+
+namespace my {
+/**
+ * Unordered container with stable element addresses (like std::hive, C++26, and
+ * plf::colony): elements live in blocks of contiguous memory, an element never
+ * moves until it is erased, and erasing leaves a hole which a later insert reuses.
+ * Unlike a list there is no allocation per element, and traversal walks through
+ * contiguous memory.
+ *
+ * - Blocks are my::arrays, each new block as large as all previous ones together
+ *   (up to max_block_size elements), so there are only O(log n) allocations.
+ *   Blocks are never freed before the hive is cleared/destroyed, empty ones are
+ *   reused.
+ * - A *jump-counting skip field* per block lets traversal jump over any run of
+ *   erased elements in O(1): skip[i] == 0 for elements in use; for a run of erased
+ *   slots, the first and last skip value hold the length of the run (the values
+ *   in between don't matter). ++it is i += 1; i += skip[i].
+ * - The runs of erased slots of a block form a doubly linked free list (threaded
+ *   through per slot arrays), blocks with free slots another one. Inserting takes
+ *   the first slot of the first free run: O(1). A new block starts as a single run.
+ *
+ * Traversal order is unspecified. Iterators and pointers stay valid until their
+ * element is erased.
+ * Overhead: 6 bytes per slot (skip field and free list links).
+ * @pre T is default constructible (erased slots hold a default constructed T)
+ */
+template <typename T>
+class hive
+{
+	using index = std::uint16_t;
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr index none = static_cast<index>(-1);
+
+	struct block
+	{
+		array<T> values;
+		array<index> skip;		// capacity + 1, skip[capacity] == 0 ends the block
+		array<index> next, prev;	// free list of erased runs, valid at their first slot
+		index free_head = none;		// first erased run
+		std::size_t size = 0;		// elements in use
+		std::size_t next_free = npos, prev_free = npos; // list of blocks with erased slots
+
+		std::size_t capacity() const { return values.size(); }
+	};
+
+public:
+	static constexpr std::size_t min_block_size = 8;
+	static constexpr std::size_t max_block_size = 8192; // < 2^16, the range of index
+
+	template <bool Const>
+	class iterator_impl
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, T const *, T *>;
+		using reference = std::conditional_t<Const, T const &, T &>;
+
+		iterator_impl() = default;
+		// iterator -> const_iterator
+		template <bool C = Const, typename = std::enable_if_t<C>>
+		iterator_impl(iterator_impl<false> const & other) :
+			_h(other._h), _b(other._b), _i(other._i), _values(other._values), _skip(other._skip), _capacity(other._capacity) {}
+
+		reference operator*() const { return _values[_i]; }
+		pointer operator->() const { return _values + _i; }
+
+		iterator_impl & operator++()
+		{
+			_i++;
+			_i += _skip[_i];
+			if (_i == _capacity)
+				* this = iterator_impl(_h, _b + 1);
+			return * this;
+		}
+		iterator_impl operator++(int)
+		{
+			iterator_impl tmp = * this;
+			++* this;
+			return tmp;
+		}
+
+		friend bool operator==(iterator_impl const & a, iterator_impl const & b) { return a._b == b._b && a._i == b._i; }
+		friend bool operator!=(iterator_impl const & a, iterator_impl const & b) { return !(a == b); }
+
+	private:
+		friend class hive;
+		template <bool> friend class iterator_impl;
+		using hive_type = std::conditional_t<Const, hive const, hive>;
+
+		// First element in block b or a later one, end() if there is none. Skips
+		// empty blocks without looking at their slots.
+		iterator_impl(hive_type * h, std::size_t b) : _h(h), _b(b)
+		{
+			for (; _b < h->_blocks.size(); _b++)
+				if (h->_blocks[_b].size > 0)
+				{
+					set_block();
+					_i = _skip[0];
+					return;
+				}
+			_b = h->_blocks.size();
+			_i = 0;
+		}
+		iterator_impl(hive_type * h, std::size_t b, std::size_t i) : _h(h), _b(b), _i(i)
+		{
+			if (b < h->_blocks.size())
+				set_block();
+		}
+
+		// Caches the block's buffers, which stay where they are when _blocks grows
+		void set_block()
+		{
+			auto & bl = _h->_blocks[_b];
+			_values = bl.values.data();
+			_skip = bl.skip.data();
+			_capacity = bl.capacity();
+		}
+
+		hive_type * _h = nullptr;
+		std::size_t _b = 0, _i = 0;
+		pointer _values = nullptr;
+		index const * _skip = nullptr;
+		std::size_t _capacity = 0;
+	};
+
+	using iterator = iterator_impl<false>;
+	using const_iterator = iterator_impl<true>;
+
+	/**
+	 * Constructor, creates an empty hive. Does not allocate.
+	 * @exception no-throw
+	 * @post size() == capacity() == 0
+	 */
+	hive() : _size(0), _capacity(0), _free_blocks(npos) {}
+
+	/**
+	 * @return Number of elements in the hive
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * @return Number of slots in all blocks
+	 * @exception no-throw
+	 */
+	std::size_t capacity() const { return _capacity; }
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, _blocks.size(), 0); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, _blocks.size(), 0); }
+
+	/**
+	 * Inserts 'val' into an erased slot if there is one, else into a new block.
+	 * @return Iterator to the new element
+	 * @exception might throw if not enough memory is available or if T's copy
+	 * assignment operator throws. Provides strong exception safety.
+	 * @post size() grows by 1
+	 */
+	iterator insert(T const & val)
+	{
+		if (_free_blocks == npos)
+			add_block();
+
+		std::size_t const b = _free_blocks;
+		block & bl = _blocks[b];
+		std::size_t const i = bl.free_head;
+		bl.values[i] = val;
+
+		// shrink the run from the front
+		std::size_t const len = bl.skip[i];
+		unlink_run(bl, i);
+		if (len > 1)
+		{
+			bl.skip[i + 1] = bl.skip[i + len - 1] = static_cast<index>(len - 1);
+			link_run(bl, i + 1);
+		}
+		bl.skip[i] = 0;
+
+		if (bl.free_head == none)
+			unlink_block(b);
+		bl.size++;
+		_size++;
+		return iterator(this, b, i);
+	}
+
+	/**
+	 * Erases the element at pos: O(1), no other element moves.
+	 * @return Iterator to the element after pos
+	 * @pre pos is a valid iterator of this hive, pos != end()
+	 * @exception might throw if T's move assignment throws
+	 * @post size() shrinks by 1
+	 */
+	iterator erase(const_iterator pos)
+	{
+		assert(pos._h == this && pos._b < _blocks.size());
+		std::size_t const b = pos._b, i = pos._i;
+		block & bl = _blocks[b];
+		assert(bl.skip[i] == 0);
+
+		bl.values[i] = T(); // releases what the element holds
+		iterator next(this, b, i);
+		++next;
+
+		// merge with the runs of erased slots to the left/right
+		bool const was_full = bl.free_head == none;
+		std::size_t const left = i > 0 ? bl.skip[i - 1] : 0, right = bl.skip[i + 1];
+		std::size_t const first = i - left, len = left + 1 + right;
+		if (right > 0)
+			unlink_run(bl, i + 1);
+		if (left == 0)
+			link_run(bl, i);
+		bl.skip[first] = bl.skip[first + len - 1] = static_cast<index>(len);
+
+		if (was_full)
+			link_block(b);
+		bl.size--;
+		_size--;
+		return next;
+	}
+
+	/**
+	 * Erases all elements and frees all blocks.
+	 * @exception no-throw
+	 * @post size() == capacity() == 0
+	 */
+	void clear()
+	{
+		_blocks = vector<block>();
+		_size = _capacity = 0;
+		_free_blocks = npos;
+	}
+
+private:
+	// Appends a block of min(max_block_size, max(min_block_size, capacity())) slots,
+	// all of them a single erased run
+	void add_block()
+	{
+		std::size_t const n = std::min(max_block_size, std::max(min_block_size, _capacity));
+		array<T> values(n);
+		array<index> skip(n + 1), next(n), prev(n);
+		_blocks.resize(_blocks.size() + 1); // last allocation, nothing can fail after it
+
+		block & bl = _blocks[_blocks.size() - 1];
+		bl.values = std::move(values);
+		bl.skip = std::move(skip);
+		bl.next = std::move(next);
+		bl.prev = std::move(prev);
+		bl.skip[0] = bl.skip[n - 1] = static_cast<index>(n);
+		bl.skip[n] = 0;
+		link_run(bl, 0);
+
+		_capacity += n;
+		link_block(_blocks.size() - 1);
+	}
+
+	static void link_run(block & bl, std::size_t i)
+	{
+		bl.next[i] = bl.free_head;
+		bl.prev[i] = none;
+		if (bl.free_head != none)
+			bl.prev[bl.free_head] = static_cast<index>(i);
+		bl.free_head = static_cast<index>(i);
+	}
+
+	static void unlink_run(block & bl, std::size_t i)
+	{
+		if (bl.prev[i] != none)
+			bl.next[bl.prev[i]] = bl.next[i];
+		else
+			bl.free_head = bl.next[i];
+		if (bl.next[i] != none)
+			bl.prev[bl.next[i]] = bl.prev[i];
+	}
+
+	void link_block(std::size_t b)
+	{
+		_blocks[b].next_free = _free_blocks;
+		_blocks[b].prev_free = npos;
+		if (_free_blocks != npos)
+			_blocks[_free_blocks].prev_free = b;
+		_free_blocks = b;
+	}
+
+	void unlink_block(std::size_t b)
+	{
+		block & bl = _blocks[b];
+		if (bl.prev_free != npos)
+			_blocks[bl.prev_free].next_free = bl.next_free;
+		else
+			_free_blocks = bl.next_free;
+		if (bl.next_free != npos)
+			_blocks[bl.next_free].prev_free = bl.prev_free;
+		bl.next_free = bl.prev_free = npos;
+	}
+
+	vector<block> _blocks;
+	std::size_t _size, _capacity;
+	std::size_t _free_blocks; // first block with erased slots, npos if none
+};
+} // namespace my
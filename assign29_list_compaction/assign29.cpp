@@ -0,0 +1,158 @@
+#include "mylist.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+
+template <typename T>
+static std::vector<T> to_vector(my::list<T> const & l)
+{
+	return std::vector<T>(l.begin(), l.end());
+}
+
+// Inserts 0..n-1 into l, each after a random one of the elements inserted before:
+// node k of the pool ends up at a random position of the traversal order.
+static void build_shuffled(my::list<int> & l, int n, unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::vector<my::list<int>::iterator> its;
+	its.push_back(l.before_begin());
+	for (int i = 0; i < n; i++)
+		its.push_back(l.insert_after(its[rng() % its.size()], i));
+}
+
+int main()
+{
+	using namespace my;
+
+	{// Test list()
+		list<int> l;
+
+		assert(l.size() == 0 && l.capacity() == 0);
+		assert(l.empty());
+		assert(l.begin() == l.end());
+	}
+
+	{// Test push_back()/push_front()/insert_after()/erase_after()
+		list<std::string> l;
+		l.push_back("b");
+		l.push_front("a");
+		auto it = l.push_back("d");
+		l.insert_after(l.begin(), "c");
+		l.push_back("e");
+		assert((to_vector(l) == std::vector<std::string>{ "a", "c", "b", "d", "e" }));
+		assert(l.size() == 5 && l.front() == "a" && l.back() == "e");
+
+		it = l.erase_after(it); // "e", the tail
+		assert(it == l.end() && l.back() == "d");
+		l.push_back("f");
+		l.pop_front();
+		assert((to_vector(l) == std::vector<std::string>{ "c", "b", "d", "f" }));
+
+		std::size_t const cap = l.capacity();
+		for (int i = 0; i < 10; i++)
+		{
+			l.push_front("x");
+			l.pop_front();
+		}
+		assert(l.capacity() == cap); // erased nodes are reused
+	}
+
+	{// Test compact(): same elements, same order, one block in traversal order
+		list<int> l;
+		build_shuffled(l, 1000, 1);
+		for (auto it = l.begin(); it != l.end(); ++it) // erase every other
+			if (std::next(it) != l.end())
+				l.erase_after(it);
+
+		std::vector<int> const before = to_vector(l);
+		assert(l.capacity() > l.size());
+
+		l.compact();
+		assert(to_vector(l) == before);
+		assert(l.capacity() == l.size());
+
+		int const * prev = nullptr;
+		for (int const & x : l) // consecutive addresses
+		{
+			assert(!prev || & x == reinterpret_cast<int const *>(reinterpret_cast<char const *>(prev) + sizeof(int *) * 2));
+			prev = & x;
+		}
+
+		l.push_back(-1); // keeps working: allocates a new block
+		assert(l.back() == -1 && l.size() == before.size() + 1);
+
+		list<int> e;
+		e.compact();
+		assert(e.empty() && e.capacity() == 0);
+	}
+
+	{// Test for_each() with and without prefetching
+		list<int> l;
+		build_shuffled(l, 100, 2);
+		long long a = 0, b = 0;
+		l.for_each([&a](int x) { a += x; });
+		l.for_each([&b](int x) { b += x; }, true);
+		assert(a == 99 * 100 / 2 && b == a);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const ITER = 4'000'000; // might need to adjust slightly for your machine
+	int const ROUNDS = 10;
+	std::chrono::high_resolution_clock c;
+
+	list<int> fresh, l;
+	for (int i = 0; i < ITER; i++)
+		fresh.push_back(i);
+	build_shuffled(l, ITER, 3);
+
+	// light work per element (a sum) and heavier work (a chain of dependent multiplications,
+	// long enough that the CPU can't look ahead to the next node on its own)
+	auto heavy = [](long long & sum, int x) {
+		unsigned h = unsigned(x);
+		for (int k = 0; k < 64; k++)
+			h = h * 2654435761u + 1;
+		sum += h & 1;
+	};
+
+	long long light_ref = -1, work_ref = -1, errors = 0; // all layouts must give the same sums
+	auto traverse = [&](char const * name, list<int> & li, bool prefetch) {
+		long long light = 0, work = 0;
+		auto t1 = c.now();
+		for (int r = 0; r < ROUNDS; r++)
+			li.for_each([&light](int x) { light += x; }, prefetch);
+		auto t2 = c.now();
+		std::cout << "tTraverse (" << name << "): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		t1 = c.now();
+		for (int r = 0; r < ROUNDS; r++)
+			li.for_each([&work, heavy](int x) { heavy(work, x); }, prefetch);
+		t2 = c.now();
+		std::cout << "tTraverseWork (" << name << "): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		errors += light_ref != -1 && (light != light_ref || work != work_ref);
+		light_ref = light;
+		work_ref = work;
+	};
+
+	traverse("fresh", fresh, false);
+	traverse("shuffled", l, false);
+	traverse("shuffled, prefetch", l, true);
+
+	auto t1 = c.now();
+	l.compact();
+	auto t2 = c.now();
+	std::cout << "tCompact: " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+	traverse("compacted", l, false);
+	traverse("compacted, prefetch", l, true);
+	std::cout << "(checksum " << errors + (l.size() != std::size_t(ITER)) << ", should be 0)" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,309 @@
+#pragma once
+
+#include "myarray.h"
+#include "myvector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#ifdef _MSC_VER
+#include <xmmintrin.h>
+#endif
+
+
+
+namespace my {
+namespace detail {
+// Hint to the CPU to start loading the cache line of p, without waiting for it
+inline void prefetch(void const * p)
+{
+#ifdef _MSC_VER
+	_mm_prefetch(static_cast<char const *>(p), _MM_HINT_T0);
+#else
+	__builtin_prefetch(p);
+#endif
+}
+} // namespace detail
+
+/**
+ * Singly linked list (the list of assignment 7 as a template, with iterators, a
+ * tail pointer and a size), whose nodes come from a pool instead of one 'new' each:
+ * blocks of nodes (my::arrays, each as large as all previous ones together) and a
+ * free list of erased nodes.
+ *
+ * A pool saves allocations, but it doesn't keep the list in order: after inserting
+ * in the middle and erasing for a while, successive nodes are scattered across the
+ * blocks, and traversal takes a cache miss on every node. compact() restores the
+ * freshly built layout: it moves all values into a single new block in traversal
+ * order, relinks them and frees the old blocks.
+ * @invariant _tail is the last node (& _head if empty), _size the number of nodes
+ */
+template <typename T>
+class list
+{
+	struct node
+	{
+		node * next = nullptr;
+		T value = T();
+	};
+
+public:
+	template <bool Const>
+	class iterator_impl
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, T const *, T *>;
+		using reference = std::conditional_t<Const, T const &, T &>;
+
+		iterator_impl() = default;
+		// iterator -> const_iterator
+		template <bool C = Const, typename = std::enable_if_t<C>>
+		iterator_impl(iterator_impl<false> const & other) : _n(other._n) {}
+
+		reference operator*() const { return _n->value; }
+		pointer operator->() const { return & _n->value; }
+
+		iterator_impl & operator++()
+		{
+			_n = _n->next;
+			return * this;
+		}
+		iterator_impl operator++(int)
+		{
+			iterator_impl tmp = * this;
+			_n = _n->next;
+			return tmp;
+		}
+
+		friend bool operator==(iterator_impl const & a, iterator_impl const & b) { return a._n == b._n; }
+		friend bool operator!=(iterator_impl const & a, iterator_impl const & b) { return a._n != b._n; }
+
+	private:
+		friend class list;
+		template <bool> friend class iterator_impl;
+		using node_type = std::conditional_t<Const, node const, node>;
+
+		explicit iterator_impl(node_type * n) : _n(n) {}
+
+		node_type * _n = nullptr;
+	};
+
+	using iterator = iterator_impl<false>;
+	using const_iterator = iterator_impl<true>;
+
+	/**
+	 * Constructor, creates an empty list. Does not allocate.
+	 * @exception no-throw
+	 * @post size() == 0
+	 */
+	list() : _tail(& _head), _free(nullptr), _size(0), _capacity(0) {}
+
+	// Nodes point to each other and to _head: copying and moving would need relinking
+	list(list const &) = delete;
+	list & operator=(list const &) = delete;
+
+	/**
+	 * @return Number of elements in the list
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * @return Number of nodes in the pool (in use and free)
+	 * @exception no-throw
+	 */
+	std::size_t capacity() const { return _capacity; }
+
+	iterator before_begin() { return iterator(& _head); }
+	iterator begin() { return iterator(_head.next); }
+	iterator end() { return iterator(nullptr); }
+	const_iterator before_begin() const { return const_iterator(& _head); }
+	const_iterator begin() const { return const_iterator(_head.next); }
+	const_iterator end() const { return const_iterator(nullptr); }
+
+	/**
+	 * @return First/last element
+	 * @pre !empty()
+	 * @exception no-throw
+	 */
+	T & front()
+	{
+		assert(!empty());
+		return _head.next->value;
+	}
+	T & back()
+	{
+		assert(!empty());
+		return _tail->value;
+	}
+
+	/**
+	 * Inserts 'val' after pos / at the front / at the end.
+	 * @return Iterator to the new element
+	 * @pre pos is a valid iterator of this list, pos != end()
+	 * @exception might throw if not enough memory is available or if T's copy
+	 * assignment operator throws. Provides strong exception safety.
+	 * @post size() grows by 1
+	 */
+	iterator insert_after(const_iterator pos, T const & val)
+	{
+		assert(pos._n != nullptr);
+		node * prev = const_cast<node *>(pos._n);
+		node * n = allocate();
+		try
+		{
+			n->value = val;
+		}
+		catch (...)
+		{
+			release(n);
+			throw;
+		}
+
+		n->next = prev->next;
+		prev->next = n;
+		if (prev == _tail)
+			_tail = n;
+		_size++;
+		return iterator(n);
+	}
+	iterator push_front(T const & val) { return insert_after(before_begin(), val); }
+	iterator push_back(T const & val) { return insert_after(const_iterator(_tail), val); }
+
+	/**
+	 * Erases the element after pos, returning its node to the pool.
+	 * @return Iterator to the element after the erased one
+	 * @pre pos and its successor are valid iterators of this list, != end()
+	 * @exception might throw if T's move assignment throws
+	 * @post size() shrinks by 1
+	 */
+	iterator erase_after(const_iterator pos)
+	{
+		assert(pos._n != nullptr && pos._n->next != nullptr);
+		node * prev = const_cast<node *>(pos._n);
+		node * n = prev->next;
+
+		prev->next = n->next;
+		if (n == _tail)
+			_tail = prev;
+		n->value = T(); // releases what the element holds
+		release(n);
+		_size--;
+		return iterator(prev->next);
+	}
+	void pop_front() { erase_after(before_begin()); }
+
+	/**
+	 * Erases all elements and frees all nodes.
+	 * @exception no-throw
+	 * @post size() == capacity() == 0
+	 */
+	void clear()
+	{
+		_blocks = vector<array<node>>();
+		_head.next = nullptr;
+		_tail = & _head;
+		_free = nullptr;
+		_size = _capacity = 0;
+	}
+
+	/**
+	 * Moves all elements into a single new block of size() nodes, in traversal
+	 * order, and frees all other blocks: traversal becomes a sequential scan again.
+	 * O(size()) time, needs the memory for both layouts for a moment.
+	 * Invalidates all iterators and references.
+	 * @exception might throw if not enough memory is available (the list remains
+	 * unchanged) or if T's move assignment throws (basic exception safety)
+	 * @post capacity() == size()
+	 */
+	void compact()
+	{
+		if (_size == 0)
+		{
+			clear();
+			return;
+		}
+
+		vector<array<node>> blocks;
+		blocks.resize(1);
+		blocks[0] = array<node>(_size);
+		node * fresh = blocks[0].data();
+
+		std::size_t i = 0;
+		for (node * n = _head.next; n; n = n->next, i++)
+		{
+			fresh[i].value = std::move(n->value);
+			fresh[i].next = fresh + i + 1;
+		}
+		fresh[_size - 1].next = nullptr;
+
+		_head.next = fresh;
+		_tail = fresh + _size - 1;
+		_free = nullptr;
+		_capacity = _size;
+		_blocks = std::move(blocks); // frees the old nodes
+	}
+
+	/**
+	 * Calls f(element) for all elements in order. With 'prefetch', requests the
+	 * next node from memory before calling f on the current one, so the cache miss
+	 * overlaps with f's work (which only pays off if f does enough work).
+	 * @exception might throw if f throws
+	 */
+	template <typename F>
+	void for_each(F f, bool prefetch = false)
+	{
+		if (prefetch)
+			for (node * n = _head.next; n; n = n->next)
+			{
+				if (n->next)
+					detail::prefetch(n->next);
+				f(n->value);
+			}
+		else
+			for (node * n = _head.next; n; n = n->next)
+				f(n->value);
+	}
+
+private:
+	// @return A node from the free list, or a new block
+	node * allocate()
+	{
+		if (!_free)
+		{
+			std::size_t const n = std::max<std::size_t>(16, _capacity);
+			array<node> block(n);
+			for (std::size_t i = 0; i < n; i++)
+				block[i].next = i + 1 < n ? & block[i + 1] : nullptr;
+
+			_blocks.resize(_blocks.size() + 1); // might throw, nothing changed yet
+			_blocks[_blocks.size() - 1] = std::move(block);
+			_free = _blocks[_blocks.size() - 1].data();
+			_capacity += n;
+		}
+
+		node * n = _free;
+		_free = n->next;
+		return n;
+	}
+
+	void release(node * n)
+	{
+		n->next = _free;
+		_free = n;
+	}
+
+	node _head;			// before the first node, _head.next is the first one
+	node * _tail;
+	node * _free;			// free list, through next
+	vector<array<node>> _blocks;	// the pool
+	std::size_t _size, _capacity;
+};
+} // namespace my
@@ -0,0 +1,130 @@
+#include "myarray.h"
+#include "myzeroed_array.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+
+
+// @return Resident memory (RSS) of this process in MB, -1 if unknown on this platform
+static long resident_mb()
+{
+#ifdef __linux__
+	std::ifstream statm("/proc/self/statm");
+	long pages = 0, resident = -1;
+	statm >> pages >> resident;
+	return resident < 0 ? -1 : static_cast<long>(resident * my::detail::page_size() / (1024 * 1024));
+#else
+	return -1;
+#endif
+}
+
+int main()
+{
+	using namespace my;
+
+	{// Test zeroed_array()
+		zeroed_array<int> a;
+
+		assert(a.size() == 0);
+		assert(a.data() == nullptr);
+	}
+
+	{// Test zeroed_array(n), small (calloc) and large (mapped)
+		for (std::size_t n : { 10, 1'000'000 })
+		{
+			zeroed_array<std::uint64_t> a(n);
+			assert(a.size() == n);
+			assert(std::all_of(a.data(), a.data() + n, [](std::uint64_t x) { return x == 0; }));
+
+			a[n - 1] = 42;
+			zeroed_array<std::uint64_t> b(a);
+			assert(b[n - 1] == 42 && b[0] == 0 && b.data() != a.data());
+
+			zeroed_array<std::uint64_t> c(std::move(b));
+			assert(b.size() == 0 && b.data() == nullptr && c[n - 1] == 42);
+
+			b = c;
+			c = zeroed_array<std::uint64_t>(3);
+			assert(b.size() == n && b[n - 1] == 42 && c.size() == 3 && c[2] == 0);
+		}
+	}
+
+	{// Test decommit(): the range reads as zero, the rest is untouched
+		for (std::size_t n : { 100, 4'000'000 })
+		{
+			zeroed_array<int> a(n);
+			for (std::size_t i = 0; i < n; i++)
+				a[i] = 1;
+
+			std::size_t const first = n / 4 + 3, count = n / 2; // not page aligned
+			a.decommit(first, count);
+			for (std::size_t i = 0; i < n; i++)
+				assert(a[i] == (i >= first && i < first + count ? 0 : 1));
+
+			a[first] = 7; // still usable
+			assert(a[first] == 7);
+			a.decommit();
+			assert(std::all_of(a.data(), a.data() + n, [](int x) { return x == 0; }));
+			a.decommit(5, 0);
+		}
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	std::size_t const BYTES = std::size_t(2) * 1024 * 1024 * 1024; // might need to adjust slightly for your machine (needs as much free RAM)
+	std::size_t const N = BYTES / sizeof(int);
+	std::size_t const STRIDE = 256 * 1024 / sizeof(int); // sparse: touch one element every 256 KB
+
+	std::chrono::high_resolution_clock c;
+	std::cout << "(RSS at start: " << resident_mb() << "MB)" << std::endl;
+	long checksum = 0;
+
+	{// my::array + zero fill
+		auto t1 = c.now();
+		array<int> a(N);
+		std::fill(a.data(), a.data() + N, 0);
+		auto t2 = c.now();
+		std::cout << "tConstruct (array, " << BYTES / (1024 * 1024) << "MB): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, RSS " << resident_mb() << "MB" << std::endl;
+
+		t1 = c.now();
+		for (std::size_t i = 0; i < N; i += STRIDE)
+			a[i]++;
+		t2 = c.now();
+		std::cout << "tTouch (array, sparse): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us, RSS " << resident_mb() << "MB" << std::endl;
+		checksum += a[(N - 1) / STRIDE * STRIDE];
+	}
+	std::cout << std::endl;
+	{// zeroed_array
+		auto t1 = c.now();
+		zeroed_array<int> a(N);
+		auto t2 = c.now();
+		std::cout << "tConstruct (zeroed_array, " << BYTES / (1024 * 1024) << "MB): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us, RSS " << resident_mb() << "MB" << std::endl;
+
+		t1 = c.now();
+		for (std::size_t i = 0; i < N; i += STRIDE)
+			a[i]++;
+		t2 = c.now();
+		std::cout << "tTouch (zeroed_array, sparse): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us, RSS " << resident_mb() << "MB" << std::endl;
+		checksum -= a[(N - 1) / STRIDE * STRIDE];
+
+		t1 = c.now();
+		std::fill(a.data(), a.data() + N, 1);
+		t2 = c.now();
+		std::cout << "tTouch (zeroed_array, everything): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, RSS " << resident_mb() << "MB" << std::endl;
+
+		t1 = c.now();
+		a.decommit(0, N / 2);
+		t2 = c.now();
+		std::cout << "tDecommit (zeroed_array, half): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, RSS " << resident_mb() << "MB" << std::endl;
+		checksum += a[0] + a[N - 1] - 1;
+	}
+	std::cout << "(checksum " << checksum << ", should be 0)" << std::endl;
+
+	return 0;
+}
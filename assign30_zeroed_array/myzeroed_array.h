@@ -0,0 +1,268 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+
+namespace my {
+namespace detail {
+/**
+ * @return Size of a virtual memory page in bytes (4 KB on most systems)
+ */
+inline std::size_t page_size()
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(& info);
+	return info.dwPageSize;
+#else
+	return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+/**
+ * Reserves 'bytes' of address space directly from the operating system. No page
+ * is backed by memory yet: the first access to a page maps a zero filled page
+ * (the OS has to zero it anyway, for security), pages never touched cost nothing.
+ * @exception std::bad_alloc if the address space can't be reserved
+ */
+inline void * map_zeroed(std::size_t bytes)
+{
+#ifdef _WIN32
+	void * p = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if (!p)
+		throw std::bad_alloc();
+#else
+	void * p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED)
+		throw std::bad_alloc();
+#endif
+	return p;
+}
+
+inline void unmap(void * p, std::size_t bytes)
+{
+#ifdef _WIN32
+	(void) bytes;
+	VirtualFree(p, 0, MEM_RELEASE);
+#else
+	munmap(p, bytes);
+#endif
+}
+
+/**
+ * Gives the memory of the pages [p, p + bytes) back to the OS. They stay mapped,
+ * the next access maps a fresh zero page again.
+ * @pre p and bytes are multiples of page_size(), the pages were mapped by map_zeroed()
+ */
+inline void decommit_pages(void * p, std::size_t bytes)
+{
+#ifdef _WIN32
+	VirtualFree(p, bytes, MEM_DECOMMIT);
+	VirtualAlloc(p, bytes, MEM_COMMIT, PAGE_READWRITE); // commits lazily, no memory yet
+#else
+	madvise(p, bytes, MADV_DONTNEED); // private anonymous memory reads as zero afterwards
+#endif
+}
+} // namespace detail
+
+/**
+ * Fixed size array of zero-initialized T which are not touched before they are
+ * used (a my::array variant for large, sparsely used arrays).
+ *
+ * my::array<T>(n) runs new T[n] and a zero fill writes every byte: the OS has to
+ * back every page with memory right away, so an 8 GB array takes seconds and 8 GB of
+ * RAM before it is used at all. zeroed_array gets blocks of at least mmap_threshold
+ * bytes straight from the OS (mmap/VirtualAlloc) instead: the OS guarantees
+ * zeroed pages and maps them lazily, on first access. Construction is O(1), and the
+ * resident memory (RSS) grows with the pages actually touched.
+ * Smaller blocks come from calloc.
+ *
+ * decommit() returns ranges which are no longer needed to the OS, they read as
+ * zero afterwards.
+ * @pre T is trivial and all bits zero represent a valid value (integers, floats,
+ * pointers, PODs of them)
+ */
+template <typename T>
+class zeroed_array
+{
+	static_assert(std::is_trivial<T>::value, "zeroed_array only holds trivial types, all bits zero is their value");
+
+public:
+	static constexpr std::size_t mmap_threshold = 1024 * 1024;
+
+	/**
+	 * Constructor, creates an empty array.
+	 * @exception no-throw
+	 * @post size() == 0
+	 * @post data() == nullptr
+	 */
+	zeroed_array() : _size(0), _data(nullptr) {}
+
+	/**
+	 * Constructor, allocates an array of n zeroed elements, without touching them.
+	 * @param n Size in elements of array
+	 * @exception std::bad_alloc if not enough memory/address space is available.
+	 * @post size() == n, all elements are 0
+	 */
+	explicit zeroed_array(std::size_t n) : _size(n), _data(allocate(n)) {}
+
+	/**
+	 * Copy constructor, creates a deep copy of 'other' (touches all pages).
+	 * @exception std::bad_alloc if not enough memory is available.
+	 * @post *this == other
+	 */
+	zeroed_array(zeroed_array const & other) : _size(other._size), _data(allocate(other._size))
+	{
+		if (_size > 0)
+			std::memcpy(_data, other._data, bytes());
+	}
+
+	/**
+	 * Move constructor, steals the elements of 'other'.
+	 * @exception no-throw
+	 * @post other.size() == 0
+	 */
+	zeroed_array(zeroed_array && other) noexcept :
+		_size(std::exchange(other._size, 0)), _data(std::exchange(other._data, nullptr)) {}
+
+	/**
+	 * Copy and move assignment operator (copy-and-swap).
+	 * @exception std::bad_alloc if copying and not enough memory is available.
+	 * Provides strong exception safety.
+	 */
+	zeroed_array & operator=(zeroed_array rhs) noexcept
+	{
+		swap(rhs);
+		return * this;
+	}
+
+	~zeroed_array() { deallocate(_data, _size); }
+
+	/**
+	 * Exchanges the contents of this array with 'other'.
+	 * @exception no-throw
+	 */
+	void swap(zeroed_array & other) noexcept
+	{
+		std::swap(_size, other._size);
+		std::swap(_data, other._data);
+	}
+
+	/**
+	 * @return The number of elements
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+
+	/**
+	 * @return Raw pointer to the data
+	 * @exception no-throw
+	 */
+	T * data() { return _data; }
+	T const * data() const { return _data; }
+
+	/**
+	 * @return (Reference to) element at index i
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	T & operator[](std::size_t i)
+	{
+		assert(i < _size);
+		return _data[i];
+	}
+	T const & operator[](std::size_t i) const
+	{
+		assert(i < _size);
+		return _data[i];
+	}
+
+	/**
+	 * Zeroes the elements [first, first + count) and gives the memory of all pages
+	 * completely inside that range back to the OS (elements sharing a page with
+	 * elements outside the range are zeroed in place). The range remains usable:
+	 * it reads as zero, and writing to it maps new pages.
+	 * @pre first + count <= size()
+	 * @exception no-throw
+	 * @post all elements in the range are 0
+	 */
+	void decommit(std::size_t first, std::size_t count)
+	{
+		assert(first <= _size && count <= _size - first);
+		char * begin = reinterpret_cast<char *>(_data + first);
+		char * end = reinterpret_cast<char *>(_data + first + count);
+		if (!mapped(_size))
+		{
+			std::memset(begin, 0, end - begin);
+			return;
+		}
+
+		// whole pages inside the range
+		std::uintptr_t const page = detail::page_size();
+		char * page_begin = reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(begin) + page - 1) / page * page);
+		char * page_end = reinterpret_cast<char *>(reinterpret_cast<std::uintptr_t>(end) / page * page);
+		if (page_begin >= page_end)
+		{
+			std::memset(begin, 0, end - begin);
+			return;
+		}
+
+		std::memset(begin, 0, page_begin - begin);
+		detail::decommit_pages(page_begin, page_end - page_begin);
+		std::memset(page_end, 0, end - page_end);
+	}
+
+	void decommit() { decommit(0, _size); }
+
+private:
+	std::size_t bytes() const { return _size * sizeof(T); }
+
+	static bool mapped(std::size_t n) { return n * sizeof(T) >= mmap_threshold; }
+
+	static T * allocate(std::size_t n)
+	{
+		if (n == 0)
+			return nullptr;
+		if (n > static_cast<std::size_t>(-1) / sizeof(T))
+			throw std::bad_alloc();
+		if (mapped(n))
+			return static_cast<T *>(detail::map_zeroed(n * sizeof(T)));
+
+		void * p = std::calloc(n, sizeof(T));
+		if (!p)
+			throw std::bad_alloc();
+		return static_cast<T *>(p);
+	}
+
+	static void deallocate(T * p, std::size_t n)
+	{
+		if (!p)
+			return;
+		if (mapped(n))
+			detail::unmap(p, n * sizeof(T));
+		else
+			std::free(p);
+	}
+
+	std::size_t _size;
+	T * _data;
+};
+} // namespace my
@@ -0,0 +1,188 @@
+#include "myarray.h"
+#include "mynuma_vector.h"
+#include "myvector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+
+
+// Throws on the 'limit'th copy, to test exception safety
+struct fragile
+{
+	static std::atomic<int> copies, alive;
+	static int limit;
+
+	fragile() { alive++; }
+	fragile(fragile const &)
+	{
+		if (++copies == limit)
+			throw std::runtime_error("fragile");
+		alive++;
+	}
+	~fragile() { alive--; }
+};
+std::atomic<int> fragile::copies(0), fragile::alive(0);
+int fragile::limit = 0;
+
+int main()
+{
+	using namespace my;
+
+	{// Test parse_list(), numa_topology()
+		vector<unsigned> const v = detail::parse_list("0-2,5,7-8\n");
+		assert(v.size() == 6 && v[0] == 0 && v[2] == 2 && v[3] == 5 && v[5] == 8);
+		assert(detail::parse_list("").empty());
+
+		vector<numa_node> const nodes = detail::numa_topology();
+		assert(nodes.size() >= 1);
+	}
+
+	{// Test numa_vector()
+		numa_vector<int> v;
+
+		assert(v.size() == 0 && v.partitions() == 0);
+		assert(v.empty() && v.data() == nullptr);
+		v.for_each([](int) { assert(false); });
+	}
+
+	{// Test numa_vector(n, value, threads): partitions cover everything, in node order
+		for (unsigned threads : { 1, 3, 8 })
+		{
+			numa_vector<std::string> v(1000, "x", threads);
+			assert(v.size() == 1000 && v[0] == "x" && v[999] == "x");
+			assert(v.partitions() == std::max<std::size_t>(threads, v.nodes().size()));
+			assert(v.partition_begin(0) == v.begin() && v.partition_end(v.partitions() - 1) == v.end());
+			for (std::size_t p = 1; p < v.partitions(); p++)
+			{
+				assert(v.partition_begin(p) == v.partition_end(p - 1));
+				assert(v.node_of(p) >= v.node_of(p - 1));
+			}
+			assert(v.bound() == (v.nodes().size() > 1));
+		}
+
+		numa_vector<int> tiny(2, 7, 4); // never more partitions than elements
+		assert(tiny.partitions() == 2 && tiny[0] == 7 && tiny[1] == 7);
+	}
+
+	{// Test for_each_partition()/for_each(), move
+		numa_vector<long long> v(100'000, 1, 4);
+		array<long long> sums(v.partitions());
+		std::fill(sums.data(), sums.data() + sums.size(), 0);
+		v.for_each_partition([&sums](std::size_t p, long long * first, long long * last) {
+			for (; first != last; ++first)
+				sums[p] += * first;
+		});
+		long long sum = 0;
+		for (std::size_t p = 0; p < v.partitions(); p++)
+			sum += sums[p];
+		assert(sum == 100'000);
+
+		v.for_each([](long long & x) { x *= 2; });
+		assert(v[0] == 2 && v[99'999] == 2);
+
+		numa_vector<long long> w(std::move(v));
+		assert(v.size() == 0 && w.size() == 100'000 && w[5] == 2);
+		v = std::move(w);
+		assert(v.size() == 100'000 && w.size() == 0);
+
+		bool thrown = false;
+		try
+		{
+			v.for_each_partition([](std::size_t p, long long *, long long *) {
+				if (p == 2)
+					throw std::runtime_error("partition");
+			});
+		}
+		catch (std::runtime_error const &)
+		{
+			thrown = true;
+		}
+		assert(thrown);
+	}
+
+	{// Test exception safety of construction: everything constructed is destroyed
+		fragile::limit = 500;
+		bool thrown = false;
+		try
+		{
+			fragile f;
+			numa_vector<fragile> v(1000, f, 4);
+		}
+		catch (std::runtime_error const &)
+		{
+			thrown = true;
+		}
+		assert(thrown && fragile::alive == 0);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	std::size_t const N = 256 * 1024 * 1024; // might need to adjust slightly for your machine
+	int const ROUNDS = 10;
+	unsigned const threads = std::max(1u, std::thread::hardware_concurrency());
+	std::chrono::high_resolution_clock c;
+
+	vector<numa_node> const nodes = detail::numa_topology();
+	std::cout << "(" << nodes.size() << " NUMA node(s), " << threads << " thread(s))" << std::endl;
+
+	long long sum[2] = {};
+	{// my::vector: initialized by one thread, scanned in parallel
+		auto t1 = c.now();
+		vector<int> v(N);
+		std::fill(v.begin(), v.end(), 1);
+		auto t2 = c.now();
+		std::cout << "tInit (vector, 1 thread): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		array<long long> sums(threads);
+		std::fill(sums.data(), sums.data() + threads, 0);
+		t1 = c.now();
+		for (int r = 0; r < ROUNDS; r++)
+		{
+			array<std::thread> workers(threads);
+			for (unsigned t = 0; t < threads; t++)
+				workers[t] = std::thread([&, t]() {
+					long long s = 0;
+					for (std::size_t i = N * t / threads; i < N * (t + 1) / threads; i++)
+						s += v[i];
+					sums[t] += s;
+				});
+			for (unsigned t = 0; t < threads; t++)
+				workers[t].join();
+		}
+		t2 = c.now();
+		std::cout << "tScan (vector, " << threads << " threads): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		for (unsigned t = 0; t < threads; t++)
+			sum[0] += sums[t];
+	}
+	{// numa_vector: placed per node, initialized and scanned by local threads
+		auto t1 = c.now();
+		numa_vector<int> v(N, 1, threads);
+		auto t2 = c.now();
+		std::cout << "tInit (numa_vector, " << v.partitions() << " partitions, " << (v.bound() ? "bound" : "interleaved") << "): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		array<long long> sums(v.partitions());
+		std::fill(sums.data(), sums.data() + sums.size(), 0);
+		t1 = c.now();
+		for (int r = 0; r < ROUNDS; r++)
+			v.for_each_partition([&sums](std::size_t p, int const * first, int const * last) {
+				long long s = 0;
+				for (; first != last; ++first)
+					s += * first;
+				sums[p] += s;
+			});
+		t2 = c.now();
+		std::cout << "tScan (numa_vector, local threads): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+		for (std::size_t p = 0; p < v.partitions(); p++)
+			sum[1] += sums[p];
+	}
+	std::cout << "(checksum " << sum[0] - sum[1] << ", should be 0)" << std::endl;
+
+	return 0;
+}
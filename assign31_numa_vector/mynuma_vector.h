@@ -0,0 +1,500 @@
+#pragma once
+
+#include "myarray.h"
+#include "myvector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+
+
+namespace my {
+/**
+ * A NUMA node: a socket (or part of one) with its own memory controller. Memory of
+ * the local node is faster to reach than memory of a remote one.
+ */
+struct numa_node
+{
+	unsigned id = 0;	// as the OS numbers it
+	vector<unsigned> cpus;	// cpus of this node, empty if unknown
+};
+
+namespace detail {
+// @return The numbers of a list like "0-3,8,10-11"
+inline vector<unsigned> parse_list(std::string const & s)
+{
+	vector<unsigned> v;
+	std::size_t i = 0;
+	while (i < s.size() && s[i] >= '0' && s[i] <= '9')
+	{
+		std::size_t len = 0;
+		unsigned const first = static_cast<unsigned>(std::stoul(s.substr(i), & len));
+		unsigned last = first;
+		i += len;
+		if (i < s.size() && s[i] == '-')
+		{
+			last = static_cast<unsigned>(std::stoul(s.substr(i + 1), & len));
+			i += len + 1;
+		}
+		for (unsigned x = first; x <= last; x++)
+			v.push_back(x);
+		if (i < s.size() && s[i] == ',')
+			i++;
+	}
+	return v;
+}
+
+/**
+ * @return The NUMA nodes of this machine with their cpus, from /sys on Linux.
+ * A single node without cpus where that isn't available.
+ */
+inline vector<numa_node> numa_topology()
+{
+	vector<numa_node> nodes;
+#ifdef __linux__
+	std::string online;
+	std::ifstream("/sys/devices/system/node/online") >> online;
+	vector<unsigned> const ids = parse_list(online);
+	for (unsigned id : ids)
+	{
+		numa_node n;
+		n.id = id;
+		std::string cpus;
+		std::ifstream("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist") >> cpus;
+		n.cpus = parse_list(cpus);
+		nodes.push_back(n);
+	}
+#endif
+	if (nodes.empty())
+		nodes.push_back(numa_node());
+	return nodes;
+}
+
+// Restricts the calling thread to 'cpus' (if known), so the OS keeps it on their node
+inline void pin_current_thread(vector<unsigned> const & cpus)
+{
+#ifdef __linux__
+	if (cpus.empty())
+		return;
+	cpu_set_t set;
+	CPU_ZERO(& set);
+	for (unsigned cpu : cpus)
+		if (cpu < CPU_SETSIZE)
+			CPU_SET(cpu, & set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), & set); // just a hint if it fails
+#else
+	(void) cpus;
+#endif
+}
+
+/**
+ * Sets the memory policy of the pages [p, p + bytes) to 'mode' (MPOL_BIND,
+ * MPOL_INTERLEAVE) over the nodes 'ids', with the mbind system call (what libnuma's
+ * numa_tonode_memory() and numa_interleave_memory() do underneath).
+ * @pre p is page aligned, the pages aren't touched yet
+ * @return true on success, false if not supported or not allowed
+ */
+inline bool mbind_pages(void * p, std::size_t bytes, int mode, unsigned const * ids, std::size_t count)
+{
+#ifdef __linux__
+	unsigned long const bits = sizeof(unsigned long) * 8;
+	unsigned long mask[1024 / bits] = {};
+	for (std::size_t i = 0; i < count; i++)
+	{
+		if (ids[i] >= 1024)
+			return false;
+		mask[ids[i] / bits] |= 1ul << (ids[i] % bits);
+	}
+	return bytes == 0 || syscall(SYS_mbind, p, bytes, mode, mask, 1024ul + 1, 0ul) == 0;
+#else
+	(void) p; (void) bytes; (void) mode; (void) ids; (void) count;
+	return false;
+#endif
+}
+
+inline std::size_t page_size()
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(& info);
+	return info.dwPageSize;
+#else
+	return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// Reserves address space from the OS, backed by memory on first touch only
+inline void * map_pages(std::size_t bytes)
+{
+#ifdef _WIN32
+	void * p = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if (!p)
+		throw std::bad_alloc();
+#else
+	void * p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED)
+		throw std::bad_alloc();
+#endif
+	return p;
+}
+
+inline void unmap_pages(void * p, std::size_t bytes)
+{
+#ifdef _WIN32
+	(void) bytes;
+	VirtualFree(p, 0, MEM_RELEASE);
+#else
+	munmap(p, bytes);
+#endif
+}
+
+// Deleter for std::unique_ptr, owns a mapping until it is handed over
+struct unmapper
+{
+	std::size_t bytes;
+	void operator()(void * p) const { unmap_pages(p, bytes); }
+};
+} // namespace detail
+
+/**
+ * Fixed size array of T, split into partitions, each of which lives in the memory of
+ * one NUMA node and is worked on by threads running on that node.
+ *
+ * The OS places a page on the node of the thread that touches it first. If a single
+ * thread initializes a big my::vector, all of it ends up on one node, and threads on
+ * the other sockets scan it at remote memory bandwidth. numa_vector takes its memory
+ * straight from the OS and
+ * - binds the pages of each node's share of the partitions to that node (mbind), or
+ *   interleaves all pages over all nodes if there is only a single node or binding
+ *   isn't allowed,
+ * - constructs the elements in parallel, one thread per partition, pinned to the cpus
+ *   of the partition's node (first touch happens locally, even without mbind),
+ * - runs for_each_partition() the same way, so each thread scans local memory.
+ * Threads are started per call, like radix_sort's; if one can't be started, the
+ * calling thread does its partition.
+ * @invariant partition p is [partition_begin(p), partition_end(p)), on node_of(p);
+ * partitions are consecutive, in node order
+ */
+template <typename T>
+class numa_vector
+{
+public:
+	/**
+	 * Constructor, creates an empty vector.
+	 * @exception no-throw
+	 * @post size() == 0 && partitions() == 0
+	 */
+	numa_vector() : _bytes(0), _data(nullptr), _size(0), _bound(false) {}
+
+	/**
+	 * Constructor, creates n copies of 'value', split into max(threads, number of
+	 * nodes) partitions (at most n), each constructed by a thread on its node.
+	 * @param threads Number of partitions, 0 = one per hardware thread
+	 * @exception might throw if not enough memory is available or if T's copy
+	 * constructor throws. Provides strong exception safety.
+	 * @post size() == n, all elements == value
+	 */
+	explicit numa_vector(std::size_t n, T const & value = T(), unsigned threads = 0) :
+		_nodes(detail::numa_topology()), _bytes(0), _data(nullptr), _size(0), _bound(false)
+	{
+		if (n == 0)
+			return;
+		if (n > static_cast<std::size_t>(-1) / sizeof(T) - detail::page_size())
+			throw std::bad_alloc();
+
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		std::size_t const parts = std::min<std::size_t>(n, std::max<std::size_t>(threads, _nodes.size()));
+		std::size_t const nodes = std::min(parts, _nodes.size());
+		_begin = array<std::size_t>(parts + 1);
+		_node = array<unsigned>(parts);
+		for (std::size_t p = 0; p <= parts; p++)
+			_begin[p] = n * p / parts;
+		for (std::size_t p = 0; p < parts; p++)
+			_node[p] = static_cast<unsigned>(p * nodes / parts);
+
+		array<std::exception_ptr> errors(parts);
+
+		std::size_t const page = detail::page_size();
+		_bytes = (n * sizeof(T) + page - 1) / page * page;
+		std::unique_ptr<T, detail::unmapper> guard(static_cast<T *>(detail::map_pages(_bytes)), detail::unmapper{ _bytes });
+		_data = guard.get();
+		place(parts, nodes);
+
+		run([this, &value, &errors](std::size_t p) {
+			try
+			{
+				std::uninitialized_fill(_data + _begin[p], _data + _begin[p + 1], value);
+			}
+			catch (...)
+			{
+				errors[p] = std::current_exception(); // uninitialized_fill cleaned up
+			}
+		});
+
+		auto const failed = std::find_if(errors.data(), errors.data() + parts, [](std::exception_ptr const & e) { return e != nullptr; });
+		if (failed != errors.data() + parts)
+		{
+			for (std::size_t p = 0; p < parts; p++)
+				if (!errors[p])
+					std::destroy(_data + _begin[p], _data + _begin[p + 1]);
+			std::rethrow_exception(* failed);
+		}
+		guard.release();
+		_size = n;
+	}
+
+	// Copies would have to be placed again: no implicit copies of a big NUMA-placed vector
+	numa_vector(numa_vector const &) = delete;
+
+	/**
+	 * Move constructor, steals the elements of 'other'.
+	 * @exception no-throw
+	 * @post other.size() == 0
+	 */
+	numa_vector(numa_vector && other) noexcept : numa_vector() { swap(other); }
+
+	/**
+	 * Move assignment operator.
+	 * @exception no-throw
+	 */
+	numa_vector & operator=(numa_vector && rhs) noexcept
+	{
+		numa_vector tmp(std::move(rhs));
+		swap(tmp);
+		return * this;
+	}
+
+	~numa_vector()
+	{
+		if (!_data)
+			return;
+		std::destroy(_data, _data + _size);
+		detail::unmap_pages(_data, _bytes);
+	}
+
+	/**
+	 * Exchanges the contents of this vector with 'other'.
+	 * @exception no-throw
+	 */
+	void swap(numa_vector & other) noexcept
+	{
+		std::swap(_nodes, other._nodes);
+		std::swap(_begin, other._begin);
+		std::swap(_node, other._node);
+		std::swap(_bytes, other._bytes);
+		std::swap(_data, other._data);
+		std::swap(_size, other._size);
+		std::swap(_bound, other._bound);
+	}
+
+	/**
+	 * @return number of elements
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * @return Raw pointer to the data, all partitions are consecutive
+	 * @exception no-throw
+	 */
+	T * data() { return _data; }
+	T const * data() const { return _data; }
+	T * begin() { return _data; }
+	T * end() { return _data + _size; }
+	T const * begin() const { return _data; }
+	T const * end() const { return _data + _size; }
+
+	/**
+	 * @return (Reference to) element at index i
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	T & operator[](std::size_t i)
+	{
+		assert(i < _size);
+		return _data[i];
+	}
+	T const & operator[](std::size_t i) const
+	{
+		assert(i < _size);
+		return _data[i];
+	}
+
+	/**
+	 * @return Number of partitions, 0 if empty
+	 * @exception no-throw
+	 */
+	std::size_t partitions() const { return _size == 0 ? 0 : _node.size(); }
+
+	/**
+	 * @return Range of partition p
+	 * @pre p < partitions()
+	 * @exception no-throw
+	 */
+	T * partition_begin(std::size_t p)
+	{
+		assert(p < partitions());
+		return _data + _begin[p];
+	}
+	T * partition_end(std::size_t p)
+	{
+		assert(p < partitions());
+		return _data + _begin[p + 1];
+	}
+
+	/**
+	 * @return OS id of the node partition p lives on
+	 * @pre p < partitions()
+	 * @exception no-throw
+	 */
+	unsigned node_of(std::size_t p) const
+	{
+		assert(p < partitions());
+		return _nodes[_node[p]].id;
+	}
+
+	/**
+	 * @return The NUMA nodes of this machine, a single one without cpus if unknown
+	 * @exception no-throw
+	 */
+	vector<numa_node> const & nodes() const { return _nodes; }
+
+	/**
+	 * @return true if each node's partitions are bound to that node's memory, false
+	 * if the pages are interleaved (single node, no permission) or placed by first touch
+	 * @exception no-throw
+	 */
+	bool bound() const { return _bound; }
+
+	/**
+	 * Calls f(p, partition_begin(p), partition_end(p)) for all partitions in parallel,
+	 * each on a thread running on the partition's node. f must be safe to call
+	 * concurrently for different partitions.
+	 * @exception rethrows the first exception thrown by f, after all threads finished
+	 */
+	template <typename F>
+	void for_each_partition(F f)
+	{
+		if (_size == 0)
+			return;
+		array<std::exception_ptr> errors(partitions());
+		run([this, &f, &errors](std::size_t p) {
+			try
+			{
+				f(p, _data + _begin[p], _data + _begin[p + 1]);
+			}
+			catch (...)
+			{
+				errors[p] = std::current_exception();
+			}
+		});
+		for (std::size_t p = 0; p < partitions(); p++)
+			if (errors[p])
+				std::rethrow_exception(errors[p]);
+	}
+
+	/**
+	 * Calls f(element) for all elements, in parallel as for_each_partition().
+	 * @exception see for_each_partition()
+	 */
+	template <typename F>
+	void for_each(F f)
+	{
+		for_each_partition([&f](std::size_t, T * first, T * last) { std::for_each(first, last, f); });
+	}
+
+private:
+	// Binds the pages of the partitions of each of the first 'nodes' nodes to that node,
+	// falls back to interleaving over all nodes
+	void place(std::size_t parts, std::size_t nodes)
+	{
+		std::size_t const page = detail::page_size();
+		char * const base = reinterpret_cast<char *>(_data);
+		_bound = nodes > 1;
+		for (std::size_t k = 0, p = 0; k < nodes && _bound; k++)
+		{
+			std::size_t const first = _begin[p] * sizeof(T) / page * page;
+			while (p < parts && _node[p] == k)
+				p++;
+			std::size_t const last = p == parts ? _bytes : _begin[p] * sizeof(T) / page * page;
+#ifdef __linux__
+			_bound = detail::mbind_pages(base + first, last - first, MPOL_BIND, & _nodes[k].id, 1);
+#else
+			(void) first; (void) last; (void) base;
+			_bound = false;
+#endif
+		}
+		if (_bound)
+			return;
+
+#ifdef __linux__
+		array<unsigned> ids(_nodes.size());
+		for (std::size_t k = 0; k < _nodes.size(); k++)
+			ids[k] = _nodes[k].id;
+		detail::mbind_pages(base, _bytes, MPOL_INTERLEAVE, ids.data(), ids.size()); // also resets the bound part
+#endif
+	}
+
+	// Runs f(p) for all partitions p, each on its own thread pinned to the partition's
+	// node. If a thread can't be started, the calling thread runs f(p) itself.
+	// @pre f doesn't throw
+	template <typename F>
+	void run(F const & f)
+	{
+		std::size_t const parts = _node.size();
+		array<std::thread> workers(parts);
+		for (std::size_t p = 0; p < parts; p++)
+		{
+			try
+			{
+				workers[p] = std::thread([this, &f, p]() {
+					detail::pin_current_thread(_nodes[_node[p]].cpus);
+					f(p);
+				});
+			}
+			catch (std::system_error const &)
+			{
+				f(p);
+			}
+		}
+		for (std::size_t p = 0; p < parts; p++)
+			if (workers[p].joinable())
+				workers[p].join();
+	}
+
+	vector<numa_node> _nodes;	// all nodes of the machine
+	array<std::size_t> _begin;	// partition p is [_begin[p], _begin[p + 1])
+	array<unsigned> _node;		// partition p lives on _nodes[_node[p]]
+	std::size_t _bytes;		// mapped, whole pages
+	T * _data;
+	std::size_t _size;
+	bool _bound;
+};
+} // namespace my
@@ -0,0 +1,239 @@
+#include "mypersistent_vector.h"
+#include "myvector.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+
+
+// Bytes currently allocated through new, to compare the memory of the snapshots
+static std::size_t allocated = 0;
+
+void * operator new(std::size_t n)
+{
+	void * p = std::malloc(n + 16); // size in front, keeps the alignment
+	if (!p)
+		throw std::bad_alloc();
+	* static_cast<std::size_t *>(p) = n;
+	allocated += n;
+	return static_cast<char *>(p) + 16;
+}
+
+void operator delete(void * p) noexcept
+{
+	if (!p)
+		return;
+	char * block = static_cast<char *>(p) - 16;
+	allocated -= * reinterpret_cast<std::size_t *>(block);
+	std::free(block);
+}
+
+void operator delete(void * p, std::size_t) noexcept { operator delete(p); }
+
+template <typename T>
+static std::vector<T> to_vector(my::persistent_vector<T> const & v)
+{
+	std::vector<T> r;
+	v.for_each([&r](T const & x) { r.push_back(x); });
+	return r;
+}
+
+int main()
+{
+	using namespace my;
+
+	{// Test persistent_vector()
+		persistent_vector<int> v;
+
+		assert(v.size() == 0);
+		assert(v.empty());
+		assert(to_vector(v).empty());
+	}
+
+	{// Test push_back()/pop_back()/[] across tail, leaf and level boundaries, against std::vector
+		persistent_vector<int> v;
+		std::vector<int> ref;
+		for (int i = 0; i < 40'000; i++) // 3 levels (32 * 32 * 32 = 32768)
+		{
+			v.push_back(i);
+			ref.push_back(i);
+			assert(v.size() == ref.size() && v.back() == i);
+		}
+		for (std::size_t i = 0; i < ref.size(); i += 97)
+			assert(v[i] == ref[i]);
+		assert(to_vector(v) == ref);
+
+		while (!v.empty())
+		{
+			assert(v.back() == ref.back());
+			v.pop_back();
+			ref.pop_back();
+			if (ref.size() % 1000 == 0 || ref.size() < 70)
+				assert(to_vector(v) == ref);
+		}
+		v.push_back(5);
+		assert(v.size() == 1 && v[0] == 5);
+	}
+
+	{// Test snapshots: copies are independent, updates copy paths only
+		persistent_vector<std::string> v;
+		for (int i = 0; i < 2000; i++)
+			v.push_back(std::to_string(i));
+
+		persistent_vector<std::string> const snap = v;
+		v.set(0, "a");
+		v.set(1000, "b");
+		v.set(1999, "c"); // in the tail
+		v.push_back("d");
+		assert(v[0] == "a" && v[1000] == "b" && v[1999] == "c" && v.back() == "d" && v.size() == 2001);
+		assert(snap[0] == "0" && snap[1000] == "1000" && snap[1999] == "1999" && snap.size() == 2000);
+
+		persistent_vector<std::string> w = snap;
+		for (int i = 0; i < 1000; i++)
+			w.pop_back();
+		assert(w.size() == 1000 && w.back() == "999" && snap.size() == 2000 && snap.back() == "1999");
+	}
+
+	{// Test transients: batch updates in place, the source and the result stay independent
+		persistent_vector<int> v;
+		for (int i = 0; i < 1000; i++)
+			v.push_back(i);
+
+		auto t = v.as_transient();
+		for (int i = 0; i < 1000; i++)
+			t.set(i, -i);
+		for (int i = 0; i < 5000; i++)
+			t.push_back(i);
+		t.pop_back();
+		assert(t.size() == 5999 && t[999] == -999 && t.back() == 4998);
+
+		persistent_vector<int> w = t.persistent();
+		assert(w.size() == 5999 && w[500] == -500 && w[1000] == 0);
+		assert(v.size() == 1000 && v[500] == 500 && v[999] == 999);
+
+		persistent_vector<int> const snap = w; // w's nodes are shared now
+		w.set(500, 1);
+		assert(w[500] == 1 && snap[500] == -500);
+
+		std::mt19937 rng(1); // random transient and persistent updates against std::vector
+		std::vector<int> ref = to_vector(w);
+		auto u = w.as_transient();
+		for (int i = 0; i < 20'000; i++)
+		{
+			std::size_t const j = rng() % ref.size();
+			u.set(j, i);
+			ref[j] = i;
+		}
+		w = u.persistent();
+		assert(to_vector(w) == ref && to_vector(snap)[500] == -500);
+	}
+
+	// Benchmark (run in RELEASE mode!!!)
+	int const N = 1'000'000; // might need to adjust slightly for your machine
+	int const SNAPSHOTS = 1000, UPDATES = 16, KEEP = 100;
+	std::chrono::high_resolution_clock c;
+
+	{// Build
+		std::size_t before = allocated;
+		auto t1 = c.now();
+		vector<int> v;
+		for (int i = 0; i < N; i++)
+			v.push_back(i);
+		auto t2 = c.now();
+		std::cout << "tBuild (vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, " << (allocated - before) / 1024 << "KB" << std::endl;
+
+		before = allocated;
+		t1 = c.now();
+		persistent_vector<int> p;
+		for (int i = 0; i < N; i++)
+			p.push_back(i);
+		t2 = c.now();
+		std::cout << "tBuild (persistent_vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, " << (allocated - before) / 1024 << "KB" << std::endl;
+
+		t1 = c.now();
+		auto t = persistent_vector<int>().as_transient();
+		for (int i = 0; i < N; i++)
+			t.push_back(i);
+		persistent_vector<int> q = t.persistent();
+		t2 = c.now();
+		std::cout << "tBuild (persistent_vector, transient): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+
+		long long sum[2] = {};
+		t1 = c.now();
+		for (int x : v)
+			sum[0] += x;
+		t2 = c.now();
+		std::cout << "tTraverse (vector): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us" << std::endl;
+
+		t1 = c.now();
+		q.for_each([&sum](int x) { sum[1] += x; });
+		t2 = c.now();
+		std::cout << "tTraverse (persistent_vector): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "us" << std::endl;
+		std::cout << "(checksum " << (sum[0] - sum[1]) + (to_vector(p) != to_vector(q)) << ", should be 0)" << std::endl;
+	}
+
+	// Snapshot + a few updates, SNAPSHOTS times, the last KEEP snapshots kept for readers
+	std::cout << std::endl;
+	long long sum[2] = {};
+	{// my::vector: every snapshot is a deep copy
+		vector<int> v;
+		for (int i = 0; i < N; i++)
+			v.push_back(i);
+		std::vector<vector<int>> history(KEEP);
+		std::mt19937 rng(2);
+		std::size_t const before = allocated;
+
+		auto t1 = c.now();
+		for (int s = 0; s < SNAPSHOTS; s++)
+		{
+			history[s % KEEP] = v;
+			for (int u = 0; u < UPDATES; u++)
+				v[rng() % N] = s;
+		}
+		auto t2 = c.now();
+		std::cout << "tSnapshotUpdate (vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, " << KEEP << " snapshots: " << (allocated - before) / 1024 << "KB" << std::endl;
+		for (int x : v)
+			sum[0] += x;
+	}
+	{// persistent_vector: snapshots share all but the updated paths
+		persistent_vector<int> v;
+		for (int i = 0; i < N; i++)
+			v.push_back(i);
+		std::vector<persistent_vector<int>> history(KEEP);
+		std::mt19937 rng(2);
+		std::size_t const before = allocated;
+
+		auto t1 = c.now();
+		for (int s = 0; s < SNAPSHOTS; s++)
+		{
+			history[s % KEEP] = v;
+			for (int u = 0; u < UPDATES; u++)
+				v.set(rng() % N, s);
+		}
+		auto t2 = c.now();
+		std::cout << "tSnapshotUpdate (persistent_vector): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, " << KEEP << " snapshots: " << (allocated - before) / 1024 << "KB" << std::endl;
+		v.for_each([&sum](int x) { sum[1] += x; }); // same updates as the vector's
+
+		t1 = c.now();
+		for (int s = 0; s < SNAPSHOTS; s++)
+		{
+			history[s % KEEP] = v;
+			auto t = v.as_transient();
+			for (int u = 0; u < UPDATES; u++)
+				t.set(rng() % N, s);
+			v = t.persistent();
+		}
+		t2 = c.now();
+		std::cout << "tSnapshotUpdate (persistent_vector, transient): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms" << std::endl;
+	}
+	std::cout << "(checksum " << sum[0] - sum[1] << ", should be 0)" << std::endl;
+
+	return 0;
+}
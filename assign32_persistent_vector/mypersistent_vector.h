@@ -0,0 +1,394 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+
+
+namespace my {
+namespace detail {
+// @return A new id for a transient, never 0 and never reused
+inline std::size_t next_edit()
+{
+	static std::atomic<std::size_t> id{0};
+	return ++id;
+}
+} // namespace detail
+
+/**
+ * Persistent (immutable, structurally shared) sequence of T, a simplified version of
+ * Clojure's PersistentVector: a 32-way trie whose leaves hold 32 elements each, plus a
+ * separate tail leaf for the last up to 32 elements.
+ *
+ * Like the rope's, nodes are never modified once shared, and are shared through
+ * reference counting. Copying a persistent_vector is O(1) and a snapshot: later
+ * updates of either copy don't affect the other. An update copies only the path from
+ * the root to the affected leaf (O(log32 n) nodes of 32 pointers/elements, at most 4
+ * for 1M elements); all other nodes stay shared. push_back()/pop_back() only touch
+ * the tail, except every 32nd time.
+ *
+ * A transient (as_transient()) is a temporarily mutable version for batches of updates:
+ * nodes it has already copied belong to it alone, and it updates them in place instead
+ * of copying them again. persistent() turns it back in O(1).
+ * @invariant the tree holds the elements [0, tail_offset()), each of its leaves full,
+ * the tail the rest (1 to 32 elements unless empty); _shift is 5 * the number of levels
+ * above the leaves
+ */
+template <typename T>
+class persistent_vector
+{
+	static constexpr unsigned bits = 5;
+	static constexpr std::size_t width = std::size_t(1) << bits;
+	static constexpr std::size_t mask = width - 1;
+
+	struct node
+	{
+		std::size_t edit = 0;	// id of the transient that owns this node, 0 if shared
+	};
+	struct inner : node
+	{
+		std::shared_ptr<node> child[width];
+	};
+	struct leaf : node
+	{
+		T values[width];
+	};
+	using node_ptr = std::shared_ptr<node>;
+	using leaf_ptr = std::shared_ptr<leaf>;
+
+public:
+	class transient;
+
+	/**
+	 * Constructor, creates an empty vector. Does not allocate.
+	 * @exception no-throw
+	 * @post size() == 0
+	 */
+	persistent_vector() : _size(0), _shift(0), _edit(0) {}
+
+	/**
+	 * Copy constructor/assignment operator, take a snapshot: shares all nodes, O(1).
+	 * @exception no-throw
+	 */
+	persistent_vector(persistent_vector const &) = default;
+	persistent_vector & operator=(persistent_vector const &) = default;
+	persistent_vector(persistent_vector &&) noexcept = default;
+	persistent_vector & operator=(persistent_vector &&) noexcept = default;
+
+	/**
+	 * @return Number of elements
+	 * @exception no-throw
+	 */
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * @return Element at index i, O(log32 n)
+	 * @pre i < size()
+	 * @exception no-throw
+	 */
+	T const & operator[](std::size_t i) const
+	{
+		assert(i < _size);
+		return leaf_for(i)->values[i & mask];
+	}
+
+	/**
+	 * @return The last element
+	 * @pre !empty()
+	 * @exception no-throw
+	 */
+	T const & back() const
+	{
+		assert(!empty());
+		return _tail->values[(_size - 1) & mask];
+	}
+
+	/**
+	 * Replaces the element at index i by 'val', copying the path to its leaf.
+	 * @pre i < size()
+	 * @exception might throw if not enough memory is available or if T's copy
+	 * assignment operator throws. Provides strong exception safety.
+	 */
+	void set(std::size_t i, T const & val)
+	{
+		assert(i < _size);
+		if (i >= tail_offset())
+		{
+			leaf_ptr t = editable(_tail);
+			t->values[i & mask] = val;
+			_tail = std::move(t);
+		}
+		else
+			_root = set(_shift, _root, i, val);
+	}
+
+	/**
+	 * Appends 'val'.
+	 * @exception might throw if not enough memory is available or if T's copy
+	 * assignment operator throws. Provides strong exception safety.
+	 * @post size() grows by 1, back() == val
+	 */
+	void push_back(T const & val)
+	{
+		if (_size - tail_offset() < width && _tail)
+		{
+			leaf_ptr t = editable(_tail);
+			t->values[_size & mask] = val;
+			_tail = std::move(t);
+			_size++;
+			return;
+		}
+
+		// tail full (or none yet): it moves into the tree, val starts a new tail
+		leaf_ptr t = std::make_shared<leaf>();
+		t->edit = _edit;
+		t->values[0] = val;
+		if (_tail)
+		{
+			if (!_root)
+				_root = _tail;
+			else if (_size > (std::size_t(1) << (_shift + bits))) // root is full, grow a level
+			{
+				auto r = std::make_shared<inner>();
+				r->edit = _edit;
+				r->child[0] = _root;
+				r->child[1] = new_path(_shift, _tail);
+				_root = std::move(r);
+				_shift += bits;
+			}
+			else
+				_root = push_tail(_shift, _root);
+		}
+		_tail = std::move(t);
+		_size++;
+	}
+
+	/**
+	 * Removes the last element.
+	 * @pre !empty()
+	 * @exception might throw if not enough memory is available or if T's move
+	 * assignment operator throws. Provides strong exception safety for the former.
+	 * @post size() shrinks by 1
+	 */
+	void pop_back()
+	{
+		assert(!empty());
+		if (_size == 1)
+		{
+			clear();
+			return;
+		}
+		if (_size - tail_offset() > 1)
+		{
+			leaf_ptr t = editable(_tail);
+			t->values[(_size - 1) & mask] = T(); // releases what the element holds
+			_tail = std::move(t);
+			_size--;
+			return;
+		}
+
+		// the last leaf of the tree becomes the tail
+		leaf_ptr t = std::static_pointer_cast<leaf>(leaf_node(_size - 2));
+		node_ptr r = pop_tail(_shift, _root);
+		unsigned shift = _shift;
+		if (shift > 0 && !static_cast<inner *>(r.get())->child[1])
+		{
+			r = static_cast<inner *>(r.get())->child[0];
+			shift -= bits;
+		}
+		_root = std::move(r);
+		_shift = shift;
+		_tail = std::move(t);
+		_size--;
+	}
+
+	/**
+	 * Removes all elements (and lets go of all nodes).
+	 * @exception no-throw
+	 * @post size() == 0
+	 */
+	void clear()
+	{
+		_root.reset();
+		_tail.reset();
+		_size = 0;
+		_shift = 0;
+	}
+
+	/**
+	 * Calls f(element) for all elements in order, leaf by leaf: O(n), faster than
+	 * n operator[] calls.
+	 * @exception might throw if f throws
+	 */
+	template <typename F>
+	void for_each(F f) const
+	{
+		std::size_t const tail = tail_offset();
+		for (std::size_t i = 0; i < tail; i += width)
+			for (T const & x : leaf_for(i)->values)
+				f(x);
+		for (std::size_t i = tail; i < _size; i++)
+			f(_tail->values[i & mask]);
+	}
+
+	/**
+	 * @return A transient with the same elements, sharing all nodes: O(1)
+	 * @exception no-throw
+	 */
+	transient as_transient() const { return transient(* this); }
+
+private:
+	// @return Index of the first element in the tail
+	std::size_t tail_offset() const { return _size < width ? 0 : (_size - 1) >> bits << bits; }
+
+	// @return The leaf of element i, in the tree
+	node_ptr const & leaf_node(std::size_t i) const
+	{
+		node_ptr const * n = & _root;
+		for (unsigned level = _shift; level > 0; level -= bits)
+			n = & static_cast<inner *>(n->get())->child[(i >> level) & mask];
+		return * n;
+	}
+
+	// @return The leaf of element i, in the tree or the tail
+	leaf const * leaf_for(std::size_t i) const
+	{
+		if (i >= tail_offset())
+			return _tail.get();
+		return static_cast<leaf const *>(leaf_node(i).get());
+	}
+
+	// @return n itself if this transient owns it, a copy owned by this transient otherwise
+	template <typename N>
+	std::shared_ptr<N> editable(std::shared_ptr<node> const & n) const
+	{
+		if (_edit != 0 && n->edit == _edit)
+			return std::static_pointer_cast<N>(n);
+		auto copy = std::make_shared<N>(* static_cast<N const *>(n.get()));
+		copy->edit = _edit;
+		return copy;
+	}
+	leaf_ptr editable(leaf_ptr const & n) const { return editable<leaf>(node_ptr(n)); }
+
+	node_ptr set(unsigned level, node_ptr const & n, std::size_t i, T const & val) const
+	{
+		if (level == 0)
+		{
+			leaf_ptr l = editable<leaf>(n);
+			l->values[i & mask] = val;
+			return l;
+		}
+		std::shared_ptr<inner> copy = editable<inner>(n);
+		std::size_t const k = (i >> level) & mask;
+		copy->child[k] = set(level - bits, copy->child[k], i, val);
+		return copy;
+	}
+
+	// @return A chain of new inner nodes down from 'level' to l
+	node_ptr new_path(unsigned level, leaf_ptr const & l) const
+	{
+		if (level == 0)
+			return l;
+		auto n = std::make_shared<inner>();
+		n->edit = _edit;
+		n->child[0] = new_path(level - bits, l);
+		return n;
+	}
+
+	// @return n with _tail appended as its last leaf (the tree has room for it)
+	node_ptr push_tail(unsigned level, node_ptr const & n) const
+	{
+		std::shared_ptr<inner> copy = editable<inner>(n);
+		std::size_t const k = ((_size - 1) >> level) & mask;
+		node_ptr const & child = copy->child[k];
+		if (level == bits)
+			copy->child[k] = _tail;
+		else
+			copy->child[k] = child ? push_tail(level - bits, child) : new_path(level - bits, _tail);
+		return copy;
+	}
+
+	// @return n without its last leaf, nullptr if that was all it had
+	node_ptr pop_tail(unsigned level, node_ptr const & n) const
+	{
+		if (level == 0)
+			return nullptr;
+		std::size_t const k = ((_size - 2) >> level) & mask;
+		node_ptr child = pop_tail(level - bits, static_cast<inner *>(n.get())->child[k]);
+		if (!child && k == 0)
+			return nullptr;
+		std::shared_ptr<inner> copy = editable<inner>(n);
+		copy->child[k] = std::move(child);
+		return copy;
+	}
+
+	node_ptr _root;		// nullptr if everything fits into the tail
+	leaf_ptr _tail;		// nullptr if empty
+	std::size_t _size;
+	unsigned _shift;
+	std::size_t _edit;	// 0, or the id of the transient this belongs to
+};
+
+/**
+ * Mutable version of a persistent_vector for batches of updates: owns the nodes it
+ * copied and updates them in place from then on. Not copyable; persistent() ends
+ * the batch.
+ */
+template <typename T>
+class persistent_vector<T>::transient
+{
+public:
+	transient(transient const &) = delete;
+	transient & operator=(transient const &) = delete;
+	transient(transient &&) noexcept = default;
+	transient & operator=(transient &&) noexcept = default;
+
+	std::size_t size() const { return _v.size(); }
+	bool empty() const { return _v.empty(); }
+	T const & operator[](std::size_t i) const { return _v[i]; }
+	T const & back() const { return _v.back(); }
+
+	/**
+	 * See persistent_vector, but only copies nodes this transient doesn't own yet.
+	 * @pre persistent() wasn't called yet
+	 */
+	void set(std::size_t i, T const & val)
+	{
+		assert(_v._edit != 0);
+		_v.set(i, val);
+	}
+	void push_back(T const & val)
+	{
+		assert(_v._edit != 0);
+		_v.push_back(val);
+	}
+	void pop_back()
+	{
+		assert(_v._edit != 0);
+		_v.pop_back();
+	}
+
+	/**
+	 * Ends the batch: the nodes become shared, further updates copy them again.
+	 * @return The elements as a persistent_vector, O(1)
+	 * @exception no-throw
+	 * @post this transient must not be used anymore
+	 */
+	persistent_vector persistent()
+	{
+		_v._edit = 0; // ids are never reused: the nodes tagged with it are frozen for good
+		return std::move(_v);
+	}
+
+private:
+	friend class persistent_vector;
+
+	explicit transient(persistent_vector const & v) : _v(v) { _v._edit = detail::next_edit(); }
+
+	persistent_vector _v;
+};
+} // namespace my